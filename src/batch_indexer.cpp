@@ -0,0 +1,192 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::BatchIndexer (implementation)
+ *
+ * \date Fri Oct 16 20:58:44 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Project specific includes
+#include "batch_indexer.h"
+#include "index/indexer.h"
+#include "index/indexing_report.h"
+
+// Standard includes
+#include <KDE/KDebug>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSocketNotifier>
+#include <csignal>
+#include <cstdio>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace kate {
+
+int BatchIndexer::s_signal_fd[2] = {-1, -1};
+
+BatchIndexer::BatchIndexer(std::unique_ptr<index::indexer>&& indexer, const bool report)
+  : m_indexer{std::move(indexer)}
+  , m_report{report}
+{
+    connect(
+        m_indexer.get()
+      , SIGNAL(progress(unsigned, unsigned, unsigned))
+      , this
+      , SLOT(reportProgress(unsigned, unsigned, unsigned))
+      );
+    connect(
+        m_indexer.get()
+      , SIGNAL(indexing_uri(QString))
+      , this
+      , SLOT(reportCurrentFile(QString))
+      );
+    connect(
+        m_indexer.get()
+      , SIGNAL(unit_indexed(kate::index::unit_stats, kate::index::indexing_stats))
+      , this
+      , SLOT(reportUnit(kate::index::unit_stats, kate::index::indexing_stats))
+      );
+    connect(
+        m_indexer.get()
+      , SIGNAL(message(clang::diagnostic_message))
+      , this
+      , SLOT(reportMessage(clang::diagnostic_message))
+      );
+    connect(m_indexer.get(), SIGNAL(finished()), this, SLOT(finished()));
+}
+
+BatchIndexer::~BatchIndexer() = default;
+
+/**
+ * The only async-signal-safe way to notify the event loop is to write
+ * to a descriptor watched by a \c QSocketNotifier.
+ */
+bool BatchIndexer::catchTerminationSignals()
+{
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, s_signal_fd))
+        return false;
+    m_signal_notifier.reset(new QSocketNotifier{s_signal_fd[1], QSocketNotifier::Read});
+    connect(m_signal_notifier.get(), SIGNAL(activated(int)), this, SLOT(terminationRequested()));
+
+    struct sigaction action;
+    action.sa_handler = &BatchIndexer::signalHandler;
+    ::sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    return !::sigaction(SIGINT, &action, nullptr) && !::sigaction(SIGTERM, &action, nullptr);
+}
+
+void BatchIndexer::signalHandler(int)
+{
+    const char c = 1;
+    auto result = ::write(s_signal_fd[0], &c, sizeof(c));
+    (void)result;
+}
+
+void BatchIndexer::terminationRequested()
+{
+    char c;
+    auto result = ::read(s_signal_fd[1], &c, sizeof(c));
+    (void)result;
+    kDebug(DEBUG_AREA) << "Termination requested";
+    m_indexer->stop();
+}
+
+void BatchIndexer::start()
+{
+    m_indexer->start();
+}
+
+void BatchIndexer::reportProgress(const unsigned processed, const unsigned total, const unsigned eta)
+{
+    m_processed_files = processed;
+    m_total_files = total;
+    if (m_report)
+        write(index::report::progress(processed, total, eta));
+}
+
+void BatchIndexer::reportCurrentFile(QString filename)
+{
+    if (m_report)
+        write(index::report::file(filename));
+    else if (m_total_files)
+        std::fprintf(
+            stderr
+          , "[%u/%u] %s\n"
+          , m_processed_files
+          , m_total_files
+          , filename.toLocal8Bit().constData()
+          );
+    else
+        std::fprintf(stderr, "%s\n", filename.toLocal8Bit().constData());
+}
+
+void BatchIndexer::reportUnit(index::unit_stats unit, index::indexing_stats stats)
+{
+    if (m_report)
+        write(index::report::unit(unit, stats));
+}
+
+void BatchIndexer::reportMessage(clang::diagnostic_message msg)
+{
+    if (m_report)
+    {
+        write(index::report::message(msg));
+        return;
+    }
+    const char* severity = "";
+    switch (msg.m_type)
+    {
+        case clang::diagnostic_message::type::warning: severity = "warning: "; break;
+        case clang::diagnostic_message::type::error:   severity = "error: ";   break;
+        default: break;
+    }
+    if (msg.m_location.empty())
+        std::fprintf(stderr, "%s%s\n", severity, msg.m_text.toLocal8Bit().constData());
+    else
+        std::fprintf(
+            stderr
+          , "%s:%d:%d: %s%s\n"
+          , msg.m_location.file().toLocalFile().toLocal8Bit().constData()
+          , msg.m_location.line()
+          , msg.m_location.column()
+          , severity
+          , msg.m_text.toLocal8Bit().constData()
+          );
+}
+
+void BatchIndexer::finished()
+{
+    const auto cancelled = m_indexer->is_cancelled();
+    if (m_report)
+        write(index::report::finished(cancelled));
+    QCoreApplication::exit(cancelled ? Cancelled : Success);
+}
+
+void BatchIndexer::write(const QByteArray& line)
+{
+    std::fwrite(line.constData(), 1, std::size_t(line.size()), stdout);
+    // NOTE Parent process should get every event immediately
+    std::fflush(stdout);
+}
+
+}                                                           // namespace kate
@@ -0,0 +1,97 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::BatchIndexer (interface)
+ *
+ * \date Fri Oct 16 20:58:44 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+// Project specific includes
+#include "clang/diagnostic_message.h"
+#include "index/indexing_stats.h"
+
+// Standard includes
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <memory>
+
+class QSocketNotifier;
+
+namespace kate { namespace index {
+class indexer;                                              // fwd decl
+}                                                           // namespace index
+
+/**
+ * \brief Drive \c index::indexer from a command line tool (\c kate-cpp-indexer)
+ *
+ * Indexer events are written to \c stdout as machine readable report lines
+ * (see \c index::report), if requested, or as a human readable text to \c stderr.
+ * \c SIGINT and \c SIGTERM stop indexing gracefully, so an incomplete index
+ * can be resumed later.
+ */
+class BatchIndexer : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Exit codes of the tool
+    enum ExitCode
+    {
+        Success
+      , Failure
+      , Cancelled
+    };
+
+    BatchIndexer(std::unique_ptr<index::indexer>&&, bool);
+    ~BatchIndexer();
+
+    /// Make \c SIGINT and \c SIGTERM request to stop indexing
+    bool catchTerminationSignals();
+
+public Q_SLOTS:
+    void start();
+
+private Q_SLOTS:
+    void reportProgress(unsigned, unsigned, unsigned);
+    void reportCurrentFile(QString);
+    void reportUnit(kate::index::unit_stats, kate::index::indexing_stats);
+    void reportMessage(clang::diagnostic_message);
+    void finished();
+    void terminationRequested();
+
+private:
+    static void signalHandler(int);
+    void write(const QByteArray&);
+
+    static int s_signal_fd[2];                              ///< Socket pair to deliver signals to event loop
+    std::unique_ptr<index::indexer> m_indexer;
+    std::unique_ptr<QSocketNotifier> m_signal_notifier;
+    unsigned m_processed_files = {0};
+    unsigned m_total_files = {0};
+    bool m_report;                                          ///< Write machine readable report lines
+};
+
+}                                                           // namespace kate
+// kate: hl C++/Qt4;
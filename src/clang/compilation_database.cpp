@@ -0,0 +1,105 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::clang::compilation_database (implementation)
+ *
+ * \date Fri Oct 16 19:02:37 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "compilation_database.h"
+#include "to_string.h"
+
+// Standard includes
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <set>
+
+namespace kate { namespace clang { namespace {
+
+/// Check if an option (w/ a separate value) is about output files
+inline bool is_output_option_with_value(const std::string& arg)
+{
+    return arg == "-o" || arg == "-MF" || arg == "-MT" || arg == "-MQ";
+}
+
+/// Check if an option w/o value (or w/ a joined one) is about output files
+inline bool is_output_option(const std::string& arg)
+{
+    return arg == "-c"
+      || arg == "-M" || arg == "-MM" || arg == "-MD" || arg == "-MMD" || arg == "-MP"
+      || (arg.size() > 2 && arg.compare(0, 2, "-o") == 0)
+      || (arg.size() > 3 && (arg.compare(0, 3, "-MF") == 0 || arg.compare(0, 3, "-MT") == 0 || arg.compare(0, 3, "-MQ") == 0))
+      ;
+}
+
+}                                                           // anonymous namespace
+
+CXCompilationDatabase compilation_database::open(const QString& path)
+{
+    const auto fi = QFileInfo{path};
+    const auto dir = fi.isDir() ? fi.absoluteFilePath() : fi.absolutePath();
+    auto error = CXCompilationDatabase_NoError;
+    auto* const db = clang_CompilationDatabase_fromDirectory(dir.toUtf8().constData(), &error);
+    if (error != CXCompilationDatabase_NoError || !db)
+        throw exception{
+            std::string{"Unable to load compilation database from "} + dir.toUtf8().constData()
+          };
+    return db;
+}
+
+std::vector<compile_command> compilation_database::get_all() const
+{
+    auto result = std::vector<compile_command>{};
+    auto seen = std::set<QString>{};
+    DCXCompileCommands commands = {clang_CompilationDatabase_getAllCompileCommands(m_db)};
+    for (auto i = 0u, size = clang_CompileCommands_getSize(commands); i < size; ++i)
+    {
+        const auto command = clang_CompileCommands_getCommand(commands, i);
+        const auto directory = toString(clang_CompileCommand_getDirectory(command));
+        const auto filename = toString(clang_CompileCommand_getFilename(command));
+        const auto fi = QFileInfo{QDir{directory}, filename};
+        auto canonical = fi.canonicalFilePath();
+        // NOTE Skip files not exist anymore and the same file met again
+        // (e.g. built twice w/ different options)
+        if (canonical.isEmpty() || !seen.insert(canonical).second)
+            continue;
+
+        const auto source = std::string{filename.toUtf8().constData()};
+        const auto absolute_source = std::string{fi.absoluteFilePath().toUtf8().constData()};
+        auto cmd = compile_command{std::move(canonical), {}};
+        // NOTE The first argument is a compiler executable
+        for (auto j = 1u, num_args = clang_CompileCommand_getNumArgs(command); j < num_args; ++j)
+        {
+            auto arg = to_string(clang_CompileCommand_getArg(command, j));
+            if (is_output_option_with_value(arg))
+                ++j;
+            else if (!is_output_option(arg) && arg != source && arg != absolute_source)
+                cmd.m_args.emplace_back(std::move(arg));
+        }
+        cmd.m_args.emplace_back("-working-directory=" + std::string{directory.toUtf8().constData()});
+        result.emplace_back(std::move(cmd));
+    }
+    return result;
+}
+
+}}                                                          // namespace clang, kate
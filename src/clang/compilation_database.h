@@ -0,0 +1,90 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::clang::compilation_database (interface)
+ *
+ * \date Fri Oct 16 19:02:37 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "disposable.h"
+
+// Standard includes
+#include <clang-c/Index.h>
+#include <QtCore/QString>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace kate { namespace clang {
+
+/// Compiler invocation for a single source file
+struct compile_command
+{
+    QString m_filename;                                     ///< Canonical path of a source file
+    std::vector<std::string> m_args;                        ///< Compiler options to parse the file
+};
+
+/**
+ * \brief Class \c compilation_database
+ *
+ * Wrapper around \c libclang's compilation database (i.e. \c compile_commands.json
+ * produced by \c CMake w/ \c CMAKE_EXPORT_COMPILE_COMMANDS=ON or alike tools).
+ *
+ * Commands obtained are ready to be passed to \c clang_indexSourceFile():
+ * compiler executable, source file, and options related to output files
+ * (\c -c, \c -o, dependency generation) are stripped, and a build directory
+ * of a command is passed as \c -working-directory, so relative paths in
+ * options (and a source file name) remain valid.
+ */
+class compilation_database
+{
+public:
+    struct exception : public std::runtime_error
+    {
+        explicit exception(const std::string&);
+    };
+
+    /// Load a database from a given directory (or \c compile_commands.json file)
+    explicit compilation_database(const QString&);
+
+    /// Get commands for all source files (the first one if a file is met few times)
+    std::vector<compile_command> get_all() const;
+
+private:
+    static CXCompilationDatabase open(const QString&);
+
+    DCXCompilationDatabase m_db;
+};
+
+inline compilation_database::exception::exception(const std::string& str)
+  : std::runtime_error(str)
+{}
+
+inline compilation_database::compilation_database(const QString& path)
+  : m_db{open(path)}
+{
+}
+
+}}                                                          // namespace clang, kate
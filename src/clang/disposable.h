@@ -98,5 +98,7 @@ typedef disposable<CXTranslationUnit, &clang_disposeTranslationUnit> DCXTranslat
 typedef disposable<CXDiagnostic, &clang_disposeDiagnostic> DCXDiagnostic;
 typedef disposable<CXIndexAction, &clang_IndexAction_dispose> DCXIndexAction;
 typedef disposable<CXCodeCompleteResults*, &clang_disposeCodeCompleteResults> DCXCodeCompleteResults;
+typedef disposable<CXCompilationDatabase, &clang_CompilationDatabase_dispose> DCXCompilationDatabase;
+typedef disposable<CXCompileCommands, &clang_CompileCommands_dispose> DCXCompileCommands;
 
 }}                                                          // namespace clang, kate
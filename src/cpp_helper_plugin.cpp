@@ -276,6 +276,7 @@ void CppHelperPlugin::invalidateTranslationUnits()
           }
       );
     m_units.clear();
+    m_db_mgr.dropParsedUnits();
 }
 
 /// If no view geven (\c nullptr is a devault value), use current view.
@@ -363,6 +364,7 @@ void CppHelperPlugin::removeDocumentInfo(KTextEditor::Document* const doc)
         auto it = m_units.find(doc);
         if (it != end(m_units))
             m_units.erase(it);
+        m_db_mgr.takeParsedUnit(doc->url());
     }
 }
 
@@ -372,6 +374,26 @@ void CppHelperPlugin::openDocument(const KUrl& pch_header)
     application()->activeMainWindow()->openUrl(pch_header);
 }
 
+/**
+ * \note Connected to every document w/ a view, but indices get updated
+ * only w/ files they have (see \c DatabaseManager::updateFile()).
+ *
+ * A TU of the code completer (if any) is given to the indexer, so the file
+ * is not parsed from scratch. It is taken back when needed again (see
+ * \c getTranslationUnitByDocumentImpl()). TU w/ a PCH included has no
+ * declarations from headers of the PCH, so it can't be used for indexing.
+ */
+void CppHelperPlugin::documentSaved(KTextEditor::Document* doc, bool)
+{
+    auto unit = std::unique_ptr<TranslationUnit>{};
+    auto it = m_units.find(doc);
+    if (it != end(m_units) && config().pchFile().isEmpty())
+        unit = std::move(it->second.first);
+    m_db_mgr.updateFile(doc->url(), unit);
+    if (unit)                                               // Not taken by any index
+        it->second.first = std::move(unit);
+}
+
 /**
  * \todo There is a big problem w/ reparse of PCH (i.e. making sure that PCH is fresh):
  * if translation unit would be made from saved AST file, reparse will fail on that file,
@@ -575,6 +597,9 @@ TranslationUnit& CppHelperPlugin::getTranslationUnitByDocumentImpl(
     auto& unit = m_units[doc].*unit_offset;
     // Form/update an internal unsaved files list
     updateUnsavedFiles();
+    // Take back a TU lent to the indexer to reindex a saved file (if any)
+    if (!unit && unit_offset == &translation_units_map_type::mapped_type::first)
+        unit = m_db_mgr.takeParsedUnit(doc->url());
     // Check if translation unit created
     if (!unit)
     {
@@ -121,6 +121,7 @@ public Q_SLOTS:
       );
     void removeDocumentInfo(KTextEditor::Document*);
     void openDocument(const KUrl&);
+    void documentSaved(KTextEditor::Document*, bool);
     void makePCHFile(const KUrl&);
 
 private Q_SLOTS:
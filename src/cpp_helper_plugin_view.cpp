@@ -32,6 +32,7 @@
 #include <kate/mainwindow.h>
 #include <KDE/KActionCollection>
 #include <KDE/KActionMenu>
+#include <KDE/KGlobalSettings>
 #include <KDE/KStringHandler>
 #include <KDE/KTextEditor/CodeCompletionInterface>
 #include <KDE/KTextEditor/MovingInterface>
@@ -75,6 +76,7 @@ CppHelperPluginView::CppHelperPluginView(
   , m_includes_list_model{new QStandardItemModel()}
   , m_search_results_sortable_model{new QSortFilterProxyModel(this)}
   , m_last_explored_document{nullptr}
+  , m_search_results_model{plugin->databaseManager()}
 {
     assert("Sanity check" && m_tool_view);
 
@@ -86,6 +88,7 @@ CppHelperPluginView::CppHelperPluginView(
         actions->addAction("cpphelper_popup_toggle_include_style", this, SLOT(toggleIncludeStyle()));
         actions->addAction("cpphelper_popup_goto_declaration", this, SLOT(gotoDeclarationUnderCursor()));
         actions->addAction("cpphelper_popup_goto_definition", this, SLOT(gotoDefinitionUnderCursor()));
+        actions->addAction("cpphelper_popup_find_references", this, SLOT(findReferencesUnderCursor()));
         actions->addAction("cpphelper_popup_search_text", this, SLOT(searchSymbolUnderCursor()));
         actions->addAction("edit_copy_include", this, SLOT(copyInclude()));
         {
@@ -201,6 +204,18 @@ CppHelperPluginView::CppHelperPluginView(
       , &m_plugin->databaseManager()
       , SLOT(rebuildCurrentIndex())
       );
+    connect(
+        m_tool_view_interior->updateDatabase
+      , SIGNAL(clicked())
+      , &m_plugin->databaseManager()
+      , SLOT(updateCurrentIndex())
+      );
+    connect(
+        m_tool_view_interior->compactDatabase
+      , SIGNAL(clicked())
+      , &m_plugin->databaseManager()
+      , SLOT(compactCurrentIndex())
+      );
     connect(
         m_tool_view_interior->stopIndexer
       , SIGNAL(clicked())
@@ -249,6 +264,13 @@ CppHelperPluginView::CppHelperPluginView(
       , this
       , SLOT(reindexingFinished(const QString&))
       );
+    m_tool_view_interior->slowestUnits->setModel(&m_slowest_units_model);
+    connect(
+        &m_plugin->databaseManager()
+      , SIGNAL(unitIndexed(kate::index::unit_stats, kate::index::indexing_stats))
+      , this
+      , SLOT(unitIndexed(kate::index::unit_stats, kate::index::indexing_stats))
+      );
     connect(
         m_tool_view_interior->indexFunctionBody
       , SIGNAL(toggled(bool))
@@ -273,6 +295,66 @@ CppHelperPluginView::CppHelperPluginView(
       , m_tool_view_interior->indexFunctionBody
       , SLOT(setChecked(bool))
       );
+    connect(
+        m_tool_view_interior->indexOutOfProcess
+      , SIGNAL(toggled(bool))
+      , &m_plugin->databaseManager()
+      , SLOT(outOfProcessToggled(bool))
+      );
+    connect(
+        &m_plugin->databaseManager()
+      , SIGNAL(setOutOfProcessChecked(bool))
+      , m_tool_view_interior->indexOutOfProcess
+      , SLOT(setChecked(bool))
+      );
+    connect(
+        m_tool_view_interior->indexingJobs
+      , SIGNAL(valueChanged(int))
+      , &m_plugin->databaseManager()
+      , SLOT(indexingJobsChanged(int))
+      );
+    connect(
+        &m_plugin->databaseManager()
+      , SIGNAL(setIndexingJobs(int))
+      , m_tool_view_interior->indexingJobs
+      , SLOT(setValue(int))
+      );
+    connect(
+        m_tool_view_interior->indexingProfile
+      , SIGNAL(currentIndexChanged(int))
+      , &m_plugin->databaseManager()
+      , SLOT(indexingProfileChanged(int))
+      );
+    connect(
+        &m_plugin->databaseManager()
+      , SIGNAL(setIndexingProfile(int))
+      , m_tool_view_interior->indexingProfile
+      , SLOT(setCurrentIndex(int))
+      );
+    connect(
+        m_tool_view_interior->compilationDatabase
+      , SIGNAL(textChanged(const QString&))
+      , &m_plugin->databaseManager()
+      , SLOT(compilationDatabaseChanged(const QString&))
+      );
+    connect(
+        &m_plugin->databaseManager()
+      , SIGNAL(setCompilationDatabase(const QString&))
+      , m_tool_view_interior->compilationDatabase
+      , SLOT(setText(const QString&))
+      );
+    connect(
+        m_tool_view_interior->excludedDirectories
+      , SIGNAL(textChanged(const QString&))
+      , &m_plugin->databaseManager()
+      , SLOT(excludedDirectoriesChanged(const QString&))
+      );
+    connect(
+        &m_plugin->databaseManager()
+      , SIGNAL(setExcludedDirectories(const QString&))
+      , m_tool_view_interior->excludedDirectories
+      , SLOT(setText(const QString&))
+      );
 
     // Search tab
     {
@@ -284,6 +366,24 @@ CppHelperPluginView::CppHelperPluginView(
           , this
           , SLOT(searchResultsUpdated())
           );
+        connect(
+            &m_search_results_model
+          , SIGNAL(rowsInserted(const QModelIndex&, int, int))
+          , this
+          , SLOT(searchResultsUpdated())
+          );
+        connect(
+            &m_plugin->databaseManager()
+          , SIGNAL(searchResultsFound(unsigned, kate::index::search_results_batch))
+          , this
+          , SLOT(searchResultsFound(unsigned, kate::index::search_results_batch))
+          );
+        connect(
+            &m_plugin->databaseManager()
+          , SIGNAL(searchCacheUsageChanged(unsigned, unsigned))
+          , this
+          , SLOT(searchCacheUsageChanged(unsigned, unsigned))
+          );
     }
     connect(
         m_tool_view_interior->searchResults
@@ -297,6 +397,13 @@ CppHelperPluginView::CppHelperPluginView(
       , this
       , SLOT(startSearchDisplayResults())
       );
+    m_tool_view_interior->searchQuery->setCompletionMode(KGlobalSettings::CompletionPopup);
+    connect(
+        m_tool_view_interior->searchQuery
+      , SIGNAL(textEdited(const QString&))
+      , this
+      , SLOT(searchQueryEdited(const QString&))
+      );
 }
 
 CppHelperPluginView::~CppHelperPluginView()
@@ -389,6 +496,14 @@ void CppHelperPluginView::viewCreated(KTextEditor::View* const view)
     }
 
     auto* const doc = view->document();
+    // Keep indices up to date w/ saved files
+    connect(
+        doc
+      , SIGNAL(documentSavedOrUploaded(KTextEditor::Document*, bool))
+      , m_plugin
+      , SLOT(documentSaved(KTextEditor::Document*, bool))
+      , Qt::UniqueConnection
+      );
     // Rescan document for #includes on reload
     connect(
         doc
@@ -521,6 +636,9 @@ void CppHelperPluginView::aboutToShow()
         actions->action("cpphelper_popup_goto_definition")->setText(
             i18nc("@action:inmenu", "Go to Definition of <icode>%1</icode>", symbol)
           );
+        actions->action("cpphelper_popup_find_references")->setText(
+            i18nc("@action:inmenu", "Find References to <icode>%1</icode>", symbol)
+          );
         actions->action("cpphelper_popup_search_text")->setText(
             i18nc("@action:inmenu", "Search for <icode>%1</icode>", symbol)
           );
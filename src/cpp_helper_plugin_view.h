@@ -26,6 +26,7 @@
 #include "document_info.h"
 #include "diagnostic_messages_model.h"
 #include "search_results_table_model.h"
+#include "slowest_units_table_model.h"
 #include "ui_plugin_tool_view.h"
 
 // Standard includes
@@ -36,6 +37,7 @@
 #include <memory>
 #include <stack>
 #include <tuple>
+#include <vector>
 
 class QSortFilterProxyModel;
 class QStandardItemModel;
@@ -122,12 +124,17 @@ private Q_SLOTS:
     //@{
     void gotoDeclarationUnderCursor();
     void gotoDefinitionUnderCursor();
+    void findReferencesUnderCursor();
     void searchSymbolUnderCursor();
     void backToPreviousLocation();
     void playgroundAction();
     void reindexingStarted(const QString&);
     void reindexingFinished(const QString&);
+    void unitIndexed(kate::index::unit_stats, kate::index::indexing_stats);
     void startSearchDisplayResults();
+    void searchQueryEdited(const QString&);
+    void searchResultsFound(unsigned, kate::index::search_results_batch);
+    void searchCacheUsageChanged(unsigned, unsigned);
     void searchResultsUpdated();
     void searchResultActivated(const QModelIndex&);
     void locationLinkActivated(const QString&);
@@ -165,6 +172,9 @@ private:
     void appendSearchDetailsRow(const QString&, bool);
     void clearSearchDetails();
     QString symbolUnderCursor();
+    QString usrUnderCursor();
+    std::vector<index::search_result> findEntityUnderCursor();
+    bool showEntityResults(const QString&, std::vector<index::search_result>&&);
     void toggleIncludeStyle(KTextEditor::Document*, int, int);
     QString tryGuessHeaderRelativeConfiguredDirs(QString, QFileInfo);
 
@@ -178,6 +188,7 @@ private:
     DiagnosticMessagesModel m_diagnostic_data;              ///< Storage (model) for diagnostic messages
     completions_models_map_type m_completers;               ///< Registered completers by view
     SearchResultsTableModel m_search_results_model;         ///< Model to hold search results
+    SlowestUnitsTableModel m_slowest_units_model;           ///< The most expensive TUs of the last indexing
     std::stack<clang::location> m_recent_locations;         ///< Stack of last locations
 };
 
@@ -35,10 +35,26 @@
 // Standard includes
 #include <kate/mainwindow.h>
 #include <QtGui/QSortFilterProxyModel>
+#include <algorithm>
 
 namespace kate { namespace {
 const auto CHECK_MARK = QChar{0x14, 0x27};
 const auto BALOUT_X = QChar{0x17, 0x27};
+constexpr auto MIN_COMPLETION_LENGTH = 2;
+
+/// Leave only results matching a given predicate
+template <typename Predicate>
+void filterResults(std::vector<index::search_result>& results, Predicate pred)
+{
+    results.erase(
+        std::remove_if(
+            begin(results)
+          , end(results)
+          , [&pred](const index::search_result& r) { return !pred(r); }
+          )
+      , end(results)
+      );
+}
 }                                                           // anonymous namespace
 
 //BEGIN SLOTS
@@ -59,6 +75,17 @@ void CppHelperPluginView::gotoDeclarationUnderCursor()
       && !query.isEmpty()
       );
 
+    // Try an exact match by USR first
+    {
+        auto results = findEntityUnderCursor();
+        filterResults(
+            results
+          , [](const index::search_result& r) { return r.m_flags.m_decl && !r.m_flags.m_redecl; }
+          );
+        if (showEntityResults(query, std::move(results)))
+            return;
+    }
+
     query = QString{QString{"decl:"} + query + " AND NOT def:y"};
     kDebug() << "Search query: " << query;
     auto results = m_plugin->databaseManager().startSearchGetResults(query);
@@ -92,6 +119,22 @@ void CppHelperPluginView::gotoDefinitionUnderCursor()
       && !symbol.isEmpty()
       );
 
+    // Try an exact match by USR first: a definition, or any declaration if no definition found
+    {
+        auto results = findEntityUnderCursor();
+        filterResults(results, [](const index::search_result& r) { return r.m_flags.m_decl; });
+        // NOTE Search results are not copyable, so move definitions to the front
+        const auto last_definition = std::stable_partition(
+            begin(results)
+          , end(results)
+          , [](const index::search_result& r) { return r.m_flags.m_redecl; }
+          );
+        if (last_definition != begin(results))
+            results.erase(last_definition, end(results));
+        if (showEntityResults(symbol, std::move(results)))
+            return;
+    }
+
     auto query = QString{"decl:" + symbol + " AND def:y"};
     kDebug() << "Search query: " << query;
     auto results = m_plugin->databaseManager().startSearchGetResults(query);
@@ -124,6 +167,42 @@ void CppHelperPluginView::gotoDefinitionUnderCursor()
     }
 }
 
+void CppHelperPluginView::findReferencesUnderCursor()
+{
+    assert(
+        "Active view supposed to be valid at this point! Am I wrong?"
+      && mainWindow()->activeView()
+      );
+
+    KTextEditor::View* view = mainWindow()->activeView();
+    if (!view || !view->cursorPosition().isValid())
+        return;                                             // do nothing if no view or valid cursor
+
+    const auto symbol = symbolUnderCursor();
+    assert(
+        "Symbol under cursor expected to be Ok, otherwise action must be disabled"
+      && !symbol.isEmpty()
+      );
+
+    const auto usr = usrUnderCursor();
+    auto results = m_plugin->databaseManager().findReferences(usr);
+    if (results.empty())
+    {
+        // Indices made by an older version have references as documents
+        results = m_plugin->databaseManager().findEntity(usr);
+        filterResults(results, [](const index::search_result& r) { return !r.m_flags.m_decl; });
+    }
+    if (!results.empty())
+    {
+        setSearchQueryAndShowIt("ref:" + symbol);
+        m_search_results_model.updateSearchResults(std::move(results));
+        return;
+    }
+    // Fall back to search by name (e.g. index w/o USRs)
+    setSearchQueryAndShowIt("ref:" + symbol);
+    startSearchDisplayResults();
+}
+
 void CppHelperPluginView::searchSymbolUnderCursor()
 {
     assert(
@@ -186,8 +265,12 @@ void CppHelperPluginView::reindexingStarted(const QString& msg)
     addDiagnosticMessage(
         clang::diagnostic_message{msg, clang::diagnostic_message::type::info}
       );
-    // Disable rebuild index button
+    m_slowest_units_model.clear();
+    m_tool_view_interior->indexingThroughput->clear();
+    // Disable rebuild index buttons
     m_tool_view_interior->reindexDatabase->setEnabled(false);
+    m_tool_view_interior->updateDatabase->setEnabled(false);
+    m_tool_view_interior->compactDatabase->setEnabled(false);
     m_tool_view_interior->stopIndexer->setEnabled(true);
 }
 
@@ -196,20 +279,61 @@ void CppHelperPluginView::reindexingFinished(const QString& msg)
     addDiagnosticMessage(
         clang::diagnostic_message{msg, clang::diagnostic_message::type::info}
       );
-    // Enable rebuild index button
+    // Enable rebuild index buttons
     m_tool_view_interior->reindexDatabase->setEnabled(true);
+    m_tool_view_interior->updateDatabase->setEnabled(true);
+    m_tool_view_interior->compactDatabase->setEnabled(true);
     m_tool_view_interior->stopIndexer->setEnabled(false);
 }
 
+void CppHelperPluginView::unitIndexed(const index::unit_stats unit, const index::indexing_stats totals)
+{
+    m_slowest_units_model.add(unit);
+    m_tool_view_interior->indexingThroughput->setText(
+        i18nc(
+            "@info/plain"
+          , "%1 file(s), %2 declaration(s), %3 reference(s) indexed: %4 files/s, %5 declarations/s"
+          , totals.m_files
+          , qulonglong(totals.m_declarations)
+          , qulonglong(totals.m_references)
+          , QString::number(totals.files_per_second(), 'f', 1)
+          , QString::number(totals.declarations_per_second(), 'f', 0)
+          )
+      );
+}
+
 void CppHelperPluginView::startSearchDisplayResults()
 {
     auto query = m_tool_view_interior->searchQuery->text();
     kDebug() << "Search query: " << query;
     if (!query.isEmpty())
-    {
-        auto results = m_plugin->databaseManager().startSearchGetResults(query);
-        m_search_results_model.updateSearchResults(std::move(results));
-    }
+        m_search_results_model.startSearch(m_plugin->databaseManager().startSearch(query));
+}
+
+/**
+ * Only a plain symbol name gets completed: queries w/ special terms,
+ * operators or few words are left as is.
+ */
+void CppHelperPluginView::searchQueryEdited(const QString& text)
+{
+    static const auto NOT_A_NAME = QRegExp{"[^A-Za-z0-9_~]"};
+    if (text.size() < MIN_COMPLETION_LENGTH || text.contains(NOT_A_NAME))
+        return;
+    m_tool_view_interior->searchQuery->setCompletedItems(
+        m_plugin->databaseManager().completeSymbolName(text)
+      );
+}
+
+void CppHelperPluginView::searchResultsFound(const unsigned serial, const index::search_results_batch batch)
+{
+    m_search_results_model.appendSearchResults(serial, batch);
+}
+
+void CppHelperPluginView::searchCacheUsageChanged(const unsigned hits, const unsigned misses)
+{
+    m_tool_view_interior->searchCacheUsage->setText(
+        i18nc("@info/plain", "Query cache: %1 hit(s), %2 miss(es)", hits, misses)
+      );
 }
 
 void CppHelperPluginView::searchResultsUpdated()
@@ -322,6 +446,65 @@ void CppHelperPluginView::locationLinkActivated(const QString& link)
 //END SLOTS
 
 //BEGIN Utility (private) functions
+/**
+ * Get USR of an entity under cursor from the current document's TU.
+ *
+ * \return empty string if no entity under cursor
+ */
+QString CppHelperPluginView::usrUnderCursor()
+{
+    KTextEditor::View* view = mainWindow()->activeView();
+    assert("Active view expected to be valid!" && view);
+    auto usr = QString{};
+    try
+    {
+        auto& unit = m_plugin->getTranslationUnitByDocument(view->document());
+        // NOTE Kate has zero-based positioning
+        usr = unit.getReferencedUSR(view->cursorPosition().line() + 1, view->cursorPosition().column() + 1);
+    }
+    catch (const TranslationUnit::Exception& e)
+    {
+        kDebug(DEBUG_AREA) << "Unable to get an entity under cursor:" << e.what();
+    }
+    kDebug(DEBUG_AREA) << "USR under cursor:" << usr;
+    return usr;
+}
+
+/**
+ * Lookup for declarations and references of an entity under cursor
+ * in the enabled indices.
+ *
+ * \return empty list if no entity under cursor, or indices have no documents for it
+ */
+std::vector<index::search_result> CppHelperPluginView::findEntityUnderCursor()
+{
+    const auto usr = usrUnderCursor();
+    return usr.isEmpty() ? std::vector<index::search_result>{} : m_plugin->databaseManager().findEntity(usr);
+}
+
+/**
+ * Jump to the only result, or show all of them in the search results view.
+ *
+ * \return \c false if nothing to show
+ */
+bool CppHelperPluginView::showEntityResults(const QString& symbol, std::vector<index::search_result>&& results)
+{
+    if (results.empty())
+        return false;
+    if (results.size() == 1)
+    {
+        const auto& details = results[0];
+        // NOTE Kate has zero-based positioning
+        openFile(details.m_file, {details.m_line - 1, details.m_column - 1});
+    }
+    else
+    {
+        setSearchQueryAndShowIt("decl:" + symbol);
+        m_search_results_model.updateSearchResults(std::move(results));
+    }
+    return true;
+}
+
 /**
  * \todo Do not allow multiline selection! Really?!
  */
@@ -27,22 +27,25 @@
 
 // Project specific includes
 #include "database_manager.h"
+#include "clang/compilation_database.h"
+#include "index/compaction.h"
 #include "index/document.h"
 #include "index/document_extras.h"
 #include "index/indexer.h"
+#include "index/indexing_report.h"
+#include "index/details/targets_scanner.h"
 #include "index/utils.h"
 #include "string_cast.h"
+#include "translation_unit.h"
 
 // Standard includes
-#include <boost/archive/binary_iarchive.hpp>
 #include <boost/filesystem/operations.hpp>
-#include <boost/serialization/list.hpp>
-#include <boost/serialization/string.hpp>
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <KDE/KDebug>
 #include <KDE/KDirSelectDialog>
 #include <KDE/KGlobal>
+#include <KDE/KLocale>
 #include <KDE/KLocalizedString>
 #include <KDE/KPassivePopup>
 #include <KDE/KSharedConfig>
@@ -51,17 +54,19 @@
 #include <QtCore/QAbstractTableModel>
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
+#include <QtCore/QThread>
 #include <QtGui/QStringListModel>
 
 namespace kate { namespace {
 /// \attention Make sure this path replaced everywhre in case of changes
 /// \todo Make a constant w/ single declaration place for this path
 const QString DATABASES_DIR = "plugins/katecpphelperplugin/indexed-collections/";
+const char* const INDEXER_BINARY = "kate-cpp-indexer";
 const char* const DB_MANIFEST_FILE = "manifest";
 boost::uuids::random_generator UUID_GEN;
-const QString ANONYMOUS = "<anonymous>";
 /// \todo Make it configurable?
 constexpr std::size_t VISUAL_NOTIFICATION_THRESHOLD = 100;
+constexpr std::size_t MAX_NAME_COMPLETIONS = 20;
 
 namespace meta {
 const QString GROUP_NAME = "options";
@@ -70,7 +75,67 @@ const QString PATH = "db-path";
 const QString NAME = "name";
 const QString COMMENT = "comment";
 const QString TARGETS = "targets";
-}}}                                                         // namespace key, meta, anonymous namespace
+}}                                                          // namespace key, meta
+
+/// Copy all files of an index (Xapian DB is a flat directory)
+void copyIndex(
+    const boost::filesystem::path& from
+  , const boost::filesystem::path& to
+  , boost::system::error_code& error
+  )
+{
+    boost::filesystem::create_directories(to, error);
+    if (error)
+        return;
+    for (
+        auto it = boost::filesystem::directory_iterator{from, error}
+      , last = boost::filesystem::directory_iterator{}
+      ; !error && it != last
+      ; it.increment(error)
+      )
+    {
+        if (!boost::filesystem::is_regular_file(it->status()))
+            continue;
+        boost::filesystem::copy_file(it->path(), to / it->path().filename(), error);
+        if (error)
+            return;
+    }
+}
+
+/// Make some SPAM: give user a hint about found/estimated results if "too much" results found...
+void notifySearchResultsCount(const std::size_t shown, const index::doccount estimated)
+{
+    if (estimated <= VISUAL_NOTIFICATION_THRESHOLD)
+        return;
+    if (shown < estimated)
+    {
+        KPassivePopup::message(
+            i18nc("@title:window", "Search results")
+          , i18nc(
+                "@info:tooltip"
+              , "%1 results displayed of %2 estimated"
+              , shown
+              , estimated
+              )
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+    }
+    else
+    {
+        KPassivePopup::message(
+            i18nc("@title:window", "Search results")
+          , i18nc(
+                "@info:tooltip"
+              , "%1 results found"
+              , shown
+              )
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+    }
+}
+}                                                           // anonymous namespace
 
 DatabaseManager::database_state::~database_state()
 {
@@ -104,6 +169,21 @@ DatabaseManager::DatabaseManager()
 
 DatabaseManager::~DatabaseManager()
 {
+    // Let the indexer process checkpoint its DB, so indexing can be resumed later
+    if (m_indexer_process)
+    {
+        m_indexer_process->disconnect(this);
+        m_indexer_process->terminate();
+        m_indexer_process->waitForFinished();
+    }
+    if (m_compaction_thread)
+        m_compaction_thread->wait();
+    if (m_search_thread)
+    {
+        m_searcher->cancel();
+        m_search_thread->quit();
+        m_search_thread->wait();
+    }
     // Write possible modified manifests for all collections
     for (const auto& index : m_collections)
         index.m_options->writeConfig();
@@ -210,6 +290,7 @@ void DatabaseManager::reset(const std::set<boost::uuids::uuid>& enabled_list, co
             {
                 m_search_db.add_index(pos->m_db.get());
                 m_enabled_list.insert(db_id);
+                ++m_indices_generation;
                 Q_EMIT(indexStatusChanged(index::toString(db_id), true));
             }
             else
@@ -280,6 +361,7 @@ void DatabaseManager::enable(const int idx, const bool flag)
         state.m_db.reset();
         state.m_status = database_state::status::unknown;
     }
+    ++m_indices_generation;
     state.m_enabled = flag;
     Q_EMIT(indexStatusChanged(index::toString(state.m_id), flag));
     assert("Sanity check" && m_search_db.used_indices() == m_enabled_list.size());
@@ -355,6 +437,76 @@ void DatabaseManager::indexImplicitsToggled(const bool is_checked)
     state.m_options->writeConfig();
 }
 
+void DatabaseManager::outOfProcessToggled(const bool is_checked)
+{
+    // Check if any index has been selected, and no other reindexing in progress
+    if (m_last_selected_index == -1)
+    {
+        KPassivePopup::message(
+            i18nc("@title:window", "Error")
+          , i18nc("@info", "No index selected...")
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+        return;
+    }
+
+    auto& state = m_collections[m_last_selected_index];
+    state.m_options->setOutOfProcess(is_checked);
+    state.m_options->writeConfig();
+}
+
+void DatabaseManager::indexingJobsChanged(const int jobs)
+{
+    // NOTE Spin box value gets changed on index selection as well,
+    // so no spam if nothing selected...
+    if (m_last_selected_index == -1)
+        return;
+
+    auto& state = m_collections[m_last_selected_index];
+    state.m_options->setIndexingJobs(jobs);
+    state.m_options->writeConfig();
+}
+
+void DatabaseManager::indexingProfileChanged(const int profile)
+{
+    // NOTE Combo box index gets changed on index selection as well
+    if (m_last_selected_index == -1 || profile == -1)
+        return;
+
+    auto& state = m_collections[m_last_selected_index];
+    if (state.m_options->indexingProfile() == profile)
+        return;
+    state.m_options->setIndexingProfile(profile);
+    state.m_options->writeConfig();
+    m_indices_model.refreshRow(m_last_selected_index);
+}
+
+void DatabaseManager::compilationDatabaseChanged(const QString& path)
+{
+    if (m_last_selected_index == -1)
+        return;
+
+    auto& state = m_collections[m_last_selected_index];
+    state.m_options->setCompilationDatabase(path);
+    state.m_options->writeConfig();
+}
+
+void DatabaseManager::excludedDirectoriesChanged(const QString& text)
+{
+    if (m_last_selected_index == -1)
+        return;
+
+    auto patterns = QStringList{};
+    for (const auto& pattern : text.split(',', QString::SkipEmptyParts))
+        if (!pattern.trimmed().isEmpty())
+            patterns << pattern.trimmed();
+
+    auto& state = m_collections[m_last_selected_index];
+    state.m_options->setExcludedDirectories(patterns);
+    state.m_options->writeConfig();
+}
+
 void DatabaseManager::removeCurrentIndex()
 {
     // Check if any index has been selected, and no other reindexing in progress
@@ -373,7 +525,7 @@ void DatabaseManager::removeCurrentIndex()
         /// \note If indexing already in progress \em Reindex
         /// should be disabled already...
         kDebug(DEBUG_AREA) << "Reindexing in progress...Stop it!";
-        assert("Sanity check" && m_indexer);
+        assert("Sanity check" && (m_indexer || m_indexer_process));
         return;
     }
     // Disable if needed...
@@ -413,6 +565,20 @@ void DatabaseManager::removeCurrentIndex()
 }
 
 void DatabaseManager::rebuildCurrentIndex()
+{
+    startIndexer(m_last_selected_index, false);
+}
+
+void DatabaseManager::updateCurrentIndex()
+{
+    startIndexer(m_last_selected_index, true);
+}
+
+/**
+ * Compaction runs in a separate thread. Meanwhile the index is unavailable
+ * for search, just like while reindexing.
+ */
+void DatabaseManager::compactCurrentIndex()
 {
     // Check if any index has been selected, and no other reindexing in progress
     if (m_last_selected_index == -1)
@@ -425,7 +591,105 @@ void DatabaseManager::rebuildCurrentIndex()
           );
         return;
     }
-    if (m_indexer)
+    if (m_indexing_in_progress != -1)
+    {
+        /// \note If indexing already in progress \em Compact
+        /// should be disabled already...
+        kDebug(DEBUG_AREA) << "Reindexing in progress...";
+        return;
+    }
+
+    auto& state = m_collections[m_last_selected_index];
+    Q_EMIT(reindexingStarted(i18nc("@info/plain", "Compacting index: %1", state.m_options->name())));
+    beginIndexing(m_last_selected_index, false);
+
+    auto* const job = new index::compaction_job{state.m_options->path().toUtf8().constData()};
+    m_compaction_thread.reset(new QThread{});
+    connect(
+        job
+      , SIGNAL(finished(kate::index::compaction_stats, QString))
+      , this
+      , SLOT(compactionFinished(kate::index::compaction_stats, QString))
+      );
+    connect(job, SIGNAL(finished(kate::index::compaction_stats, QString)), m_compaction_thread.get(), SLOT(quit()));
+    connect(job, SIGNAL(finished(kate::index::compaction_stats, QString)), job, SLOT(deleteLater()));
+    connect(m_compaction_thread.get(), SIGNAL(started()), job, SLOT(process()));
+    job->moveToThread(m_compaction_thread.get());
+    m_compaction_thread->setObjectName("IndexCompaction");
+    m_compaction_thread->start();
+}
+
+void DatabaseManager::compactionFinished(const index::compaction_stats stats, const QString error)
+{
+    assert("Sanity check" && m_indexing_in_progress != -1 && m_compaction_thread);
+    m_compaction_thread->wait();
+    m_compaction_thread.reset();
+
+    auto& state = m_collections[m_indexing_in_progress];
+    auto compacted_db = m_indexing_in_progress;
+    m_indexing_in_progress = -1;
+    m_indices_model.refreshRow(compacted_db);
+
+    const auto& name = state.m_options->name();
+    reloadIndex(state, boost::filesystem::path{state.m_options->path().toUtf8().constData()});
+    if (!error.isEmpty())
+    {
+        auto msg = i18nc("@info/plain", "Index '%1' compaction failed: %2", name, error);
+        Q_EMIT(reindexingFinished(msg));
+        KPassivePopup::message(
+            i18nc("@title:window", "Error")
+          , msg
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+        startPendingUpdate();
+        return;
+    }
+    Q_EMIT(
+        reindexingFinished(
+            i18nc(
+                "@info/plain"
+              , "Index '%1' compacted in %2: %3 -> %4"
+              , name
+              , KGlobal::locale()->prettyFormatDuration(stats.m_time)
+              , KGlobal::locale()->formatByteSize(double(stats.m_size_before))
+              , KGlobal::locale()->formatByteSize(double(stats.m_size_after))
+              )
+          )
+      );
+    startPendingUpdate();
+}
+
+/**
+ * Indexer always writes to a DB w/ \c ".reindexing" suffix, which replace the
+ * current one when done. To update an index incrementally, the current DB
+ * copied to that path first.
+ *
+ * A new index (unless its profile has no references) is built in two passes:
+ * the first one indexes declarations only (which is much faster) and makes
+ * the index searchable, then the second one rebuilds it completely in a
+ * background (see \c finishIndexing()), while the declarations only index
+ * remains usable.
+ *
+ * \param[in] idx index of a DB to (re)build
+ * \param[in] incremental reparse only changed/new TUs if \c true
+ * \param[in] files if not empty, just these files get reparsed right in
+ * a searchable DB (see \c index::indexer::set_partial())
+ */
+void DatabaseManager::startIndexer(const int idx, bool incremental, const QStringList& files)
+{
+    // Check if any index has been selected, and no other reindexing in progress
+    if (idx == -1)
+    {
+        KPassivePopup::message(
+            i18nc("@title:window", "Error")
+          , i18nc("@info", "No index selected...")
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+        return;
+    }
+    if (m_indexer || m_indexer_process)
     {
         /// \note If indexing already in progress \em Reindex
         /// should be disabled already...
@@ -434,16 +698,56 @@ void DatabaseManager::rebuildCurrentIndex()
         return;
     }
 
-    auto& state = m_collections[m_last_selected_index];
+    auto& state = m_collections[idx];
     const auto& name = state.m_options->name();
-    Q_EMIT(reindexingStarted(i18nc("@info/plain", "Starting to rebuild index: %1", name)));
+    const auto db_path = boost::filesystem::path{state.m_options->path().toUtf8().constData()};
+    auto reindexing_db_path = db_path;
+    reindexing_db_path.replace_extension("reindexing");
+
+    // Check if previous indexing was interrupted and can be continued
+    const auto live = !files.isEmpty();
+    const auto resume = !live && isResumable(reindexing_db_path);
+    // NOTE Nothing to update if index has never been built,
+    // and declarations only index has to be completed anyway
+    const auto complete = !resume && state.m_db && state.m_db->is_declarations_only();
+    incremental = resume || (incremental && !complete && state.m_status == database_state::status::ok);
+    // NOTE Nothing to do in a background if a profile has no references
+    const auto profile = index::indexing_profile(state.m_options->indexingProfile());
+    const auto mode = live
+      ? indexing_mode::live
+      : incremental
+      ? indexing_mode::update
+      : complete
+      ? indexing_mode::references
+      : index::indexing_policy{profile}.m_references
+      ? indexing_mode::declarations
+      : indexing_mode::rebuild
+      ;
+    Q_EMIT(
+        reindexingStarted(
+            live
+          ? i18nc("@info/plain", "Updating index w/ saved files: %1", name)
+          : resume
+          ? i18nc("@info/plain", "Resuming interrupted indexing: %1", name)
+          : incremental
+          ? i18nc("@info/plain", "Starting to update index: %1", name)
+          : complete
+          ? i18nc("@info/plain", "Indexing references in background: %1", name)
+          : mode == indexing_mode::declarations
+          ? i18nc("@info/plain", "Starting to rebuild index (declarations first): %1", name)
+          : i18nc("@info/plain", "Starting to rebuild index: %1", name)
+          )
+      );
 
     // Make sure DB path + ".reindexing" suffix doesn't exits
+    // (unless it going to be continued)
     boost::system::error_code error;
-    auto reindexing_db_path = boost::filesystem::path{
-        state.m_options->path().toUtf8().constData()
-      }.replace_extension("reindexing");
-    boost::filesystem::remove_all(reindexing_db_path, error);
+    if (!resume && !live)
+    {
+        boost::filesystem::remove_all(reindexing_db_path, error);
+        if (!error && incremental)
+            copyIndex(db_path, reindexing_db_path, error);
+    }
     if (error)
     {
         Q_EMIT(
@@ -460,22 +764,8 @@ void DatabaseManager::rebuildCurrentIndex()
         return;
     }
 
-    // Make a new indexer and provide it w/ targets to scan
-    auto db_id = index::make_dbid(state.m_id);
-    kDebug(DEBUG_AREA) << "Make short DB ID:" << index::toString(state.m_id) << " --> " << db_id;
-    m_indexer.reset(
-        new index::indexer{db_id, reindexing_db_path.string()}
-      );
-    auto indexing_options = index::indexer::default_indexing_options();
-    if (state.m_options->indexLocals())
-        indexing_options |= CXIndexOpt_IndexFunctionLocalSymbols;
-    if (state.m_options->skipImplicitTemplateInstantiations())
-        indexing_options |= CXIndexOpt_IndexImplicitTemplateInstantiations;
-    m_indexer->set_indexing_options(indexing_options).set_compiler_options(m_compiler_options.get());
-
-    if (state.m_options->targets().empty())
+    if (!live && state.m_options->targets().empty() && state.m_options->compilationDatabase().isEmpty())
     {
-        m_indexer.reset();
         auto msg = i18nc(
               "@info/plain"
             , "No index targets specified for <icode>%1</icode>"
@@ -491,8 +781,82 @@ void DatabaseManager::rebuildCurrentIndex()
         return;
     }
 
-    for (auto& tgt : state.m_options->targets())
+    m_processed_files = m_total_files = m_eta = 0;
+    // NOTE Saved files are reindexed in place, w/o a copy of the whole DB
+    const auto& target_db_path = live ? db_path : reindexing_db_path;
+    if (state.m_options->outOfProcess())
+    {
+        startIndexerProcess(idx, db_path, target_db_path, mode, files);
+        return;
+    }
+
+    // Make a new indexer and provide it w/ targets to scan
+    auto db_id = index::make_dbid(state.m_id);
+    kDebug(DEBUG_AREA) << "Make short DB ID:" << index::toString(state.m_id) << " --> " << db_id;
+    m_indexer.reset(
+        new index::indexer{db_id, target_db_path.string()}
+      );
+    auto indexing_options = index::indexer::default_indexing_options();
+    if (state.m_options->indexLocals())
+        indexing_options |= CXIndexOpt_IndexFunctionLocalSymbols;
+    if (state.m_options->skipImplicitTemplateInstantiations())
+        indexing_options |= CXIndexOpt_IndexImplicitTemplateInstantiations;
+    m_indexer->set_indexing_options(indexing_options)
+      .set_incremental(mode == indexing_mode::update || mode == indexing_mode::live)
+      .set_partial(mode == indexing_mode::live)
+      .set_declarations_only(mode == indexing_mode::declarations)
+      .set_low_priority(mode == indexing_mode::references || mode == indexing_mode::live)
+      .set_profile(profile)
+      .set_jobs_count(unsigned(state.m_options->indexingJobs()))
+      .set_commit_threshold(
+          std::size_t(state.m_options->commitDocuments())
+        , std::size_t(state.m_options->commitMegabytes()) * 1024 * 1024
+        )
+      .set_excluded_directories(state.m_options->excludedDirectories())
+      .set_compiler_options(m_compiler_options.get());
+    if (state.m_db)
+        m_indexer->set_previous_manifest(state.m_db->files_manifest());
+
+    // Get TUs and their options from a compilation database (if any)
+    const auto& compilation_db = state.m_options->compilationDatabase();
+    if (!compilation_db.isEmpty())
+    {
+        try
+        {
+            m_indexer->set_compile_commands(clang::compilation_database{compilation_db}.get_all());
+        }
+        catch (const clang::compilation_database::exception& e)
+        {
+            m_indexer.reset();
+            auto msg = i18nc(
+                "@info/plain"
+              , "Index '%1' rebuilding failed: %2"
+              , name
+              , e.what()
+              );
+            Q_EMIT(reindexingFinished(msg));
+            KPassivePopup::message(
+                i18nc("@title:window", "Error")
+              , msg
+                /// \todo WTF?! \c nullptr can't be used here!?
+              , reinterpret_cast<QWidget*>(0)
+              );
+            return;
+        }
+    }
+
+    for (auto& tgt : live ? files : state.m_options->targets())
         m_indexer->add_target(tgt);
+    // NOTE Saved files parsed by the code completer already don't need a fresh parse
+    for (const auto& file : files)
+    {
+        auto it = m_parsed_units.find(file);
+        if (it == end(m_parsed_units))
+            continue;
+        m_indexer->add_parsed_unit(file, *it->second);
+        m_lent_units.emplace(it->first, std::move(it->second));
+        m_parsed_units.erase(it);
+    }
 
     // Subscribe self for indexer events
     connect(
@@ -501,21 +865,145 @@ void DatabaseManager::rebuildCurrentIndex()
       , this
       , SLOT(rebuildFinished())
       );
+    connect(
+        m_indexer.get()
+      , SIGNAL(progress(unsigned, unsigned, unsigned))
+      , this
+      , SLOT(reportProgress(unsigned, unsigned, unsigned))
+      );
     connect(
         m_indexer.get()
       , SIGNAL(indexing_uri(QString))
       , this
       , SLOT(reportCurrentFile(QString))
       );
+    connect(
+        m_indexer.get()
+      , SIGNAL(unit_indexed(kate::index::unit_stats, kate::index::indexing_stats))
+      , this
+      , SIGNAL(unitIndexed(kate::index::unit_stats, kate::index::indexing_stats))
+      );
     connect(
         m_indexer.get()
       , SIGNAL(message(clang::diagnostic_message))
       , this
       , SLOT(reportIndexingError(clang::diagnostic_message))
       );
-    m_indices_model.refreshRow(m_indexing_in_progress = m_last_selected_index);
+    m_indexing_mode = mode;
+    beginIndexing(idx, mode == indexing_mode::references || mode == indexing_mode::live);
+
+    // Go!
+    m_indexer->start();
+}
+
+/**
+ * Settings are passed to the \c kate-cpp-indexer via the index manifest,
+ * so a crash of \c libclang wouldn't take the editor down. Its progress
+ * comes back as report lines (see \c index::report) from \c stdout.
+ */
+void DatabaseManager::startIndexerProcess(
+    const int idx
+  , const boost::filesystem::path& db_path
+  , const boost::filesystem::path& reindexing_db_path
+  , const indexing_mode mode
+  , const QStringList& files
+  )
+{
+    auto& state = m_collections[idx];
+    const auto& name = state.m_options->name();
+    const auto binary = KStandardDirs::findExe(INDEXER_BINARY);
+    if (binary.isEmpty())
+    {
+        auto msg = i18nc(
+            "@info/plain"
+          , "Index '%1' rebuilding failed: %2"
+          , name
+          , i18nc("@info/plain", "<command>%1</command> not found", INDEXER_BINARY)
+          );
+        Q_EMIT(reindexingFinished(msg));
+        KPassivePopup::message(
+            i18nc("@title:window", "Error")
+          , msg
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+        return;
+    }
+
+    state.m_options->writeConfig();                         // Make sure the indexer see the latest settings
+    m_indexer_process.reset(new KProcess{});
+    *m_indexer_process << binary
+      << "--manifest" << QString::fromUtf8((db_path / DB_MANIFEST_FILE).string().c_str())
+      << "--output" << QString::fromUtf8(reindexing_db_path.string().c_str())
+      << "--report"
+      ;
+    if (mode == indexing_mode::update)
+        *m_indexer_process << "--incremental";
+    else if (mode == indexing_mode::declarations)
+        *m_indexer_process << "--declarations-only";
+    else if (mode == indexing_mode::references)
+        *m_indexer_process << "--low-priority";
+    else if (mode == indexing_mode::live)
+        *m_indexer_process << "--incremental" << "--partial" << "--low-priority";
+    for (const auto* const opt : m_compiler_options.get())
+        *m_indexer_process << "--compiler-option" << opt;
+    // NOTE Targets given in a command line override targets from the manifest
+    *m_indexer_process << files;
+    m_indexer_process->setOutputChannelMode(KProcess::OnlyStdoutChannel);
+    m_indexer_process_finished = m_indexer_process_cancelled = false;
+
+    // Subscribe self for indexer events
+    connect(
+        m_indexer_process.get()
+      , SIGNAL(readyReadStandardOutput())
+      , this
+      , SLOT(indexerProcessOutput())
+      );
+    connect(
+        m_indexer_process.get()
+      , SIGNAL(finished(int, QProcess::ExitStatus))
+      , this
+      , SLOT(indexerProcessFinished(int, QProcess::ExitStatus))
+      );
+
+    kDebug(DEBUG_AREA) << "Starting" << m_indexer_process->program();
+    m_indexer_process->start();
+    if (!m_indexer_process->waitForStarted())
+    {
+        m_indexer_process.reset();
+        auto msg = i18nc(
+            "@info/plain"
+          , "Index '%1' rebuilding failed: %2"
+          , name
+          , i18nc("@info/plain", "unable to start <command>%1</command>", binary)
+          );
+        Q_EMIT(reindexingFinished(msg));
+        KPassivePopup::message(
+            i18nc("@title:window", "Error")
+          , msg
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+        return;
+    }
+    m_indexing_mode = mode;
+    beginIndexing(idx, mode == indexing_mode::references || mode == indexing_mode::live);
+}
+
+/**
+ * Index being rebuilt in a background (or updated w/ saved files)
+ * remains searchable until a new version replaces it.
+ */
+void DatabaseManager::beginIndexing(const int idx, const bool background)
+{
+    m_indices_model.refreshRow(m_indexing_in_progress = idx);
+    if (!background)
+        detachIndex(m_collections[idx]);
+}
 
-    // Shutdown possible opened DB and change status
+/// Shutdown possible opened DB (going to be reindexed) and change status
+void DatabaseManager::detachIndex(database_state& state)
+{
     if (state.m_enabled)
     {
         m_search_db.remove_index(state.m_db.get());
@@ -524,25 +1012,107 @@ void DatabaseManager::rebuildCurrentIndex()
     assert("Sanity check" && m_search_db.used_indices() == m_enabled_list.size());
     state.m_db.reset();
     state.m_status = database_state::status::reindexing;
-
-    // Go!
-    m_indexer->start();
+    ++m_indices_generation;
 }
 
 void DatabaseManager::stopIndexer()
 {
     if (m_indexing_in_progress != -1)
     {
-        assert("Sanity check" && m_indexer);
-        m_indexer->stop();
+        // NOTE Compaction (if running) can't be stopped
+        if (m_indexer)
+            m_indexer->stop();
+        else if (m_indexer_process)
+            m_indexer_process->terminate();                 // NOTE SIGTERM makes it stop gracefully
     }
 }
 
 void DatabaseManager::rebuildFinished()
 {
-    assert("Sanity check" && m_indexing_in_progress != -1);
-    auto& state = m_collections[m_indexing_in_progress];
+    const auto cancelled = m_indexer->is_cancelled();
     m_indexer.reset();                                      // CLose DBs well
+    // Lent TUs are free to use by the code completer again
+    if (!m_lent_units_expired)
+        for (auto& p : m_lent_units)
+            m_parsed_units.emplace(p.first, std::move(p.second));
+    m_lent_units.clear();
+    m_lent_units_expired = false;
+    finishIndexing(cancelled);
+    startPendingUpdate();
+}
+
+void DatabaseManager::indexerProcessOutput()
+{
+    while (m_indexer_process->canReadLine())
+    {
+        const auto line = m_indexer_process->readLine();
+        const auto record = index::report::parse(line);
+        switch (record.m_type)
+        {
+            case index::report::record::type::progress:
+                reportProgress(record.m_processed, record.m_total, record.m_eta);
+                break;
+            case index::report::record::type::file:
+                reportCurrentFile(record.m_filename);
+                break;
+            case index::report::record::type::unit:
+                Q_EMIT(unitIndexed(record.m_unit, record.m_stats));
+                break;
+            case index::report::record::type::message:
+                reportIndexingError(record.m_message);
+                break;
+            case index::report::record::type::finished:
+                m_indexer_process_finished = true;
+                m_indexer_process_cancelled = record.m_cancelled;
+                break;
+            default:
+                kDebug(DEBUG_AREA) << "Unexpected indexer output:" << line;
+                break;
+        }
+    }
+}
+
+/**
+ * If the indexer has crashed or failed, the index is treated as an interrupted
+ * one: an incomplete DB (if any) remains aside to be resumed next time.
+ */
+void DatabaseManager::indexerProcessFinished(const int code, const QProcess::ExitStatus status)
+{
+    assert("Sanity check" && m_indexer_process);
+    indexerProcessOutput();                                 // Consume the rest of the report
+    // NOTE Do not delete a sender from its own signal handler
+    m_indexer_process.release()->deleteLater();
+
+    if (!m_indexer_process_finished || status != QProcess::NormalExit)
+    {
+        assert("Sanity check" && m_indexing_in_progress != -1);
+        auto msg = i18nc(
+            "@info/plain"
+          , "Index '%1' rebuilding failed: %2"
+          , m_collections[m_indexing_in_progress].m_options->name()
+          , status == QProcess::NormalExit
+            ? i18nc("@info/plain", "<command>%1</command> exited w/ code %2", INDEXER_BINARY, code)
+            : i18nc("@info/plain", "<command>%1</command> has crashed", INDEXER_BINARY)
+          );
+        Q_EMIT(diagnosticMessage({msg, clang::diagnostic_message::type::error}));
+        KPassivePopup::message(
+            i18nc("@title:window", "Error")
+          , msg
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+        finishIndexing(true);
+        startPendingUpdate();
+        return;
+    }
+    finishIndexing(m_indexer_process_cancelled);
+    startPendingUpdate();
+}
+
+void DatabaseManager::finishIndexing(const bool cancelled)
+{
+    assert("Sanity check" && m_indexing_in_progress != -1);
+    auto& state = m_collections[m_indexing_in_progress];
 
     // Enable DB in a table view
     auto reindexed_db = m_indexing_in_progress;
@@ -550,15 +1120,47 @@ void DatabaseManager::rebuildFinished()
     m_indices_model.refreshRow(reindexed_db);
 
     // Going to replace old index w/ a new one...
+    if (state.m_db)
+        detachIndex(state);                                 // NOTE It was rebuilt in a background
     const auto db_path = boost::filesystem::path{state.m_options->path().toUtf8().constData()};
     auto reindexing_db_path = db_path;
     reindexing_db_path.replace_extension("reindexing");
 
+    // Saved files have been reindexed in place, so just reopen the DB
+    if (m_indexing_mode == indexing_mode::live)
+    {
+        if (reloadIndex(state, db_path) && !cancelled)
+            Q_EMIT(
+                reindexingFinished(
+                    i18nc("@info/plain", "Index has been updated w/ saved files: %1", state.m_options->name())
+                  )
+              );
+        return;
+    }
+
+    // Keep an incomplete index aside (to be resumed later), and reload the old one
+    if (cancelled)
+    {
+        const auto& name = state.m_options->name();
+        reloadIndex(state, db_path);
+        Q_EMIT(
+            reindexingFinished(
+                i18nc("@info/plain", "Indexing has been stopped (will be resumed next time): %1", name)
+              )
+          );
+        return;
+    }
+
     boost::system::error_code error;
     // Keep database meta
     state.m_options.reset();                                // Flush meta
     auto meta_fileanme = db_path / DB_MANIFEST_FILE;
-    boost::filesystem::copy(meta_fileanme, reindexing_db_path / DB_MANIFEST_FILE, error);
+    boost::filesystem::copy_file(
+        meta_fileanme
+      , reindexing_db_path / DB_MANIFEST_FILE
+      , boost::filesystem::copy_option::overwrite_if_exists
+      , error
+      );
     if (error)
     {
         /// \todo Make some spam?
@@ -583,9 +1185,31 @@ void DatabaseManager::rebuildFinished()
 
     const auto& name = state.m_options->name();
     // Reload index
+    if (!reloadIndex(state, db_path))
+        return;
+
+    // Complete declarations only index in a background
+    if (state.m_db->is_declarations_only())
+    {
+        Q_EMIT(
+            reindexingFinished(
+                i18nc("@info/plain", "Declarations have been indexed, index is searchable now: %1", name)
+              )
+          );
+        startIndexer(reindexed_db, false);
+        return;
+    }
+
+    // Notify that we've done...
+    Q_EMIT(reindexingFinished(i18nc("@info/plain", "Index rebuilding has finished: %1", name)));
+}
+
+bool DatabaseManager::reloadIndex(database_state& state, const boost::filesystem::path& db_path)
+{
     try
     {
         state.m_db.reset(new index::ro::database{db_path.string()});
+        ++m_indices_generation;
         if (state.m_enabled)
         {
             m_search_db.add_index(state.m_db.get());
@@ -596,13 +1220,135 @@ void DatabaseManager::rebuildFinished()
     }
     catch (...)
     {
-        reportError(i18nc("@info/plain", "Load failure '%1'", name));
+        reportError(i18nc("@info/plain", "Load failure '%1'", state.m_options->name()));
         state.m_status = database_state::status::invalid;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * A saved file gets reindexed in every enabled index where it is an indexed
+ * TU already, or it is a source file under some target of an index. Indexed
+ * TUs including (transitively) a saved file get reindexed as well.
+ * If any indexing is in progress, files wait for it to finish.
+ *
+ * If a file going to be reindexed has been parsed already (e.g. by the code
+ * completer), its TU is taken from a caller and given to the (in process)
+ * indexer, so the file is just reparsed. A caller can take it back w/
+ * \c takeParsedUnit() when the indexer doesn't use it anymore.
+ *
+ * \param[in,out] unit TU of the saved file (if any)
+ */
+void DatabaseManager::updateFile(const KUrl& url, std::unique_ptr<TranslationUnit>& unit)
+{
+    if (!url.isLocalFile())
         return;
+    const auto filename = url.toLocalFile();
+    auto queued = false;
+    for (const auto& state : m_collections)
+    {
+        if (!state.m_enabled || !state.isOk() || !state.m_options->updateOnSave())
+            continue;
+        // TUs including a saved header have to be reindexed as well
+        auto targets = dependentUnits(state, filename);
+        const auto is_unit = isIndexedBy(state, filename);
+        if (is_unit)
+            targets << filename;
+        if (targets.isEmpty())
+            continue;
+        auto& files = m_pending_updates[state.m_id];
+        for (const auto& tgt : targets)
+            if (!files.contains(tgt))
+                files << tgt;
+        queued = queued || is_unit;
     }
+    if (queued && unit && m_lent_units.find(filename) == end(m_lent_units))
+        m_parsed_units[filename] = std::move(unit);
+    startPendingUpdate();
+}
 
-    // Notify that we've done...
-    Q_EMIT(reindexingFinished(i18nc("@info/plain", "Index rebuilding has finished: %1", name)));
+std::unique_ptr<TranslationUnit> DatabaseManager::takeParsedUnit(const KUrl& url)
+{
+    auto result = std::unique_ptr<TranslationUnit>{};
+    auto it = m_parsed_units.find(url.toLocalFile());
+    if (it != end(m_parsed_units))
+    {
+        result = std::move(it->second);
+        m_parsed_units.erase(it);
+    }
+    return result;
+}
+
+void DatabaseManager::dropParsedUnits()
+{
+    m_parsed_units.clear();
+    m_lent_units_expired = !m_lent_units.empty();
+}
+
+/// Start reindexing of saved files of the next index (if any), unless some indexing is in progress
+void DatabaseManager::startPendingUpdate()
+{
+    if (m_pending_updates.empty() || m_indexing_in_progress != -1 || m_indexer || m_indexer_process)
+        return;
+    auto it = begin(m_pending_updates);
+    const auto id = it->first;
+    const auto files = it->second;
+    m_pending_updates.erase(it);
+    for (auto idx = 0; idx < int(m_collections.size()); ++idx)
+    {
+        if (m_collections[idx].m_id == id)
+        {
+            if (m_collections[idx].isOk())
+                startIndexer(idx, true, files);
+            return;
+        }
+    }
+}
+
+/// Get indexed TUs including (transitively) a given file
+QStringList DatabaseManager::dependentUnits(const database_state& state, const QString& filename)
+{
+    assert("Sanity check" && state.m_db);
+    auto result = QStringList{};
+    const auto& files = state.m_db->headers_map();
+    const auto file_id = files[filename];
+    if (file_id == HeaderFilesCache::NOT_FOUND)
+        return result;
+    for (const auto id : state.m_db->includes().dependents({file_id}))
+    {
+        const auto unit = files[id];
+        if (id != file_id && state.m_db->files_manifest().find(unit))
+            result << unit;
+    }
+    return result;
+}
+
+bool DatabaseManager::isIndexedBy(const database_state& state, const QString& filename)
+{
+    assert("Sanity check" && state.m_db);
+    if (state.m_db->files_manifest().find(filename))
+        return true;
+    if (!index::details::targets_scanner::is_source_suffix(QFileInfo{filename}.suffix()))
+        return false;
+    for (const auto& target : state.m_options->targets())
+    {
+        const auto path = QDir::cleanPath(target);
+        if (filename == path || filename.startsWith(path + '/'))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Interrupted indexing leaves a DB w/ \c ".reindexing" suffix, which is consistent
+ * up to the last checkpoint and marked as incomplete.
+ */
+bool DatabaseManager::isResumable(const boost::filesystem::path& reindexing_db_path)
+{
+    return boost::filesystem::exists(reindexing_db_path)
+      && index::ro::database::is_incomplete(reindexing_db_path.string())
+      ;
 }
 
 void DatabaseManager::refreshCurrentTargets(const QModelIndex& index)
@@ -620,6 +1366,11 @@ void DatabaseManager::refreshCurrentTargets(const QModelIndex& index)
     const auto& options = *m_collections[m_last_selected_index].m_options;
     Q_EMIT(setIndexLocalsChecked(options.indexLocals()));
     Q_EMIT(setSkipImplicitsChecked(options.skipImplicitTemplateInstantiations()));
+    Q_EMIT(setOutOfProcessChecked(options.outOfProcess()));
+    Q_EMIT(setIndexingJobs(options.indexingJobs()));
+    Q_EMIT(setIndexingProfile(options.indexingProfile()));
+    Q_EMIT(setCompilationDatabase(options.compilationDatabase()));
+    Q_EMIT(setExcludedDirectories(options.excludedDirectories().join(", ")));
 }
 
 void DatabaseManager::selectCurrentTarget(const QModelIndex& index)
@@ -727,6 +1478,16 @@ auto DatabaseManager::tryLoadDatabaseMeta(const boost::filesystem::path& manifes
     result.loadMetaFrom(filename);
 
     auto db_info = QFileInfo{result.m_options->path()};
+    // NOTE An index built elsewhere (by kate-cpp-indexer) and copied here
+    // has a foreign path in its manifest, so use the manifest's directory instead
+    const auto manifest_dir = QFileInfo{filename}.absolutePath();
+    if ((!db_info.exists() || !db_info.isDir()) && db_info.absoluteFilePath() != manifest_dir)
+    {
+        kDebug(DEBUG_AREA) << "Relocate DB" << result.m_options->path() << "-->" << manifest_dir;
+        result.m_options->setPath(manifest_dir);
+        result.m_options->writeConfig();
+        db_info = QFileInfo{manifest_dir};
+    }
     if (!db_info.exists() || !db_info.isDir())
     {
         throw exception::invalid_manifest(
@@ -754,12 +1515,28 @@ KUrl DatabaseManager::getDefaultBaseDir()
 void DatabaseManager::reportCurrentFile(QString msg)
 {
     auto report = clang::diagnostic_message{
-        i18nc("@info/plain", "  indexing %1 ...", msg)
+        m_total_files
+      ? i18nc(
+            "@info/plain"
+          , "  [%2/%3, %4 left] indexing %1 ..."
+          , msg
+          , m_processed_files
+          , m_total_files
+          , KGlobal::locale()->prettyFormatDuration(m_eta * 1000)
+          )
+      : i18nc("@info/plain", "  indexing %1 ...", msg)
       , clang::diagnostic_message::type::info
       };
     Q_EMIT(diagnosticMessage(report));
 }
 
+void DatabaseManager::reportProgress(const unsigned processed, const unsigned total, const unsigned eta)
+{
+    m_processed_files = processed;
+    m_total_files = total;
+    m_eta = eta;
+}
+
 void DatabaseManager::reportIndexingError(clang::diagnostic_message msg)
 {
     Q_EMIT(diagnosticMessage(msg));
@@ -767,188 +1544,195 @@ void DatabaseManager::reportIndexingError(clang::diagnostic_message msg)
 
 index::search_result DatabaseManager::makeSearchResult(const index::document& doc)
 {
-    // Get ID of an index produces this result
-    auto tmp_str = doc.get_value(index::value_slot::DBID);
-    if (tmp_str.empty())
-        /// \todo Damn this looks really ugly!
-        throw std::runtime_error(
-            i18nc("@info:tooltip", "No DBID attached to a document").toUtf8().constData()
-          );
-
-    auto index_id = index::deserialize<index::dbid>(tmp_str);
-    const auto& state = findIndexByID(index_id);
-    const auto& used_index = *state.m_db;
-
-    // Get kind
-    tmp_str = doc.get_value(index::value_slot::KIND);
-    assert("Sanity check" && !tmp_str.empty());
-
-    // Form a search result item
-    auto result = index::search_result{index::deserialize(tmp_str)};
-    result.m_db_name = state.m_options->name();
-
-    // Get source file ID
-    tmp_str = doc.get_value(index::value_slot::FILE);
-    if (tmp_str.empty())
-        throw std::runtime_error(
-            i18nc("@info:tooltip", "No source file ID attached to a document").toUtf8().constData()
-          );
-
-    auto file_id = static_cast<HeaderFilesCache::id_type>(Xapian::sortable_unserialise(tmp_str));
-    // Resolve header ID into string
-    result.m_file = used_index.headers_map()[file_id];
+    const auto& state = findIndexByID(index::get_dbid(doc));
+    return index::make_search_result(doc, state.m_options->name(), state.m_db->headers_map());
+}
 
-    // Get line/column
-    result.m_line = static_cast<int>(
-        Xapian::sortable_unserialise(doc.get_value(index::value_slot::LINE))
-      );
-    result.m_column = static_cast<int>(
-        Xapian::sortable_unserialise(doc.get_value(index::value_slot::COLUMN))
-      );
+/**
+ * Forward search request to \c combined_index.
+ * Latter will fill the model w/ results, so they will be displayed...
+ */
+std::vector<index::search_result> DatabaseManager::startSearchGetResults(QString query)
+{
+    assert("Sanity check" && m_search_db.used_indices() == m_enabled_list.size());
+    auto results = std::vector<index::search_result>{};
 
-    // Get entity name
+    if (m_enabled_list.empty())
     {
-        const auto& name = doc.get_value(index::value_slot::NAME);
-        result.m_name = name.empty() ? ANONYMOUS : string_cast<QString>(name);
+        KPassivePopup::message(
+            i18nc("@title:window", "Error")
+          , i18nc("@info:tooltip", "No indexed collections selected")
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+        return results;
     }
 
-    // Get entity type
+    try
     {
-        const auto& type = doc.get_value(index::value_slot::TYPE);
-        result.m_type = type.empty() ? QString{} : string_cast<QString>(type);
+        auto search_results = m_search_db.search(query);
+        auto& documents = search_results.first;
+        notifySearchResultsCount(documents.size(), search_results.second);
+        //
+        results.reserve(documents.size());
+        // Transform Xapian::Documents into a model
+        for (const auto& doc : documents)
+            results.emplace_back(makeSearchResult(doc));
     }
-
-    // Get parent scope
+    catch (...)
     {
-        const auto& scope = doc.get_value(index::value_slot::SCOPE);
-        if (!scope.empty())
-            result.m_scope = string_cast<QString>(scope);
+        reportError("Search failure", -1, true);
     }
+    reportSearchCacheUsage();
+    return results;
+}
 
-    // Get some other props
-    {
-        const auto& str = doc.get_value(index::value_slot::TEMPLATE);
-        if (!str.empty())
-        {
-            const auto value = index::deserialize<unsigned>(str);
-            result.m_template_kind = CXIdxEntityCXXTemplateKind(value);
-        }
-    }
-    {
-        const auto& str = doc.get_value(index::value_slot::FLAGS);
-        if (!str.empty())
-            result.m_flags.m_flags_as_int =
-                index::deserialize<decltype(result.m_flags.m_flags_as_int)>(str);
-    }
-    {
-        const auto& str = doc.get_value(index::value_slot::VALUE);
-        if (!str.empty())
-            result.m_value = static_cast<long long>(Xapian::sortable_unserialise(str));
-    }
+/**
+ * Unlike \c startSearchGetResults() it doesn't block: results are reported
+ * by \c searchResultsFound() signal in batches, marked w/ a serial number
+ * returned. Any previous request gets cancelled. Results are references
+ * to documents, use \c getSearchResult() to get a displayable one.
+ *
+ * \return a serial number of the request, or \c 0 if nothing to search in
+ */
+unsigned DatabaseManager::startSearch(const QString& query)
+{
+    assert("Sanity check" && m_search_db.used_indices() == m_enabled_list.size());
+    if (m_enabled_list.empty())
     {
-        const auto& str = doc.get_value(index::value_slot::SIZEOF);
-        if (!str.empty())
-            result.m_sizeof = static_cast<std::size_t>(Xapian::sortable_unserialise(str));
+        KPassivePopup::message(
+            i18nc("@title:window", "Error")
+          , i18nc("@info:tooltip", "No indexed collections selected")
+            /// \todo WTF?! \c nullptr can't be used here!?
+          , reinterpret_cast<QWidget*>(0)
+          );
+        return m_search_serial = 0;
     }
+
+    if (!m_search_thread)
     {
-        const auto& str = doc.get_value(index::value_slot::ALIGNOF);
-        if (!str.empty())
-            result.m_alignof = static_cast<std::size_t>(Xapian::sortable_unserialise(str));
+        m_searcher.reset(new index::searcher{});
+        m_search_thread.reset(new QThread{});
+        connect(
+            m_searcher.get()
+          , SIGNAL(found(unsigned, kate::index::search_results_batch))
+          , this
+          , SIGNAL(searchResultsFound(unsigned, kate::index::search_results_batch))
+          );
+        connect(
+            m_searcher.get()
+          , SIGNAL(finished(unsigned, unsigned, unsigned, QString))
+          , this
+          , SLOT(searchFinished(unsigned, unsigned, unsigned, QString))
+          );
+        m_searcher->moveToThread(m_search_thread.get());
+        m_search_thread->setObjectName("IndexSearch");
+        m_search_thread->start();
     }
+
+    // NOTE The searcher opens indices by itself, cuz Xapian DBs can't be shared between threads
+    auto indices = index::searcher::indices_list{};
+    for (const auto& state : m_collections)
+        if (state.isOk() && m_enabled_list.find(state.m_id) != end(m_enabled_list))
+            indices.emplace_back(state.m_options->path().toUtf8().constData());
+    return m_search_serial = m_searcher->start(query, indices, m_indices_generation);
+}
+
+void DatabaseManager::searchFinished(
+    const unsigned serial
+  , const unsigned shown
+  , const unsigned estimated
+  , const QString error
+  )
+{
+    reportSearchCacheUsage();
+    if (serial != m_search_serial)
+        return;                                             // Obsolete request: nobody cares
+    if (error.isEmpty())
     {
-        const auto& str = doc.get_value(index::value_slot::ARITY);
-        if (!str.empty())
-            result.m_arity = static_cast<int>(Xapian::sortable_unserialise(str));
+        notifySearchResultsCount(shown, estimated);
+        return;
     }
+    const auto msg = i18nc("@info/plain", "Search failure: %1", error);
+    Q_EMIT(diagnosticMessage(clang::diagnostic_message{msg, clang::diagnostic_message::type::error}));
+    kDebug(DEBUG_AREA) << msg;
+    KPassivePopup::message(
+        i18nc("@title:window", "Error")
+      , msg
+        /// \todo WTF?! \c nullptr can't be used here!?
+      , reinterpret_cast<QWidget*>(0)
+      );
+}
+
+/**
+ * \note Nothing found is not an error here: caller may fall back to search by name,
+ * e.g. if indices are made by an older version w/o USRs.
+ */
+std::vector<index::search_result> DatabaseManager::findEntity(const QString& usr)
+{
+    assert("Sanity check" && m_search_db.used_indices() == m_enabled_list.size());
+    auto results = std::vector<index::search_result>{};
+    if (m_enabled_list.empty() || usr.isEmpty())
+        return results;
+
+    try
     {
-        const auto& str = doc.get_value(index::value_slot::ACCESS);
-        if (!str.empty())
-        {
-            const auto value = index::deserialize<unsigned>(str);
-            result.m_access = CX_CXXAccessSpecifier(value);
-        }
+        const auto documents = m_search_db.find_entity(usr.toUtf8().constData());
+        results.reserve(documents.size());
+        for (const auto& doc : documents)
+            results.emplace_back(makeSearchResult(doc));
     }
+    catch (...)
     {
-        const auto& str = doc.get_value(index::value_slot::BASES);
-        if (!str.empty())
-        {
-            std::stringstream ss{str, std::ios_base::in | std::ios_base::binary};
-            boost::archive::binary_iarchive ia{ss};
-            std::list<std::string> l;
-            ia >> l;
-            if (!l.empty())                         // Is there anything to transform?
-            {
-                auto bases = QStringList{};
-                for (const auto& base : l)
-                    bases << string_cast<QString>(base);
-                result.m_bases = bases;
-            }
-        }
+        reportError("Search failure", -1, true);
     }
-    return result;
+    return results;
 }
 
 /**
- * Forward search request to \c combined_index.
- * Latter will fill the model w/ results, so they will be displayed...
+ * References are taken from cross references tables of enabled indices.
+ * Kind and name of results are the same as of any declaration of the entity,
+ * and a parent scope is a qualified name of a reference container (if any).
  */
-std::vector<index::search_result> DatabaseManager::startSearchGetResults(QString query)
+std::vector<index::search_result> DatabaseManager::findReferences(const QString& usr)
 {
     assert("Sanity check" && m_search_db.used_indices() == m_enabled_list.size());
     auto results = std::vector<index::search_result>{};
-
-    if (m_enabled_list.empty())
-    {
-        KPassivePopup::message(
-            i18nc("@title:window", "Error")
-          , i18nc("@info:tooltip", "No indexed collections selected")
-            /// \todo WTF?! \c nullptr can't be used here!?
-          , reinterpret_cast<QWidget*>(0)
-          );
+    if (m_enabled_list.empty() || usr.isEmpty())
         return results;
-    }
 
     try
     {
-        auto search_results = m_search_db.search(query);
-        auto& documents = search_results.first;
-        // Make some SPAM: give user a hint about found/estimated results
-        // if "too much" results found...
-        if (VISUAL_NOTIFICATION_THRESHOLD < search_results.second)
+        const auto raw_usr = std::string{usr.toUtf8().constData()};
+        const auto refs = m_search_db.find_references(raw_usr);
+        if (refs.empty())
+            return results;
+
+        const auto declarations = m_search_db.find_entity(raw_usr);
+        const auto entity = declarations.empty()
+          ? index::search_result{index::kind::UNEXPOSED}
+          : makeSearchResult(declarations.front())
+          ;
+        results.reserve(refs.size());
+        for (const auto& p : refs)
         {
-            if (documents.size() < search_results.second)
-            {
-                KPassivePopup::message(
-                    i18nc("@title:window", "Search results")
-                  , i18nc(
-                        "@info:tooltip"
-                      , "%1 results displayed of %2 estimated"
-                      , documents.size()
-                      , search_results.second
-                      )
-                    /// \todo WTF?! \c nullptr can't be used here!?
-                  , reinterpret_cast<QWidget*>(0)
-                  );
-            }
-            else
+            const auto& state = findIndexByID(p.first);
+            const auto& ref = p.second;
+            auto result = index::search_result{entity.m_kind};
+            result.m_name = entity.m_name;
+            result.m_db_name = state.m_options->name();
+            result.m_file = state.m_db->headers_map()[ref.m_file];
+            result.m_line = int(ref.m_line);
+            result.m_column = int(ref.m_column);
+            if (ref.m_container != index::IVALID_DOCUMENT_ID)
             {
-                KPassivePopup::message(
-                    i18nc("@title:window", "Search results")
-                  , i18nc(
-                        "@info:tooltip"
-                      , "%1 results found"
-                      , documents.size()
-                      )
-                    /// \todo WTF?! \c nullptr can't be used here!?
-                  , reinterpret_cast<QWidget*>(0)
-                  );
+                const auto container = index::document{state.m_db->get_document(ref.m_container)};
+                const auto& name = container.get_value(index::value_slot::NAME);
+                const auto& scope = container.get_value(index::value_slot::SCOPE);
+                result.m_scope = string_cast<QString>(scope.empty() ? name : scope + "::" + name);
             }
+            results.emplace_back(std::move(result));
         }
-        //
-        results.reserve(documents.size());
-        // Transform Xapian::Documents into a model
-        for (const auto& doc : documents)
-            results.emplace_back(makeSearchResult(doc));
     }
     catch (...)
     {
@@ -957,7 +1741,79 @@ std::vector<index::search_result> DatabaseManager::startSearchGetResults(QString
     return results;
 }
 
+/**
+ * Names are looked up in the in-memory names index of every enabled DB,
+ * built on first use (see \c index::ro::database::declaration_names()).
+ *
+ * \note It is called while user types, so no popups on failures.
+ */
+QStringList DatabaseManager::completeSymbolName(const QString& name)
+{
+    auto result = QStringList{};
+    if (m_enabled_list.empty() || name.isEmpty())
+        return result;
+    try
+    {
+        const auto names = m_search_db.complete_name(name.toUtf8().constData(), MAX_NAME_COMPLETIONS);
+        for (const auto& n : names)
+            result << string_cast<QString>(n);
+    }
+    catch (...)
+    {
+        reportError("Symbol name completion failure");
+    }
+    return result;
+}
+
+/**
+ * A referred index could be disabled (or document removed by reindexing)
+ * since the search was made, so a placeholder w/ \c UNEXPOSED kind
+ * returned in that case.
+ */
+index::search_result DatabaseManager::getSearchResult(const index::docref& ref)
+{
+    if (const auto* const state = lookupIndexByID(ref.database_id()))
+    {
+        try
+        {
+            const auto doc = index::document{state->m_db->get_document(ref.document_id())};
+            return index::make_search_result(doc, state->m_options->name(), state->m_db->headers_map());
+        }
+        catch (const Xapian::Error& e)
+        {
+            kDebug(DEBUG_AREA) << "Can't get a search result:" << e.get_msg().c_str();
+        }
+        catch (const std::exception& e)
+        {
+            kDebug(DEBUG_AREA) << "Can't get a search result:" << e.what();
+        }
+    }
+    auto result = index::search_result{index::kind::UNEXPOSED};
+    result.m_name = i18nc("@item:intable", "<not available anymore>");
+    return result;
+}
+
+/// Sum up query cache counters of foreground and background searches
+void DatabaseManager::reportSearchCacheUsage()
+{
+    auto stats = m_search_db.cache_stats();
+    if (m_searcher)
+    {
+        const auto background = m_searcher->cache_stats();
+        stats.m_hits += background.m_hits;
+        stats.m_misses += background.m_misses;
+    }
+    Q_EMIT(searchCacheUsageChanged(unsigned(stats.m_hits), unsigned(stats.m_misses)));
+}
+
 auto DatabaseManager::findIndexByID(const index::dbid id) const -> const database_state&
+{
+    const auto* const state = lookupIndexByID(id);
+    assert("Sanity check" && state);
+    return *state;
+}
+
+auto DatabaseManager::lookupIndexByID(const index::dbid id) const -> const database_state*
 {
     auto it = std::find_if(
         begin(m_collections)
@@ -972,8 +1828,7 @@ auto DatabaseManager::findIndexByID(const index::dbid id) const -> const databas
             return false;
         }
       );
-    assert("Sanity check" && it != end(m_collections));
-    return *it;
+    return it == end(m_collections) ? nullptr : &*it;
 }
 
 void DatabaseManager::reportError(const QString& prefix, const int index, const bool show_popup)
@@ -32,7 +32,10 @@
 #include "diagnostic_messages_model.h"
 #include "clang/compiler_options.h"
 #include "index/combined_index.h"
+#include "index/compaction.h"
+#include "index/indexing_stats.h"
 #include "index/search_result.h"
+#include "index/searcher.h"
 #include "indexing_targets_list_model.h"
 #include "indices_table_model.h"
 #include "database_options.h"                               // NOTE generated file from build dir
@@ -40,10 +43,12 @@
 // Standard includes
 #include <boost/filesystem/path.hpp>
 #include <boost/uuid/uuid.hpp>
+#include <KDE/KProcess>
 #include <KDE/KTextEditor/Cursor>
 #include <KDE/KUrl>
 #include <QtCore/QObject>
 #include <QtCore/QStringList>
+#include <map>
 #include <memory>
 #include <set>
 #include <stdexcept>
@@ -53,10 +58,12 @@
 class QAbstractTableModel;
 class QAbstractListModel;
 class QModelIndex;
+class QThread;
 
 namespace kate { namespace index {
 class indexer;                                              // fwd decl
 }                                                           // namespace index
+class TranslationUnit;                                      // fwd decl
 
 /**
  * \brief Manage databases used by current session
@@ -102,6 +109,22 @@ public:
     void setCompilerOptions(clang::compiler_options&&);
     /// Do search request, get results
     std::vector<index::search_result> startSearchGetResults(QString);
+    /// Start search request in background, get its serial number
+    unsigned startSearch(const QString&);
+    /// Read a document found by a background search
+    index::search_result getSearchResult(const index::docref&);
+    /// Get declarations and references of an entity w/ a given USR
+    std::vector<index::search_result> findEntity(const QString&);
+    /// Get references to an entity w/ a given USR
+    std::vector<index::search_result> findReferences(const QString&);
+    /// Get names of declarations to complete a given (partial) symbol name
+    QStringList completeSymbolName(const QString&);
+    /// Reindex a just saved file in indices it belongs to
+    void updateFile(const KUrl&, std::unique_ptr<TranslationUnit>&);
+    /// Give a TU taken by \c updateFile() back (unless it is in use right now)
+    std::unique_ptr<TranslationUnit> takeParsedUnit(const KUrl&);
+    /// Forget all TUs taken by \c updateFile() (e.g. cuz compiler options have changed)
+    void dropParsedUnits();
 
 public Q_SLOTS:
     void enable(const QString&, bool);
@@ -109,6 +132,8 @@ public Q_SLOTS:
     void removeCurrentIndex();
     void stopIndexer();
     void rebuildCurrentIndex();
+    void updateCurrentIndex();
+    void compactCurrentIndex();
     void rebuildFinished();
     void refreshCurrentTargets(const QModelIndex&);
     void selectCurrentTarget(const QModelIndex&);
@@ -118,6 +143,18 @@ public Q_SLOTS:
     void reportIndexingError(clang::diagnostic_message);
     void indexLocalsToggled(bool);
     void indexImplicitsToggled(bool);
+    void outOfProcessToggled(bool);
+    void indexingJobsChanged(int);
+    void indexingProfileChanged(int);
+    void compilationDatabaseChanged(const QString&);
+    void excludedDirectoriesChanged(const QString&);
+    void reportProgress(unsigned, unsigned, unsigned);
+
+private Q_SLOTS:
+    void indexerProcessOutput();
+    void indexerProcessFinished(int, QProcess::ExitStatus);
+    void compactionFinished(kate::index::compaction_stats, QString);
+    void searchFinished(unsigned, unsigned, unsigned, QString);
 
 Q_SIGNALS:
     void indexStatusChanged(const QString&, bool);
@@ -126,6 +163,14 @@ Q_SIGNALS:
     void reindexingFinished(const QString&);
     void setIndexLocalsChecked(bool);
     void setSkipImplicitsChecked(bool);
+    void setOutOfProcessChecked(bool);
+    void setIndexingJobs(int);
+    void setIndexingProfile(int);
+    void setCompilationDatabase(const QString&);
+    void setExcludedDirectories(const QString&);
+    void unitIndexed(kate::index::unit_stats, kate::index::indexing_stats);
+    void searchResultsFound(unsigned, kate::index::search_results_batch);
+    void searchCacheUsageChanged(unsigned, unsigned);
 
 private:
     friend class IndicesTableModel;
@@ -158,26 +203,70 @@ private:
 
     typedef std::vector<database_state> collections_type;
 
+    /// What (re)indexing is going to do
+    enum class indexing_mode
+    {
+        update                                              ///< Reparse changed/new TUs only
+      , rebuild                                             ///< Rebuild from scratch
+      , declarations                                        ///< Fast pass for declarations only
+      , references                                          ///< Complete rebuild in background
+      , live                                                ///< Reparse saved files right in a searchable DB
+    };
+
     static KUrl getDefaultBaseDir();
     database_state tryLoadDatabaseMeta(const boost::filesystem::path&);
     void enable(int, bool);
     bool isEnabled(int) const;
     void renameCollection(int, const QString&);
+    void startIndexer(int, bool, const QStringList& = QStringList{});
+    void startIndexerProcess(
+        int
+      , const boost::filesystem::path&
+      , const boost::filesystem::path&
+      , indexing_mode
+      , const QStringList&
+      );
+    void startPendingUpdate();
+    void beginIndexing(int, bool);
+    void detachIndex(database_state&);
+    void finishIndexing(bool);
+    bool reloadIndex(database_state&, const boost::filesystem::path&);
+    static bool isResumable(const boost::filesystem::path&);
+    static bool isIndexedBy(const database_state&, const QString&);
+    static QStringList dependentUnits(const database_state&, const QString&);
     index::search_result makeSearchResult(const index::document&);
     void reportError(const QString& = QString{}, int = -1, bool = false);
+    void reportSearchCacheUsage();
     const database_state& findIndexByID(const index::dbid) const;
+    const database_state* lookupIndexByID(const index::dbid) const;
 
     KUrl m_base_dir;
     IndicesTableModel m_indices_model;
     IndexingTargetsListModel m_targets_model;
     collections_type m_collections;
     std::set<boost::uuids::uuid> m_enabled_list;
+    std::map<boost::uuids::uuid, QStringList> m_pending_updates; ///< Saved files to reindex
+    std::map<QString, std::unique_ptr<TranslationUnit>> m_parsed_units; ///< Parsed saved files to reindex
+    std::map<QString, std::unique_ptr<TranslationUnit>> m_lent_units; ///< ... used by the indexer right now
     clang::compiler_options m_compiler_options;
     std::unique_ptr<index::indexer> m_indexer;
+    std::unique_ptr<KProcess> m_indexer_process;            ///< Out of process indexer (\c kate-cpp-indexer)
+    std::unique_ptr<QThread> m_compaction_thread;
+    std::unique_ptr<index::searcher> m_searcher;            ///< Background search (created on demand)
+    std::unique_ptr<QThread> m_search_thread;
     index::combined_index m_search_db;
     int m_last_selected_index;
     int m_last_selected_target;
     int m_indexing_in_progress;
+    indexing_mode m_indexing_mode = {indexing_mode::update};
+    unsigned m_processed_files = {0};                       ///< Indexing progress
+    unsigned m_total_files = {0};                           ///< Files to index (\c 0 if not known yet)
+    unsigned m_eta = {0};                                   ///< Time to finish indexing (seconds)
+    unsigned m_search_serial = {0};                         ///< The latest background search request
+    unsigned m_indices_generation = {0};                    ///< Changed every time any index get (re)opened
+    bool m_indexer_process_finished = {false};              ///< Indexer process has reported it is done
+    bool m_indexer_process_cancelled = {false};             ///< ... and its indexing has been stopped
+    bool m_lent_units_expired = {false};                    ///< Lent TUs must not be taken back
 };
 
 struct DatabaseManager::exception::invalid_manifest : public DatabaseManager::exception
@@ -32,8 +32,144 @@
 
 // Standard includes
 #include <KDE/KDebug>
+#include <QtCore/QRegExp>
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace kate { namespace index { namespace {
+
+/// Check if a query word is a name pattern: \c *fragment* (of 3 chars at least) or \c /expression/
+bool is_name_pattern(const std::string& word)
+{
+    return (4 < word.size() && word.front() == '*' && word.back() == '*')
+      || (2 < word.size() && word.front() == '/' && word.back() == '/')
+      ;
+}
+
+/// Check if a query word is a boolean operator of Xapian's query parser
+bool is_operator(const std::string& word)
+{
+    return word == "AND" || word == "OR" || word == "NOT" || word == "XOR"
+      || word == "NEAR" || word == "ADJ"
+      || word.compare(0, 5, "NEAR/") == 0 || word.compare(0, 4, "ADJ/") == 0
+      ;
+}
+
+/// A word, a parenthesis or a name pattern of a query
+struct query_token
+{
+    std::string m_text;
+    bool m_is_pattern;
+    bool m_is_cut;                                          ///< Token doesn't go to a query parser
+};
+
+/**
+ * Split a query into words and parentheses. An expression pattern may
+ * contain spaces and parentheses, so it ends w/ an unescaped slash followed
+ * by a space, a closing parenthesis or an end of a query. A slash w/o such
+ * a pair is just a word.
+ *
+ * 	hrow std::runtime_error if a name pattern is in parentheses
+ */
+std::vector<query_token> tokenize_query(const std::string& query)
+{
+    const auto is_delimiter = [&query](const std::size_t pos)
+    {
+        return pos == query.size()
+          || std::isspace(static_cast<unsigned char>(query[pos]))
+          || query[pos] == '('
+          || query[pos] == ')'
+          ;
+    };
+    auto result = std::vector<query_token>{};
+    auto depth = 0;
+    for (auto pos = std::size_t{}; pos < query.size();)
+    {
+        if (std::isspace(static_cast<unsigned char>(query[pos])))
+        {
+            ++pos;
+            continue;
+        }
+        if (query[pos] == '(' || query[pos] == ')')
+        {
+            depth += query[pos] == '(' ? 1 : -1;
+            result.push_back({std::string(1, query[pos]), false, false});
+            ++pos;
+            continue;
+        }
+        auto last = pos + 1;
+        if (query[pos] == '/')
+        {
+            while (last < query.size() && !(query[last] == '/' && is_delimiter(last + 1)))
+                last += query[last] == '\\' ? 2 : 1;
+            last = last < query.size() ? last + 1 : pos + 1;
+        }
+        while (!is_delimiter(last))
+            ++last;
+        auto text = query.substr(pos, last - pos);
+        const auto is_pattern = is_name_pattern(text);
+        if (is_pattern && 0 < depth)
+            throw std::runtime_error("Invalid query: name pattern " + text + " can't be used in parentheses");
+        result.push_back({std::move(text), is_pattern, is_pattern});
+        pos = last;
+    }
+    return result;
+}
+
+/**
+ * Cut name patterns off from a query. Patterns are combined w/ the rest
+ * of a query by \c AND, so an \c AND joining a pattern to the rest is
+ * removed as well (just one, so words around a pattern remain joined).
+ * Other operators can't be translated this way.
+ *
+ * \throw std::runtime_error if a pattern is used w/ an operator other than
+ * \c AND, or in parentheses
+ */
+std::string cut_name_patterns(const std::string& query, std::vector<std::string>& patterns)
+{
+    auto tokens = tokenize_query(query);
+    const auto find_prev = [&tokens](std::size_t i)
+    {
+        while (i && tokens[i - 1].m_is_cut)
+            --i;
+        return i ? &tokens[i - 1] : nullptr;
+    };
+    const auto find_next = [&tokens](std::size_t i)
+    {
+        while (i + 1 < tokens.size() && tokens[i + 1].m_is_cut)
+            ++i;
+        return i + 1 < tokens.size() ? &tokens[i + 1] : nullptr;
+    };
+    for (auto i = std::size_t{}; i < tokens.size(); ++i)
+    {
+        if (!tokens[i].m_is_pattern)
+            continue;
+        patterns.emplace_back(tokens[i].m_text);
+        auto* const prev = find_prev(i);
+        auto* const next = find_next(i);
+        for (const auto* const op : {prev, next})
+            if (op && op->m_text != "AND" && is_operator(op->m_text))
+                throw std::runtime_error(
+                    "Invalid query: name pattern " + tokens[i].m_text
+                  + " can be combined by AND only, not by " + op->m_text
+                  );
+        if (prev && prev->m_text == "AND")
+            prev->m_is_cut = true;
+        else if (!prev && next && next->m_text == "AND")
+            next->m_is_cut = true;
+    }
+    if (patterns.empty())
+        return query;
+    auto result = std::string{};
+    for (const auto& token : tokens)
+        if (!token.m_is_cut)
+            result += (result.empty() ? "" : " ") + token.m_text;
+    return result;
+}
+
+}                                                           // anonymous namespace
 
-namespace kate { namespace index {
 /**
  * \attention If u r going to modify this constructor somehow,
  * make sure \c KCompletion model also modified accordingly.
@@ -77,6 +213,56 @@ std::pair<std::vector<document>, doccount> combined_index::search(
   , const doccount start
   , const doccount maxitems
   )
+{
+    const auto matches = get_matches(q, start, maxitems);
+    auto result = std::vector<document>{};
+    result.reserve(matches.m_ids.size());
+    try
+    {
+        for (const auto id : matches.m_ids)
+            result.emplace_back(m_compound_db->get_document(id));
+    }
+    catch (const Xapian::Error& e)
+    {
+        throw std::runtime_error(std::string{"Database failure: "} + e.get_msg());
+    }
+    return std::make_pair(std::move(result), matches.m_estimated);
+}
+
+/**
+ * Found documents are not read at all: only references to them are returned,
+ * so a caller can read just documents it really needs (e.g. visible ones).
+ */
+std::pair<std::vector<docref>, doccount> combined_index::search_refs(
+    const QString& q
+  , const doccount start
+  , const doccount maxitems
+  )
+{
+    const auto matches = get_matches(q, start, maxitems);
+    auto result = std::vector<docref>{};
+    result.reserve(matches.m_ids.size());
+    for (const auto id : matches.m_ids)
+        result.emplace_back(to_docref(id));
+    return std::make_pair(std::move(result), matches.m_estimated);
+}
+
+/**
+ * Xapian interleaves document IDs of combined databases: a document \c N
+ * of a database \c I (of \c K combined) has ID <tt>(N - 1) * K + I + 1</tt>.
+ */
+docref combined_index::to_docref(const Xapian::docid id) const
+{
+    assert("Sanity check" && id != IVALID_DOCUMENT_ID && !m_db_list.empty());
+    const auto count = Xapian::docid(m_db_list.size());
+    return {m_db_list[(id - 1) % count]->id(), (id - 1) / count + 1};
+}
+
+cached_matches combined_index::get_matches(
+    const QString& q
+  , const doccount start
+  , const doccount maxitems
+  )
 {
     recombine_database();                                   // Make sure DB is Ok
     assert("Sanity check" && m_compound_db);
@@ -86,30 +272,173 @@ std::pair<std::vector<document>, doccount> combined_index::search(
         throw std::runtime_error("No indices enabled for search...");
     }
     //
-    auto query_str = std::string{q.toUtf8().constData()};
-    Xapian::Query query = parse_query(query_str);
+    const auto key = make_cache_key(q, start, maxitems);
+    if (const auto* const cached = m_cache.find(key))
+    {
+        kDebug(DEBUG_AREA) << "Documents found (cached):" << cached->m_ids.size();
+        return *cached;
+    }
+    //
+    Xapian::Query query = make_query(q.toUtf8().constData());
     kDebug(DEBUG_AREA) << "Parsed query: " << query.get_description().c_str();
     //
-    Xapian::MSet matches;
+    auto result = cached_matches{};
     try
     {
         auto enquire = Xapian::Enquire{*m_compound_db};     // NOTE May throw only if DB instance is uninitialized
         enquire.set_query(query);
         enquire.set_sort_by_relevance();
-        matches = enquire.get_mset(start, maxitems, 100000);
+        const auto matches = enquire.get_mset(start, maxitems, 100000);
+        result.m_ids.reserve(matches.size());
+        for (auto it = std::begin(matches), last = std::end(matches); it != last; ++it)
+            result.m_ids.emplace_back(*it);
+        result.m_estimated = matches.get_matches_estimated();
     }
     catch (const Xapian::Error& e)
     {
         throw std::runtime_error(std::string{"Database failure: "} + e.get_msg());
     }
-    kDebug(DEBUG_AREA) <<  "Documents found:" << matches.size();
-    kDebug(DEBUG_AREA) << "Documents estimated:" << matches.get_matches_estimated();
-    //
+    kDebug(DEBUG_AREA) <<  "Documents found:" << result.m_ids.size();
+    kDebug(DEBUG_AREA) << "Documents estimated:" << result.m_estimated;
+    for (const auto* const db : m_db_list)
+        result.m_indices.emplace_back(db->id());
+    m_cache.insert(key, cached_matches{result});
+    return result;
+}
+
+/**
+ * Document IDs in a combined DB depend on order of indices,
+ * so the key lists them in the same order.
+ */
+std::string combined_index::make_cache_key(
+    const QString& q
+  , const doccount start
+  , const doccount maxitems
+  ) const
+{
+    auto result = std::string{q.simplified().toUtf8().constData()};
+    result += '\0';
+    result += std::to_string(start) + ':' + std::to_string(maxitems);
+    for (const auto* const db : m_db_list)
+        result += '\0' + std::to_string(db->id()) + '.' + std::to_string(m_revisions.find(db->id())->second);
+    return result;
+}
+
+/**
+ * Unlike \c search() it doesn't need a query parser and ranking: it's just
+ * a single posting list read. So it's much faster, and gives an exact
+ * match, instead of any same named symbol.
+ */
+std::vector<document> combined_index::find_entity(const std::string& usr)
+{
+    recombine_database();                                   // Make sure DB is Ok
+    assert("Sanity check" && m_compound_db);
     auto result = std::vector<document>{};
-    result.reserve(matches.size());
-    for (auto it = std::begin(matches), last = std::end(matches); it != last; ++it)
-        result.emplace_back(it.get_document());
-    return std::make_pair(std::move(result), matches.get_matches_estimated());
+    if (m_db_list.empty() || usr.empty())
+        return result;
+
+    auto usr_term = std::string{};
+    make_usr_term(usr.c_str(), usr_term);
+    try
+    {
+        for (
+            auto it = m_compound_db->postlist_begin(usr_term), last = m_compound_db->postlist_end(usr_term)
+          ; it != last
+          ; ++it
+          )
+        {
+            auto doc = document{m_compound_db->get_document(*it)};
+            // NOTE Long USRs are hashed, so make sure it is not a collision
+            if (doc.get_value(value_slot::USR) == usr)
+                result.emplace_back(std::move(doc));
+        }
+    }
+    catch (const Xapian::Error& e)
+    {
+        throw std::runtime_error(std::string{"Database failure: "} + e.get_msg());
+    }
+    kDebug(DEBUG_AREA) << "Documents found by USR:" << result.size();
+    return result;
+}
+
+/**
+ * References are not documents, so they are looked up in a cross references
+ * table of every index. Tables are keyed by a 64-bit hash of USR, so
+ * collisions are not checked.
+ */
+std::vector<std::pair<dbid, xref>> combined_index::find_references(const std::string& usr) const
+{
+    auto result = std::vector<std::pair<dbid, xref>>{};
+    if (usr.empty())
+        return result;
+    const auto symbol = usr_hash(usr.c_str());
+    for (const auto* const db : m_db_list)
+        for (const auto& ref : db->references().find(symbol))
+            result.emplace_back(db->id(), ref);
+    kDebug(DEBUG_AREA) << "References found by USR:" << result.size();
+    return result;
+}
+
+/**
+ * Names w/ a given prefix go first, then names containing a given
+ * subsequence of chars. Names similar to a given one (i.e. misspelled)
+ * are looked up only if nothing else found.
+ */
+std::vector<std::string> combined_index::complete_name(const std::string& pattern, const std::size_t max) const
+{
+    auto result = std::vector<std::string>{};
+    const auto append = [&result, max](std::vector<std::string>&& names)
+    {
+        for (auto& name : names)
+            if (result.size() < max && std::find(begin(result), end(result), name) == end(result))
+                result.emplace_back(std::move(name));
+    };
+    if (pattern.empty())
+        return result;
+    for (const auto* const db : m_db_list)
+        append(db->declaration_names().find_prefix(pattern, max));
+    for (const auto* const db : m_db_list)
+        if (result.size() < max)
+            append(db->declaration_names().find_subsequence(pattern, max));
+    if (result.empty())
+    {
+        const auto distance = pattern.size() < 6 ? 1u : 2u;
+        for (const auto* const db : m_db_list)
+            append(db->declaration_names().find_similar(pattern, distance, max));
+    }
+    return result;
+}
+
+/**
+ * Patterns are looked up in trigram tables of indices, so indices w/o them
+ * (made by older versions or w/ a \c navigation profile) give nothing.
+ * Found names are lowercased, just like name terms of documents.
+ */
+std::vector<std::string> combined_index::find_names(const std::string& pattern) const
+{
+    assert("Sanity check" && is_name_pattern(pattern));
+    auto result = std::vector<std::string>{};
+    const auto body = pattern.substr(1, pattern.size() - 2);
+    const auto append = [&result](std::vector<std::string>&& names)
+    {
+        std::move(begin(names), end(names), std::back_inserter(result));
+    };
+    if (pattern.front() == '/')
+    {
+        const auto re = QString::fromUtf8(body.c_str());
+        if (!QRegExp{re, Qt::CaseInsensitive, QRegExp::RegExp2}.isValid())
+            throw std::runtime_error("Invalid query: bad regular expression " + pattern);
+        for (const auto* const db : m_db_list)
+            append(db->trigrams().find_regex(re));
+    }
+    else
+    {
+        for (const auto* const db : m_db_list)
+            append(db->trigrams().find_substring(body));
+    }
+    std::sort(begin(result), end(result));
+    result.erase(std::unique(begin(result), end(result)), end(result));
+    return result;
 }
 
 void combined_index::add_index(ro::database* ptr)
@@ -120,6 +449,8 @@ void combined_index::add_index(ro::database* ptr)
         recombine_database();
         m_db_list.emplace_back(ptr);
         m_compound_db->add_database(*ptr);
+        m_revisions[ptr->id()] = ++m_last_revision;
+        m_cache.invalidate(ptr->id());
         kDebug(DEBUG_AREA) << "add index to search:" << ptr->id() << ":" << m_db_list.size();
     }
 }
@@ -131,6 +462,8 @@ void combined_index::remove_index(ro::database* ptr)
     {
         m_db_list.erase(it);
         m_compound_db.reset();
+        m_revisions.erase(ptr->id());
+        m_cache.invalidate(ptr->id());
         kDebug(DEBUG_AREA) << "remove index from search:" << ptr->id() << ":" << m_db_list.size();
     }
 }
@@ -145,6 +478,30 @@ void combined_index::recombine_database()
     }
 }
 
+/**
+ * Name patterns are not understood by Xapian's query parser, so they are
+ * cut off from a query and replaced w/ synonyms of matching names (i.e. any
+ * of them), combined w/ the rest of a query by \c AND. So no terms get
+ * expanded by scanning a whole DB.
+ */
+Xapian::Query combined_index::make_query(const std::string& query_str)
+{
+    auto patterns = std::vector<std::string>{};
+    const auto rest = cut_name_patterns(query_str, patterns);
+    auto query = rest.empty() && !patterns.empty() ? Xapian::Query{} : parse_query(rest);
+    for (const auto& pattern : patterns)
+    {
+        const auto names = find_names(pattern);
+        kDebug(DEBUG_AREA) << "Names matching" << pattern.c_str() << ":" << names.size();
+        const auto names_query = names.empty()
+          ? Xapian::Query::MatchNothing
+          : Xapian::Query{Xapian::Query::OP_SYNONYM, begin(names), end(names)}
+          ;
+        query = query.empty() ? names_query : Xapian::Query{Xapian::Query::OP_AND, query, names_query};
+    }
+    return query;
+}
+
 Xapian::Query combined_index::parse_query(const std::string& query_str)
 {
     assert("Sanity check" && m_compound_db);
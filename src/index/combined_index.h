@@ -30,9 +30,13 @@
 // Project specific includes
 #include "types.h"
 #include "numeric_value_range_processor.h"
+#include "query_cache.h"
+#include "xref_table.h"
 
 // Standard includes
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -53,7 +57,16 @@ class document;
 /**
  * \brief Compound searchable database
  *
- * [More detailed description here]
+ * Results of recent queries are cached (as document IDs), so repeated
+ * queries don't touch Xapian at all. A cache key includes every used
+ * index w/ its revision, and a revision changes every time an index
+ * gets (re)added, so cached results of a rebuilt/updated index are
+ * never used (and dropped as soon as the index gets removed/reopened).
+ *
+ * Besides Xapian's query syntax, a query may contain name patterns:
+ * \c *fragment* to find declarations w/ a name containing a fragment,
+ * and \c /expression/ to find names matching a regular expression.
+ * Names are looked up in trigram tables of indices (see \c trigram_table).
  *
  */
 class combined_index
@@ -63,17 +76,35 @@ public:
     combined_index();
     /// Search over all connected indices
     std::pair<std::vector<document>, doccount> search(const QString&, doccount = 0, doccount = 2000);
+    /// Search over all connected indices, get references to found documents only
+    std::pair<std::vector<docref>, doccount> search_refs(const QString&, doccount = 0, doccount = 2000);
+    /// Turn a document ID in a combined DB into a reference to a document of a particular index
+    docref to_docref(Xapian::docid) const;
+    /// Get all documents (declarations and references) of an entity w/ a given USR
+    std::vector<document> find_entity(const std::string&);
+    /// Get all references to an entity w/ a given USR from cross references tables
+    std::vector<std::pair<dbid, xref>> find_references(const std::string&) const;
+    /// Get declaration names matching a given (partial) name
+    std::vector<std::string> complete_name(const std::string&, std::size_t) const;
 
     void add_index(ro::database*);                          ///< Add index to a list of used
     void remove_index(ro::database*);                       ///< Remove index from search
 
     std::size_t used_indices() const;                       ///< Get count of used indices
+    query_cache_stats cache_stats() const;                  ///< Get query cache usage counters
 
 private:
     void recombine_database();
     Xapian::Query parse_query(const std::string&);
+    Xapian::Query make_query(const std::string&);
+    std::vector<std::string> find_names(const std::string&) const;
+    cached_matches get_matches(const QString&, doccount, doccount);
+    std::string make_cache_key(const QString&, doccount, doccount) const;
 
     std::vector<ro::database*> m_db_list;
+    std::map<dbid, unsigned> m_revisions;                   ///< Revisions of used indices
+    unsigned m_last_revision = {0};
+    query_cache m_cache;
     std::unique_ptr<Xapian::Database> m_compound_db;
     numeric_value_range_processor m_arity_processor;
     numeric_value_range_processor m_size_processor;
@@ -88,4 +119,9 @@ inline std::size_t combined_index::used_indices() const
     return m_db_list.size();
 }
 
+inline query_cache_stats combined_index::cache_stats() const
+{
+    return m_cache.stats();
+}
+
 }}                                                          // namespace index, kate
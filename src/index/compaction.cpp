@@ -0,0 +1,170 @@
+/**
+ * \file
+ *
+ * \brief Function \c kate::index::compact() and class \c kate::index::compaction_job (implementation)
+ *
+ * \date Fri Oct 16 22:05:13 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "compaction.h"
+#include "database.h"
+
+// Standard includes
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <KDE/KDebug>
+#include <xapian.h>
+#include <chrono>
+
+namespace kate { namespace index { namespace {
+
+const std::string COMPACTING_SUFFIX = ".compacting";
+
+/// Check if a file belongs to a Xapian DB (of any backend)
+bool is_xapian_file(const std::string& name)
+{
+    using boost::algorithm::ends_with;
+    using boost::algorithm::starts_with;
+    return name == "flintlock"
+      || starts_with(name, "iam")
+      || starts_with(name, "changes")
+      || ends_with(name, ".DB")
+      || ends_with(name, ".baseA")
+      || ends_with(name, ".baseB")
+      || ends_with(name, ".glass")
+      || ends_with(name, ".tmp")
+      ;
+}
+
+std::uint64_t database_size(const boost::filesystem::path& dir)
+{
+    auto result = std::uint64_t{0};
+    boost::system::error_code error;
+    for (
+        auto it = boost::filesystem::directory_iterator{dir, error}
+      , last = boost::filesystem::directory_iterator{}
+      ; it != last
+      ; it.increment(error)
+      )
+    {
+        if (is_xapian_file(it->path().filename().string()) && boost::filesystem::is_regular_file(it->status()))
+            result += boost::filesystem::file_size(it->path(), error);
+    }
+    return result;
+}
+
+}                                                           // anonymous namespace
+
+/**
+ * Sources are merged w/o document IDs renumbering, cuz IDs are referred
+ * from the DB metadata (files manifest). A compacted DB is written aside first,
+ * then it replaces an original one. Other files in the DB directory (like
+ * a manifest of the plugin or indexing statistics) are preserved.
+ */
+compaction_stats compact(const std::string& path, const std::vector<std::string>& sources)
+{
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto target = boost::filesystem::path{path};
+    const auto output = boost::filesystem::path{path + COMPACTING_SUFFIX};
+    auto result = compaction_stats{};
+
+    boost::system::error_code error;
+    boost::filesystem::remove_all(output, error);           // Possible leftover of a failed compaction
+
+    Xapian::Compactor compactor;
+    compactor.set_renumber(false);
+    compactor.set_multipass(true);
+    if (sources.empty())
+    {
+        compactor.add_source(path);
+        result.m_size_before = database_size(target);
+    }
+    else
+    {
+        for (const auto& src : sources)
+        {
+            compactor.add_source(src);
+            result.m_size_before += database_size(src);
+        }
+    }
+    compactor.set_destdir(output.string());
+    kDebug(DEBUG_AREA) << "Compacting" << sources.size() << "DB(s) into" << output.c_str();
+    compactor.compact();
+
+    try
+    {
+        // Move the rest files to the compacted DB and replace the original one
+        for (
+            auto it = boost::filesystem::directory_iterator{target}
+          , last = boost::filesystem::directory_iterator{}
+          ; it != last
+          ; ++it
+          )
+        {
+            const auto name = it->path().filename();
+            if (!is_xapian_file(name.string()))
+                boost::filesystem::rename(it->path(), output / name);
+        }
+        boost::filesystem::remove_all(target);
+        boost::filesystem::rename(output, target);
+    }
+    catch (const boost::filesystem::filesystem_error& e)
+    {
+        throw exception::database_failure{"Index database [" + path + "] failure: " + e.what()};
+    }
+
+    result.m_size_after = database_size(target);
+    result.m_time = std::uint64_t(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time
+          ).count()
+      );
+    return result;
+}
+
+compaction_job::compaction_job(const std::string& path)
+  : m_path{path}
+{
+    qRegisterMetaType<compaction_stats>("kate::index::compaction_stats");
+}
+
+void compaction_job::process()
+{
+    auto stats = compaction_stats{};
+    auto error = QString{};
+    try
+    {
+        stats = compact(m_path);
+    }
+    catch (const std::exception& e)
+    {
+        error = QString::fromLocal8Bit(e.what());
+    }
+    catch (const Xapian::Error& e)
+    {
+        error = QString::fromUtf8(e.get_msg().c_str());
+    }
+    Q_EMIT(finished(stats, error));
+}
+
+}}                                                          // namespace index, kate
@@ -0,0 +1,88 @@
+/**
+ * \file
+ *
+ * \brief Function \c kate::index::compact() and class \c kate::index::compaction_job (interface)
+ *
+ * \date Fri Oct 16 22:05:13 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+
+// Standard includes
+#include <QtCore/QMetaType>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kate { namespace index {
+
+/// Result of a DB compaction
+struct compaction_stats
+{
+    std::uint64_t m_size_before = {0};                      ///< Total size of source DBs (bytes)
+    std::uint64_t m_size_after = {0};                       ///< Size of the compacted DB (bytes)
+    std::uint64_t m_time = {0};                             ///< Time spent (ms)
+};
+
+/**
+ * \brief Compact a DB (or merge few DBs) into a DB at the given path
+ *
+ * \param[in] path DB to be replaced w/ a compacted one (must not be opened)
+ * \param[in] sources DBs to merge (w/ disjoint ranges of document IDs),
+ * if empty, a DB at \c path is compacted itself
+ *
+ * \throw Xapian::Error on compaction failure
+ * \throw exception::database_failure if compacted DB can't be moved in place
+ */
+compaction_stats compact(const std::string& path, const std::vector<std::string>& sources = {});
+
+/**
+ * \brief Compact a DB in a background thread
+ *
+ * Move an instance to a thread and connect its \c process() slot to
+ * \c QThread::started(). The instance is done after \c finished() emitted.
+ */
+class compaction_job : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit compaction_job(const std::string&);
+
+public Q_SLOTS:
+    void process();
+
+Q_SIGNALS:
+    /// Compaction stats and an error message (empty on success)
+    void finished(kate::index::compaction_stats, QString);
+
+private:
+    const std::string m_path;
+};
+
+}}                                                          // namespace index, kate
+
+Q_DECLARE_METATYPE(kate::index::compaction_stats);
@@ -34,6 +34,11 @@
 namespace kate { namespace index { namespace { namespace meta {
 const std::string FILES_MAPPING = "HDRMAPCACHE";
 const std::string DB_ID = "DBID";
+const std::string FILES_STATE = "FILESSTATE";
+const std::string INCOMPLETE = "INCOMPLETE";
+const std::string DECLARATIONS_ONLY = "DECLONLY";
+const std::string INCLUDES = "INCLUDES";
+const std::string PROFILE = "PROFILE";
 }}                                                          // namespace meta, anonymous namespace
 
 namespace rw {
@@ -42,6 +47,20 @@ database::database(const dbid db_id, const std::string& path) try
   : Xapian::WritableDatabase{path, Xapian::DB_CREATE_OR_OPEN}
   , details::database{db_id}
 {
+    // Load meta of an existed DB (to be updated)
+    const auto hdr_cache = get_metadata(meta::FILES_MAPPING);
+    if (!hdr_cache.empty())
+        m_files_cache.loadFromString(hdr_cache);
+    const auto files_state = get_metadata(meta::FILES_STATE);
+    if (!files_state.empty())
+        m_manifest.loadFromString(files_state);
+    const auto includes = get_metadata(meta::INCLUDES);
+    if (!includes.empty())
+        m_includes.loadFromString(includes);
+    m_declarations_only = !get_metadata(meta::DECLARATIONS_ONLY).empty();
+    const auto profile = get_metadata(meta::PROFILE);
+    if (!profile.empty())
+        m_profile = indexing_profile(deserialize<int>(profile));
 }
 catch (const Xapian::DatabaseError& e)
 {
@@ -49,18 +68,75 @@ catch (const Xapian::DatabaseError& e)
 }
 
 database::~database()
+{
+    store_meta();
+    commit();
+}
+
+void database::store_meta()
 {
     try
     {
         kDebug(DEBUG_AREA) << "Store DB meta [" << id() << "]...";
         set_metadata(meta::DB_ID, serialize(id()));
         set_metadata(meta::FILES_MAPPING, headers_map().storeToString());
+        set_metadata(meta::FILES_STATE, files_manifest().storeToString());
+        set_metadata(meta::INCLUDES, includes().storeToString());
+    }
+    catch (const Xapian::DatabaseError& e)
+    {
+        kDebug(DEBUG_AREA) << "Fail to store DB meta:" << e.get_msg().c_str();
+    }
+}
+
+/**
+ * Incomplete DB has not all targets indexed yet. Indexer marks a DB
+ * this way at start and remove the mark when all targets are done.
+ */
+void database::set_incomplete(const bool flag)
+{
+    try
+    {
+        set_metadata(meta::INCOMPLETE, flag ? "y" : "");
+    }
+    catch (const Xapian::DatabaseError& e)
+    {
+        kDebug(DEBUG_AREA) << "Fail to store DB meta:" << e.get_msg().c_str();
+    }
+}
+
+/**
+ * DB made by a declarations pass of the indexer (see \c indexer::set_declarations_only())
+ * has no references, so it has to be reindexed in full later.
+ */
+void database::set_declarations_only(const bool flag)
+{
+    try
+    {
+        set_metadata(meta::DECLARATIONS_ONLY, flag ? "y" : "");
+        m_declarations_only = flag;
+    }
+    catch (const Xapian::DatabaseError& e)
+    {
+        kDebug(DEBUG_AREA) << "Fail to store DB meta:" << e.get_msg().c_str();
+    }
+}
+
+/**
+ * Profile configured for a collection may be changed at any time, so the one
+ * the DB was actually built w/ has to be stored to tell them apart.
+ */
+void database::set_profile(const indexing_profile profile)
+{
+    try
+    {
+        set_metadata(meta::PROFILE, serialize(int(profile)));
+        m_profile = profile;
     }
     catch (const Xapian::DatabaseError& e)
     {
         kDebug(DEBUG_AREA) << "Fail to store DB meta:" << e.get_msg().c_str();
     }
-    commit();
 }
 
 void database::commit()
@@ -89,6 +165,8 @@ namespace ro {
 database::database(const std::string& path) try
   : Xapian::Database{path}
   , details::database{}
+  , m_references{xref_table_path(path)}
+  , m_trigrams{trigram_table_path(path)}
 {
     // Get internal DB ID
     auto db_id_str = static_cast<Database* const>(this)->get_metadata(meta::DB_ID);
@@ -98,10 +176,60 @@ database::database(const std::string& path) try
     auto hdr_cache = static_cast<Database* const>(this)->get_metadata(meta::FILES_MAPPING);
     assert("Sanity check" && !hdr_cache.empty());
     m_files_cache.loadFromString(hdr_cache);
+    // Load indexed files state (absent in DBs made by older versions)
+    auto files_state = static_cast<Database* const>(this)->get_metadata(meta::FILES_STATE);
+    if (!files_state.empty())
+        m_manifest.loadFromString(files_state);
+    // Load include edges (absent in DBs made by older versions)
+    auto includes = static_cast<Database* const>(this)->get_metadata(meta::INCLUDES);
+    if (!includes.empty())
+        m_includes.loadFromString(includes);
+    m_declarations_only = !static_cast<Database* const>(this)->get_metadata(meta::DECLARATIONS_ONLY).empty();
+    // Load indexing profile (absent in DBs made by older versions)
+    auto profile = static_cast<Database* const>(this)->get_metadata(meta::PROFILE);
+    if (!profile.empty())
+        m_profile = indexing_profile(deserialize<int>(profile));
 }
 catch (const Xapian::DatabaseError& e)
 {
     throw exception::database_failure{"Index database [" + path + "] failure: " + e.get_msg()};
 }
 
+/**
+ * Names are collected from DB terms, so DBs opened just to run queries
+ * (e.g. by a background searcher) don't pay for it.
+ *
+ * \throw Xapian::Error on DB failure
+ */
+const name_index& database::declaration_names() const
+{
+    if (!m_declaration_names_collected)
+    {
+        m_declaration_names.build(collect_declaration_names(*this));
+        m_declaration_names_collected = true;
+        kDebug(DEBUG_AREA) << "Declaration names collected:" << m_declaration_names.size();
+    }
+    return m_declaration_names;
+}
+
+/**
+ * \note DB metadata may be absent at all, if indexing was interrupted
+ * before the first checkpoint, so \c database can't be used here.
+ */
+bool database::is_incomplete(const std::string& path)
+{
+    try
+    {
+        auto db = Xapian::Database{path};
+        return !db.get_metadata(meta::INCOMPLETE).empty()
+          && !db.get_metadata(meta::FILES_STATE).empty()
+          ;
+    }
+    catch (const Xapian::Error& e)
+    {
+        kDebug(DEBUG_AREA) << "Can't open DB" << path.c_str() << ":" << e.get_msg().c_str();
+    }
+    return false;
+}
+
 }}}                                                         // namespace ro, index, kate
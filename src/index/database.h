@@ -28,6 +28,9 @@
 #pragma once
 
 // Project specific includes
+#include "name_index.h"
+#include "trigram_table.h"
+#include "xref_table.h"
 #include "details/database.h"
 
 // Standard includes
@@ -66,6 +69,18 @@ public:
 
     /// Access header files mapping cache (mutable)
     HeaderFilesCache& headers_map();
+    /// Access indexed files state (mutable)
+    freshness_manifest& files_manifest();
+    /// Access include edges between indexed files (mutable)
+    include_graph& includes();
+    /// Write DB ID, headers map, files state and include edges to the DB metadata
+    void store_meta();
+    /// Mark DB as (not) fully indexed
+    void set_incomplete(bool);
+    /// Mark DB as having (not) declarations only
+    void set_declarations_only(bool);
+    /// Remember indexing profile the DB was built w/
+    void set_profile(indexing_profile);
     /// Commit recent changes to the DB
     void commit();
 };
@@ -75,6 +90,16 @@ inline HeaderFilesCache& database::headers_map()
     return m_files_cache;
 }
 
+inline freshness_manifest& database::files_manifest()
+{
+    return m_manifest;
+}
+
+inline include_graph& database::includes()
+{
+    return m_includes;
+}
+
 }                                                           // namespace rw
 
 /// Read-only access to the indexer database
@@ -87,6 +112,30 @@ class database : public Xapian::Database, public details::database
 public:
     /// Construct from DB path
     explicit database(const std::string&);
+    /// Check if indexing of a DB at given path was interrupted after some checkpoint
+    static bool is_incomplete(const std::string&);
+    /// Access cross references table (empty for DBs made by older versions)
+    const xref_table& references() const;
+    /// Access trigrams of declaration names (empty for DBs w/o a trigrams table)
+    const trigram_table& trigrams() const;
+    /// Access names of declarations (collected on first access)
+    const name_index& declaration_names() const;
+
+private:
+    xref_table m_references;
+    trigram_table m_trigrams;
+    mutable name_index m_declaration_names;
+    mutable bool m_declaration_names_collected = {false};
 };
 
+inline const xref_table& database::references() const
+{
+    return m_references;
+}
+
+inline const trigram_table& database::trigrams() const
+{
+    return m_trigrams;
+}
+
 }}}                                                         // namespace ro, index, kate
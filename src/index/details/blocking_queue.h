@@ -0,0 +1,114 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::blocking_queue (interface)
+ *
+ * \date Fri Oct 16 12:05:41 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+
+// Standard includes
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace kate { namespace index { namespace details {
+
+/**
+ * \brief Bounded multi-producer/multi-consumer queue
+ *
+ * Producers are blocked by \c push() when the queue is full, so parsing
+ * workers can't run too far ahead of the (single) database writer.
+ * After \c close() no more items accepted and consumers will get \c false
+ * from \c pop() as soon as the queue is drained.
+ */
+template <typename T>
+class blocking_queue
+{
+public:
+    explicit blocking_queue(const std::size_t capacity)
+      : m_capacity{capacity}
+    {
+        assert("Sanity check" && capacity);
+    }
+
+    /// Append an item (block while the queue is full)
+    bool push(T&& item)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_not_full.wait(
+            lock
+          , [this]()
+            {
+                return m_closed || m_items.size() < m_capacity;
+            }
+          );
+        if (m_closed)
+            return false;
+        m_items.emplace_back(std::move(item));
+        m_not_empty.notify_one();
+        return true;
+    }
+
+    /// Take an item (block while the queue is empty and not closed)
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_not_empty.wait(
+            lock
+          , [this]()
+            {
+                return m_closed || !m_items.empty();
+            }
+          );
+        if (m_items.empty())
+            return false;
+        item = std::move(m_items.front());
+        m_items.pop_front();
+        m_not_full.notify_one();
+        return true;
+    }
+
+    /// No more items will be added
+    void close()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_closed = true;
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+    }
+
+private:
+    std::deque<T> m_items;
+    std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    const std::size_t m_capacity;
+    bool m_closed = {false};
+};
+
+}}}                                                         // namespace details, index, kate
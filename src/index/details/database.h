@@ -28,6 +28,9 @@
 #pragma once
 
 // Project specific includes
+#include "../freshness_manifest.h"
+#include "../include_graph.h"
+#include "../indexing_profile.h"
 #include "../types.h"
 #include "../../header_files_cache.h"
 
@@ -51,15 +54,39 @@ public:
     {
         return m_files_cache;
     }
+    /// Access indexed files state (immutable)
+    const freshness_manifest& files_manifest() const
+    {
+        return m_manifest;
+    }
+    /// Access include edges between indexed files (immutable)
+    const include_graph& includes() const
+    {
+        return m_includes;
+    }
     /// Get (short) database ID
     dbid id() const
     {
         return m_id;
     }
+    /// Check if DB has declarations only (references are not indexed yet)
+    bool is_declarations_only() const
+    {
+        return m_declarations_only;
+    }
+    /// Get indexing profile the DB was built w/ (\c indexing_profile::last__ if unknown)
+    indexing_profile profile() const
+    {
+        return m_profile;
+    }
 
 protected:
     HeaderFilesCache m_files_cache;
+    freshness_manifest m_manifest;
+    include_graph m_includes;
     dbid m_id;
+    bool m_declarations_only = {false};
+    indexing_profile m_profile = {indexing_profile::last__};
 };
 
 }}}                                                         // namespace details, index, kate
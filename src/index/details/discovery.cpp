@@ -0,0 +1,79 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::discovery (implementation)
+ *
+ * \date Fri Oct 16 20:41:26 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "discovery.h"
+#include "../indexer.h"
+
+// Standard includes
+#include <KDE/KDebug>
+
+namespace kate { namespace index { namespace details {
+
+discovery::discovery(indexer* const parent)
+  : m_indexer{parent}
+  , m_scanner{parent->m_excluded_directories}
+{
+}
+
+void discovery::request_cancel()
+{
+    m_scanner.cancel();
+}
+
+void discovery::process()
+{
+    kDebug(DEBUG_AREA) << "Targets discovery thread has started";
+    m_indexer->prepare();
+    Q_EMIT(prepared());
+
+    auto targets = std::vector<QString>{};
+    targets.reserve(m_indexer->m_targets.size());
+    for (const auto& target : m_indexer->m_targets)
+        targets.emplace_back(target.toLocalFile());
+
+    auto count = 0u;
+    for (const auto& filename : m_scanner.scan(targets, m_indexer->m_jobs))
+    {
+        // NOTE Files from a compilation database are in the work list already
+        // (unless it is a partial update)
+        const auto is_scheduled = !m_indexer->m_partial
+          && m_indexer->m_compile_commands.find(filename) != end(m_indexer->m_compile_commands);
+        if (is_scheduled)
+            continue;
+        m_indexer->m_targets_queue.push(filename);
+        ++count;
+    }
+    m_indexer->m_total_files += count;
+    // Let workers finish when the work list is empty
+    m_indexer->m_targets_queue.task_done();
+
+    Q_EMIT(finished());
+    kDebug(DEBUG_AREA) << "Targets discovery thread has finished:" << count << "files found";
+}
+
+}}}                                                         // namespace details, index, kate
@@ -0,0 +1,78 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::discovery (interface)
+ *
+ * \date Fri Oct 16 20:41:26 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "targets_scanner.h"
+
+// Standard includes
+#include <QtCore/QObject>
+
+namespace kate { namespace index {
+
+// fwd decls
+class indexer;
+
+namespace details {
+
+/**
+ * \brief Worker class to find source files in indexer targets
+ *
+ * Runs in a dedicated thread while parsing workers already busy w/ files
+ * from a compilation database (if any). When done, all found files are
+ * added to the indexer's work list at once, so total amount of work is
+ * known since that moment.
+ *
+ * Before that, it prepares the indexer's DB for an incremental update
+ * (see \c indexer::prepare()) and schedules files from a compilation
+ * database, so the GUI thread is not blocked by a DB scan.
+ *
+ * \internal Only \c kate::index::indexer can create instances of this class.
+ *
+ */
+class discovery : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit discovery(indexer*);
+
+public Q_SLOTS:
+    void process();
+    void request_cancel();
+
+Q_SIGNALS:
+    void prepared();
+    void finished();
+
+private:
+    indexer* const m_indexer;
+    targets_scanner m_scanner;
+};
+
+}}}                                                         // namespace details, index, kate
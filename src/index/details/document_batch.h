@@ -0,0 +1,82 @@
+/**
+ * \file
+ *
+ * \brief Struct \c kate::index::details::document_batch (interface)
+ *
+ * \date Fri Oct 16 12:34:52 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "../document.h"
+#include "../freshness_manifest.h"
+#include "../include_graph.h"
+#include "../xref_table.h"
+
+// Standard includes
+#include <QtCore/QString>
+#include <xapian.h>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace kate { namespace index { namespace details {
+class shard;                                                // fwd decl
+
+/**
+ * \brief Documents produced by a single translation unit
+ *
+ * Document IDs are allocated by a parsing worker (to be able to refer
+ * containers before the document is actually stored), so the writer
+ * just places every document at its ID.
+ *
+ * References are not documents: they are collected by the writer into
+ * a \c xref_table, where references located in the TU main file
+ * replace previous ones.
+ *
+ * Documents stored by a worker to its own shard are not in a batch, but
+ * the batch tells what shard commit makes them safe.
+ */
+struct document_batch
+{
+    typedef std::pair<Xapian::docid, document> value_type;
+
+    QString m_main_file;                                    ///< TU this batch was produced from
+    std::vector<value_type> m_documents;                    ///< Documents to write
+    std::vector<xref_table_builder::value_type> m_references;
+    std::vector<include_edge> m_includes;                   ///< \c #include directives met in the TU
+    std::vector<std::pair<fileid, Xapian::docid>> m_header_documents; ///< Documents located in headers
+    fileid m_main_file_id = {0};
+    file_state m_state;                                     ///< State of the TU file
+    const shard* m_shard = {nullptr};                       ///< Shard w/ documents of the TU (if any)
+    Xapian::docid m_shard_docid = {0};                      ///< The last document ID allocated in the shard
+    bool m_unchanged = {false};                             ///< TU is up to date, nothing to write
+};
+
+/// Rough estimation of a memory occupied by a document in a Xapian changeset
+inline std::size_t approximate_size(const Xapian::Document& doc)
+{
+    return doc.termlist_count() * 24 + doc.values_count() * 32;
+}
+
+}}}                                                         // namespace details, index, kate
@@ -0,0 +1,233 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::document_builder (implementation)
+ *
+ * \date Fri Oct 16 19:42:06 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Project specific includes
+#include "document_builder.h"
+
+// Standard includes
+#include <array>
+#include <cassert>
+
+namespace kate { namespace index { namespace details { namespace {
+
+/// Terms and values shared by all documents
+struct constants
+{
+    std::array<std::string, std::size_t(kind::last__)> m_kind_terms;
+    std::array<std::string, std::size_t(kind::last__)> m_kind_values;
+    std::array<std::string, std::size_t(document_builder::flag::last__)> m_flag_terms;
+    std::array<std::string, CX_CXXPrivate + 1> m_access_terms;
+    std::array<std::string, CX_CXXPrivate + 1> m_access_values;
+    std::array<std::string, CXIdxEntity_TemplateSpecialization + 1> m_template_terms;
+    std::array<std::string, CXIdxEntity_TemplateSpecialization + 1> m_template_values;
+
+    constants()
+    {
+        const auto add_kind = [this](const kind k, const char* const suffix)
+        {
+            m_kind_terms[std::size_t(k)] = term::XKIND + suffix;
+            m_kind_values[std::size_t(k)] = serialize(k);
+        };
+        add_kind(kind::NAMESPACE, "ns");
+        add_kind(kind::NAMESPACE_ALIAS, "ns-alias");
+        add_kind(kind::TYPEDEF, "typedef");
+        add_kind(kind::TYPE_ALIAS, "type-alias");
+        add_kind(kind::STRUCT, "struct");
+        add_kind(kind::CLASS, "class");
+        add_kind(kind::UNION, "union");
+        add_kind(kind::ENUM, "enum");
+        add_kind(kind::ENUM_CONSTANT, "enum-const");
+        add_kind(kind::VARIABLE, "var");
+        add_kind(kind::PARAMETER, "param");
+        add_kind(kind::FIELD, "field");
+        add_kind(kind::BITFIELD, "bitfield");
+        add_kind(kind::FUNCTION, "fn");
+        add_kind(kind::METHOD, "method");
+        add_kind(kind::CONSTRUCTOR, "ctor");
+        add_kind(kind::DESTRUCTOR, "dtor");
+        add_kind(kind::CONVERSTION, "conversion");
+
+        using flag = document_builder::flag;
+        m_flag_terms[std::size_t(flag::ANONYMOUS)] = term::XANONYMOUS + "y";
+        m_flag_terms[std::size_t(flag::IMPLICIT)] = term::XIMPLICIT + "y";
+        m_flag_terms[std::size_t(flag::POD)] = term::XPOD + "y";
+        m_flag_terms[std::size_t(flag::REDECLARATION)] = term::XREDECLARATION + "y";
+        m_flag_terms[std::size_t(flag::STATIC)] = term::XSTATIC + "y";
+        m_flag_terms[std::size_t(flag::VIRTUAL)] = term::XVIRTUAL + "y";
+
+        m_access_terms[CX_CXXPublic] = term::XACCESS + "public";
+        m_access_terms[CX_CXXProtected] = term::XACCESS + "protected";
+        m_access_terms[CX_CXXPrivate] = term::XACCESS + "private";
+        for (const auto access : {CX_CXXPublic, CX_CXXProtected, CX_CXXPrivate})
+            m_access_values[access] = serialize(unsigned(access));
+
+        m_template_terms[CXIdxEntity_Template] = term::XTEMPLATE + "y";
+        m_template_terms[CXIdxEntity_TemplatePartialSpecialization] = term::XTEMPLATE + "ps";
+        m_template_terms[CXIdxEntity_TemplateSpecialization] = term::XTEMPLATE + "fs";
+        for (const auto tk : {
+                CXIdxEntity_Template
+              , CXIdxEntity_TemplatePartialSpecialization
+              , CXIdxEntity_TemplateSpecialization
+              })
+            m_template_values[tk] = serialize(unsigned(tk));
+    }
+};
+
+/**
+ * \note Term prefixes are global objects defined in another translation unit,
+ * so constants are composed on first use (not at static initialization time).
+ */
+const constants& get_constants()
+{
+    static const constants s_constants;
+    return s_constants;
+}
+
+}                                                           // anonymous namespace
+
+document_builder::document_builder(const std::size_t capacity)
+{
+    m_name.reserve(capacity);
+    m_lower.reserve(capacity);
+    m_term.reserve(capacity);
+    m_value.reserve(capacity);
+}
+
+/**
+ * The same as the following, but \c name gets lowercased only once:
+ * \code
+ *  doc.add_term(boost::to_lower_copy(name));
+ *  doc.add_boolean_term(prefix, name);
+ * \endcode
+ */
+void document_builder::add_name_terms(document& doc, const std::string& prefix, const std::string& name)
+{
+    to_lower(name, m_lower);
+    doc.add_term(m_lower);
+
+    m_term.assign(prefix);
+    if ('A' <= name[0] && name[0] <= 'Z')
+        m_term.push_back(':');
+    m_term.append(name);
+    doc.add_boolean_term(m_term);
+
+    m_term.assign(prefix);
+    m_term.append(m_lower);
+    doc.add_boolean_term(m_term);
+}
+
+void document_builder::add_boolean_term(document& doc, const std::string& prefix, const std::string& value)
+{
+    m_term.assign(prefix);
+    if ('A' <= value[0] && value[0] <= 'Z')
+        m_term.push_back(':');
+    m_term.append(value);
+    doc.add_boolean_term(m_term);
+
+    to_lower(value, m_lower);
+    m_term.assign(prefix);
+    m_term.append(m_lower);
+    doc.add_boolean_term(m_term);
+}
+
+void document_builder::add_value(document& doc, const value_slot slot, const char* const value)
+{
+    m_value.assign(value);
+    doc.add_value(slot, m_value);
+}
+
+void document_builder::add_kind(document& doc, const kind k)
+{
+    assert("Sanity check" && k != kind::UNEXPOSED && k < kind::last__);
+    const auto& c = get_constants();
+    doc.add_boolean_term(c.m_kind_terms[std::size_t(k)]);
+    doc.add_value(value_slot::KIND, c.m_kind_values[std::size_t(k)]);
+}
+
+void document_builder::add_kind_term(document& doc, const kind k)
+{
+    assert("Sanity check" && k != kind::UNEXPOSED && k < kind::last__);
+    doc.add_boolean_term(get_constants().m_kind_terms[std::size_t(k)]);
+}
+
+void document_builder::add_flag(document& doc, const flag f)
+{
+    assert("Sanity check" && f < flag::last__);
+    doc.add_boolean_term(get_constants().m_flag_terms[std::size_t(f)]);
+}
+
+/// \note Invalid access specifier is ignored
+void document_builder::add_access(document& doc, const CX_CXXAccessSpecifier access)
+{
+    switch (access)
+    {
+        case CX_CXXPublic:
+        case CX_CXXProtected:
+        case CX_CXXPrivate:
+        {
+            const auto& c = get_constants();
+            doc.add_boolean_term(c.m_access_terms[access]);
+            doc.add_value(value_slot::ACCESS, c.m_access_values[access]);
+            break;
+        }
+        case CX_CXXInvalidAccessSpecifier:
+        default:
+            break;
+    }
+}
+
+/// \note Non template entities are ignored
+void document_builder::add_template_kind(document& doc, const CXIdxEntityCXXTemplateKind template_kind)
+{
+    switch (template_kind)
+    {
+        case CXIdxEntity_Template:
+        case CXIdxEntity_TemplatePartialSpecialization:
+        case CXIdxEntity_TemplateSpecialization:
+        {
+            const auto& c = get_constants();
+            doc.add_boolean_term(c.m_template_terms[template_kind]);
+            doc.add_value(value_slot::TEMPLATE, c.m_template_values[template_kind]);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/// \note Empty (or absent) USR is ignored
+void document_builder::add_usr(document& doc, const char* const usr)
+{
+    if (!usr || !*usr)
+        return;
+    make_usr_term(usr, m_term);
+    doc.add_boolean_term(m_term);
+    add_value(doc, value_slot::USR, usr);
+}
+
+}}}                                                         // namespace details, index, kate
@@ -0,0 +1,126 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::document_builder (interface)
+ *
+ * \date Fri Oct 16 19:42:06 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+// Project specific includes
+#include "../document.h"
+#include "../kind.h"
+
+// Standard includes
+#include <clang-c/Index.h>
+#include <cstddef>
+#include <string>
+
+namespace kate { namespace index { namespace details {
+
+/**
+ * \brief Helper to fill documents w/ terms and values w/o temporary strings
+ *
+ * Every worker has its own instance. Terms are composed in scratch buffers
+ * reserved once, and then passed to \c Xapian::Document, which makes its
+ * own copy anyway. Terms and values which are the same for many documents
+ * (kind, access, flags) are composed and serialized only once per process.
+ *
+ * Lowercasing has an ASCII fast path: bytes out of ASCII range (i.e. parts of
+ * UTF-8 sequences) are left as is, just like \c boost::to_lower_copy does in
+ * the default "C" locale.
+ *
+ * \note Produces exactly the same terms as \c document::add_boolean_term()
+ * and friends, so search queries are not affected.
+ */
+class document_builder
+{
+public:
+    /// Boolean flags attached to a document as \c <prefix>y terms
+    enum class flag
+    {
+        ANONYMOUS
+      , IMPLICIT
+      , POD
+      , REDECLARATION
+      , STATIC
+      , VIRTUAL
+      , last__
+    };
+
+    /// Reserve scratch buffers
+    explicit document_builder(std::size_t = 256);
+
+    /// Add a plain lowercased term and \c prefix'ed ones for a given name
+    void add_name_terms(document&, const std::string&, const std::string&);
+    /// Same as \c document::add_boolean_term(), but w/o temporaries
+    void add_boolean_term(document&, const std::string&, const std::string&);
+    /// Add a \c NUL terminated string as a value w/o a temporary string
+    void add_value(document&, value_slot, const char*);
+    /// Add a term and a value for a given kind
+    void add_kind(document&, kind);
+    /// Add a term for a given kind only (e.g. \c fn for methods)
+    void add_kind_term(document&, kind);
+    /// Add a flag term
+    void add_flag(document&, flag);
+    /// Add a term and a value for a given access specifier
+    void add_access(document&, CX_CXXAccessSpecifier);
+    /// Add a term and a value for a given template kind
+    void add_template_kind(document&, CXIdxEntityCXXTemplateKind);
+    /// Add a term and a value for an entity USR
+    void add_usr(document&, const char*);
+
+    /// Get a scratch string to hold a (modifiable) entity name
+    std::string& name(const char*);
+
+    /// Lowercase an ASCII string into a given buffer
+    static void to_lower(const std::string&, std::string&);
+
+private:
+    std::string m_name;
+    std::string m_lower;
+    std::string m_term;
+    std::string m_value;
+};
+
+inline std::string& document_builder::name(const char* const str)
+{
+    if (str)
+        m_name.assign(str);
+    else
+        m_name.clear();
+    return m_name;
+}
+
+inline void document_builder::to_lower(const std::string& str, std::string& result)
+{
+    result.resize(str.size());
+    for (auto i = std::size_t{}; i < str.size(); ++i)
+    {
+        const auto c = str[i];
+        result[i] = ('A' <= c && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+    }
+}
+
+}}}                                                         // namespace details, index, kate
@@ -0,0 +1,149 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::location_set (interface)
+ *
+ * \date Fri Oct 16 18:11:52 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "../types.h"
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace kate { namespace index { namespace details {
+
+/**
+ * \brief Compact set of source locations (file ID, line, column)
+ *
+ * Open addressing hash set w/ linear probing. Every location takes
+ * 12 bytes (w/ load factor not greater than 3/4), comparing to ~48 bytes
+ * per node of \c std::set plus allocator overhead.
+ *
+ * \note Empty slots are marked w/ a file ID never assigned by
+ * \c HeaderFilesCache, so any valid location can be stored.
+ */
+class location_set
+{
+public:
+    explicit location_set(const std::size_t initial_capacity = 1024)
+    {
+        auto capacity = std::size_t(16);
+        while (capacity < initial_capacity)
+            capacity <<= 1;
+        m_slots.resize(capacity);
+    }
+
+    /// Add a location, return \c false if it was already here
+    bool insert(const fileid file, const unsigned line, const unsigned column)
+    {
+        if ((m_size + 1) * 4 > m_slots.size() * 3)
+            rehash(m_slots.size() * 2);
+        auto& slot = find_slot(m_slots, file, line, column);
+        if (slot.m_file != EMPTY)
+            return false;
+        slot = {file, line, column};
+        ++m_size;
+        return true;
+    }
+
+    bool contains(const fileid file, const unsigned line, const unsigned column) const
+    {
+        const auto& slot = find_slot(m_slots, file, line, column);
+        return slot.m_file != EMPTY;
+    }
+
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /// Bytes occupied by the table
+    std::size_t memory_usage() const
+    {
+        return m_slots.capacity() * sizeof(entry);
+    }
+
+    /// Remove all locations (capacity remains the same)
+    void clear()
+    {
+        for (auto& slot : m_slots)
+            slot.m_file = EMPTY;
+        m_size = 0;
+    }
+
+private:
+    static constexpr fileid EMPTY = std::numeric_limits<fileid>::max();
+
+    struct entry
+    {
+        fileid m_file = {EMPTY};
+        std::uint32_t m_line = {0};
+        std::uint32_t m_column = {0};
+    };
+
+    static std::size_t hash(const fileid file, const unsigned line, const unsigned column)
+    {
+        // NOTE Mix all parts into a 64-bit value, then scramble it (MurmurHash3 finalizer)
+        auto h = (std::uint64_t(file) << 32) ^ (std::uint64_t(line) << 12) ^ column;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return std::size_t(h);
+    }
+
+    /// Find a slot w/ a given location or an empty one where it should be placed
+    template <typename Slots>
+    static auto find_slot(Slots& slots, const fileid file, const unsigned line, const unsigned column)
+      -> decltype(slots[0])
+    {
+        const auto mask = slots.size() - 1;
+        for (auto i = hash(file, line, column) & mask;; i = (i + 1) & mask)
+        {
+            auto& slot = slots[i];
+            if (slot.m_file == EMPTY || (slot.m_file == file && slot.m_line == line && slot.m_column == column))
+                return slot;
+        }
+    }
+
+    void rehash(const std::size_t capacity)
+    {
+        auto slots = std::vector<entry>(capacity);
+        for (const auto& e : m_slots)
+            if (e.m_file != EMPTY)
+                find_slot(slots, e.m_file, e.m_line, e.m_column) = e;
+        m_slots.swap(slots);
+    }
+
+    std::vector<entry> m_slots;
+    std::size_t m_size = {0};
+};
+
+}}}                                                         // namespace details, index, kate
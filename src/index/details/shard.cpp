@@ -0,0 +1,114 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::shard (implementation)
+ *
+ * \date Fri Oct 16 22:31:47 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "shard.h"
+#include "../database.h"
+
+// Standard includes
+#include <KDE/KDebug>
+
+namespace kate { namespace index { namespace details {
+
+/**
+ * \param[in] path a DB to create (must not exist)
+ * \param[in] first the first document ID of the range
+ * \param[in] last the last document ID of the range
+ * \param[in] documents commit threshold in documents (\c 0 means no limit)
+ * \param[in] bytes approximate commit threshold in bytes (\c 0 means no limit)
+ */
+shard::shard(
+    const std::string& path
+  , const Xapian::docid first
+  , const Xapian::docid last
+  , const std::size_t documents
+  , const std::size_t bytes
+  ) try
+  : m_db{path, Xapian::DB_CREATE}
+  , m_path{path}
+  , m_next_docid{first}
+  , m_last_docid{last}
+  , m_commit_documents{documents}
+  , m_commit_bytes{bytes}
+  , m_committed_docid{first - 1}
+{
+}
+catch (const Xapian::DatabaseError& e)
+{
+    throw exception::database_failure{"Index database [" + path + "] failure: " + e.get_msg()};
+}
+
+Xapian::docid shard::allocate_docid()
+{
+    if (m_next_docid > m_last_docid || !m_next_docid)
+    {
+        kDebug(DEBUG_AREA) << "Document IDs range of a shard exhausted:" << m_path.c_str();
+        return 0;
+    }
+    return m_next_docid++;
+}
+
+void shard::store(std::vector<document_batch::value_type>& documents)
+{
+    for (auto& p : documents)
+    {
+        m_db.replace_document(p.first, p.second);
+        m_uncommitted_bytes += approximate_size(p.second);
+    }
+    m_uncommitted_documents += documents.size();
+    documents.clear();
+
+    const auto need_commit = (m_commit_documents && m_commit_documents <= m_uncommitted_documents)
+      || (m_commit_bytes && m_commit_bytes <= m_uncommitted_bytes)
+      ;
+    if (need_commit)
+        commit();
+}
+
+void shard::commit()
+{
+    try
+    {
+        m_db.commit();
+        m_committed_docid = last_docid();
+    }
+    catch (const Xapian::DatabaseError& e)
+    {
+        /// \todo Handle errors (some of them are recoverable...)
+        kDebug(DEBUG_AREA) << "Fail to commit shard" << m_path.c_str() << ":" << e.get_msg().c_str();
+    }
+    m_uncommitted_documents = 0;
+    m_uncommitted_bytes = 0;
+}
+
+void shard::close()
+{
+    commit();
+    m_db.close();
+}
+
+}}}                                                         // namespace details, index, kate
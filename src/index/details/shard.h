@@ -0,0 +1,98 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::shard (interface)
+ *
+ * \date Fri Oct 16 22:31:47 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "document_batch.h"
+
+// Standard includes
+#include <xapian.h>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace kate { namespace index { namespace details {
+
+/**
+ * \brief A DB written by a single parsing worker
+ *
+ * When a fresh index is built by few workers, every worker writes documents
+ * to its own shard, so workers don't wait for the only writer. Every shard
+ * allocates document IDs from its own range, so the indexer can merge shards
+ * w/ \c Xapian::Compactor w/o renumbering, when all targets are done.
+ *
+ * Document IDs are allocated in ascending order, so the last committed ID
+ * tells what documents are safe in a shard (see \c committed_docid()).
+ *
+ * \note Not thread-safe (except \c committed_docid()): a shard is used by
+ * the only worker at a time.
+ */
+class shard
+{
+public:
+    /// Make a new DB at the given path w/ document IDs in a range <tt>[first, last]</tt>
+    shard(const std::string&, Xapian::docid, Xapian::docid, std::size_t, std::size_t);
+
+    /// Allocate a document ID, \c 0 if the range is exhausted
+    Xapian::docid allocate_docid();
+    /// Get the last allocated document ID
+    Xapian::docid last_docid() const
+    {
+        return m_next_docid - 1;
+    }
+    /// Get the last allocated document ID at the moment of the last successful commit
+    Xapian::docid committed_docid() const
+    {
+        return m_committed_docid;
+    }
+    /// Write documents (the given container will be empty)
+    void store(std::vector<document_batch::value_type>&);
+    /// Commit recent changes
+    void commit();
+    /// Commit recent changes and close the DB
+    void close();
+
+    const std::string& path() const
+    {
+        return m_path;
+    }
+
+private:
+    Xapian::WritableDatabase m_db;
+    const std::string m_path;
+    Xapian::docid m_next_docid;
+    const Xapian::docid m_last_docid;
+    const std::size_t m_commit_documents;
+    const std::size_t m_commit_bytes;
+    std::size_t m_uncommitted_documents = {0};
+    std::size_t m_uncommitted_bytes = {0};
+    std::atomic<Xapian::docid> m_committed_docid;
+};
+
+}}}                                                         // namespace details, index, kate
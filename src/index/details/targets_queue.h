@@ -0,0 +1,125 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::targets_queue (interface)
+ *
+ * \date Fri Oct 16 12:21:07 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+
+// Standard includes
+#include <QtCore/QString>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace kate { namespace index { namespace details {
+
+/**
+ * \brief A work list of indexing targets shared by all workers
+ *
+ * The work list can grow while processing (e.g. files found by a discovery
+ * stage are added while workers parse files from a compilation database,
+ * or subdirectories are pushed by \c targets_scanner threads walking a
+ * directory). Because of that an empty queue doesn't mean the job is done:
+ * \c pop() returns \c false only when the queue is empty \b and no one
+ * is busy w/ a target (which may produce more) or holds the queue,
+ * or when processing has been cancelled.
+ *
+ * Every successful \c pop() must be paired w/ a \c task_done() call.
+ */
+class targets_queue
+{
+public:
+    /// Add a target to process
+    void push(const QString& target)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_targets.emplace_back(target);
+        m_cv.notify_one();
+    }
+
+    /// Get a next target to process
+    bool pop(QString& target)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_cv.wait(
+            lock
+          , [this]()
+            {
+                return m_cancelled || !m_targets.empty() || !m_busy;
+            }
+          );
+        if (m_cancelled || m_targets.empty())
+            return false;
+        target = std::move(m_targets.front());
+        m_targets.pop_front();
+        ++m_busy;
+        return true;
+    }
+
+    /// Notify that a target obtained by \c pop() has been processed
+    void task_done()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        --m_busy;
+        if (!m_busy && m_targets.empty())
+            m_cv.notify_all();
+    }
+
+    /**
+     * Do not let workers finish, even if the queue is empty, cuz more
+     * targets are expected. Must be paired w/ a \c task_done() call.
+     */
+    void hold()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_busy;
+    }
+
+    /// Drop all pending targets and wake up waiting workers
+    void cancel()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_cancelled = true;
+        m_targets.clear();
+        m_cv.notify_all();
+    }
+
+    bool is_cancelled()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_cancelled;
+    }
+
+private:
+    std::deque<QString> m_targets;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    unsigned m_busy = {0};
+    bool m_cancelled = {false};
+};
+
+}}}                                                         // namespace details, index, kate
@@ -0,0 +1,219 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::targets_scanner (implementation)
+ *
+ * \date Fri Oct 16 20:14:09 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "targets_scanner.h"
+#include "../../utils.h"
+
+// Standard includes
+#include <KDE/KDebug>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFileInfo>
+#include <QtCore/QThread>
+#include <algorithm>
+#include <thread>
+
+namespace kate { namespace index { namespace details { namespace {
+
+/// Suffixes of C/C++ sources and headers (case sensitive, cuz \c .C is C++)
+const std::set<QString> SOURCE_SUFFIXES = {
+    "c", "cc", "cp", "cpp", "cxx", "c++", "C", "CPP"
+  , "h", "hh", "hp", "hpp", "hxx", "h++", "H", "HPP"
+  , "inl", "ipp", "tcc", "txx"
+};
+
+/// Directories never contain anything interesting
+const std::set<QString> ALWAYS_EXCLUDED_DIRECTORIES = {
+    ".bzr", ".git", ".hg", ".svn", "CVS", "CMakeFiles"
+};
+
+/// A file to recognize a CMake build directory
+const QString CMAKE_CACHE_FILE = "CMakeCache.txt";
+
+}                                                           // anonymous namespace
+
+/**
+ * \param[in] excluded wildcards to match names of directories to be skipped
+ */
+targets_scanner::targets_scanner(const QStringList& excluded)
+  : m_is_cancelled{false}
+{
+    for (const auto& pattern : excluded)
+        if (!pattern.isEmpty())
+            m_excluded << pattern;
+}
+
+/**
+ * \param[in] targets files and directories to scan
+ * \param[in] jobs number of threads to walk directories (\c 0 means
+ * to use as many threads as CPU cores available)
+ */
+std::vector<QString> targets_scanner::scan(const std::vector<QString>& targets, const unsigned jobs)
+{
+    for (const auto& target : targets)
+    {
+        const auto fi = QFileInfo{target};
+        if (fi.isDir())
+        {
+            if (claim_directory(fi.canonicalFilePath()))
+                m_directories.push(fi.canonicalFilePath());
+        }
+        else if (fi.isFile() && is_source_file(fi))
+            m_files.emplace_back(fi.canonicalFilePath());
+        else
+            kDebug(DEBUG_AREA) << target << "is not a suitable file or directory!";
+    }
+
+    {
+        const auto threads_count = jobs ? jobs : unsigned(std::max(QThread::idealThreadCount(), 1));
+        auto threads = std::vector<std::thread>{};
+        threads.reserve(threads_count);
+        for (auto i = 0u; i < threads_count; ++i)
+            threads.emplace_back(&targets_scanner::process_directories, this);
+        for (auto& t : threads)
+            t.join();
+    }
+
+    auto result = std::vector<QString>{};
+    if (m_is_cancelled)
+        return result;
+    result.swap(m_files);
+    std::sort(begin(result), end(result));
+    result.erase(std::unique(begin(result), end(result)), end(result));
+    kDebug(DEBUG_AREA) << "Found" << result.size() << "source files in" << m_seen_directories.size() << "directories";
+    return result;
+}
+
+void targets_scanner::cancel()
+{
+    m_is_cancelled = true;
+    m_directories.cancel();
+}
+
+/**
+ * Check if a directory should not be walked into: it is a well known
+ * directory w/ some metadata (VCS, CMake), a build directory, or its name
+ * matches to any of user specified patterns.
+ */
+bool targets_scanner::is_excluded_directory(
+    const QFileInfo& fi
+  , const std::vector<QRegExp>& excluded
+  ) const
+{
+    const auto& name = fi.fileName();
+    if (ALWAYS_EXCLUDED_DIRECTORIES.find(name) != end(ALWAYS_EXCLUDED_DIRECTORIES))
+        return true;
+    for (const auto& re : excluded)
+        if (re.exactMatch(name))
+            return true;
+    return QFileInfo{QDir{fi.filePath()}, CMAKE_CACHE_FILE}.exists();
+}
+
+bool targets_scanner::is_source_suffix(const QString& suffix)
+{
+    return SOURCE_SUFFIXES.find(suffix) != end(SOURCE_SUFFIXES);
+}
+
+/**
+ * Files w/ a suffix classified by the suffix only, so no expensive
+ * MIME type detection is required for the most files.
+ */
+bool targets_scanner::is_source_file(const QFileInfo& fi) const
+{
+    const auto& suffix = fi.suffix();
+    if (!suffix.isEmpty())
+        return is_source_suffix(suffix);
+    return kate::isLookLikeCppSource(fi);
+}
+
+/// Check if a directory hasn't been visited yet (e.g. via a symlink)
+bool targets_scanner::claim_directory(const QString& canonical_path)
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_seen_directories.insert(canonical_path).second;
+}
+
+void targets_scanner::process_directories()
+{
+    // NOTE Patterns are compiled per thread, cuz QRegExp is not thread-safe
+    auto excluded = std::vector<QRegExp>{};
+    for (const auto& pattern : m_excluded)
+        excluded.emplace_back(pattern, Qt::CaseSensitive, QRegExp::Wildcard);
+
+    auto files = std::vector<QString>{};
+    auto directory = QString{};
+    while (m_directories.pop(directory))
+    {
+        handle_directory(directory, excluded, files);
+        m_directories.task_done();
+    }
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_files.insert(end(m_files), begin(files), end(files));
+}
+
+void targets_scanner::handle_directory(
+    const QString& directory
+  , const std::vector<QRegExp>& excluded
+  , std::vector<QString>& files
+  )
+{
+    for (
+        QDirIterator dir_it = {
+            directory
+          , QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::CaseSensitive
+          }
+      ; dir_it.hasNext() && !m_is_cancelled
+      ;
+      )
+    {
+        dir_it.next();
+        const auto& fi = dir_it.fileInfo();
+        if (fi.isDir())
+        {
+            if (is_excluded_directory(fi, excluded))
+            {
+                kDebug(DEBUG_AREA) << "Skip excluded directory" << fi.filePath();
+                continue;
+            }
+            const auto& canonical_path = fi.canonicalFilePath();
+            // Let other threads to walk into subdirectories
+            if (!canonical_path.isEmpty() && claim_directory(canonical_path))
+                m_directories.push(canonical_path);
+        }
+        else if (is_source_file(fi))
+        {
+            // NOTE Directories are walked by canonical paths, so only
+            // symlinks have to be resolved. Duplicates are removed at the end.
+            const auto& canonical_path = fi.isSymLink() ? fi.canonicalFilePath() : fi.absoluteFilePath();
+            if (!canonical_path.isEmpty())
+                files.emplace_back(canonical_path);
+        }
+    }
+}
+
+}}}                                                         // namespace details, index, kate
@@ -0,0 +1,90 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::targets_scanner (interface)
+ *
+ * \date Fri Oct 16 20:14:09 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "targets_queue.h"
+
+// Standard includes
+#include <QtCore/QRegExp>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <vector>
+
+// fwd decls
+class QFileInfo;
+
+namespace kate { namespace index { namespace details {
+
+/**
+ * \brief Find source files to index in a given set of targets
+ *
+ * Directories are walked by a few threads in parallel. Files are classified
+ * by a name suffix, and only files w/o a suffix (like STL headers) need
+ * a content check. Directories which never contain sources to index
+ * (VCS metadata, CMake build trees) are pruned, as well as ones matched
+ * to user specified wildcards. Symlinked files and directories met
+ * few times are visited once.
+ *
+ * \note \c QRegExp is not thread-safe (it keeps a state of the last match),
+ * so every thread matches directories w/ its own copy of wildcards.
+ *
+ * \note Exclusion rules apply only to directories met while walking,
+ * explicitly given targets are always scanned.
+ */
+class targets_scanner
+{
+public:
+    explicit targets_scanner(const QStringList& = QStringList{});
+
+    /// Get a sorted list of (canonical) source files found in given targets
+    std::vector<QString> scan(const std::vector<QString>&, unsigned = 0);
+    /// Stop scanning (can be called from any thread)
+    void cancel();
+
+    static bool is_source_suffix(const QString&);
+
+private:
+    void process_directories();
+    void handle_directory(const QString&, const std::vector<QRegExp>&, std::vector<QString>&);
+    bool is_excluded_directory(const QFileInfo&, const std::vector<QRegExp>&) const;
+    bool is_source_file(const QFileInfo&) const;
+    bool claim_directory(const QString&);
+
+    QStringList m_excluded;                                 ///< Wildcards to match excluded directories
+    targets_queue m_directories;
+    std::mutex m_mutex;
+    std::set<QString> m_seen_directories;                   ///< Canonical paths of visited directories
+    std::vector<QString> m_files;
+    std::atomic<bool> m_is_cancelled;
+};
+
+}}}                                                         // namespace details, index, kate
@@ -0,0 +1,63 @@
+/**
+ * \file
+ *
+ * \brief Variable length integers encoding (shared by on-disk tables)
+ *
+ * \date Sat Oct 17 03:05:19 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+
+// Standard includes
+#include <cstdint>
+#include <string>
+
+namespace kate { namespace index { namespace details {
+
+/// Append a value as 7-bit groups, the least significant first
+inline void put_varint(std::string& out, std::uint64_t value)
+{
+    while (0x80 <= value)
+    {
+        out.push_back(char((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+/// Read a value, return \c false if data ends unexpectedly
+inline bool get_varint(const unsigned char*& pos, const unsigned char* const last, std::uint64_t& value)
+{
+    value = 0;
+    for (auto shift = 0u; pos != last && shift < 64; shift += 7)
+    {
+        const auto byte = *pos++;
+        value |= std::uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+}}}                                                         // namespace details, index, kate
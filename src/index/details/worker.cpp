@@ -27,6 +27,7 @@
 
 // Project specific includes
 #include "worker.h"
+#include "shard.h"
 #include "../document_extras.h"
 #include "../document.h"
 #include "../indexer.h"
@@ -34,32 +35,72 @@
 #include "../../clang/kind_of.h"
 #include "../../clang/to_string.h"
 #include "../../string_cast.h"
-#include "../../utils.h"
 
 // Standard includes
 #include <boost/algorithm/string.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/serialization/list.hpp>
 #include <boost/serialization/string.hpp>
-#include <KDE/KUrl>
 #include <KDE/KDebug>
 #include <KDE/KLocalizedString>
-#include <QtCore/QCoreApplication>
 #include <QtCore/QFileInfo>
-#include <QtCore/QDirIterator>
 #include <xapian.h>
+#include <chrono>
+#include <cstdint>
 #include <set>
 
 namespace kate { namespace index { namespace details { namespace {
 
-inline Xapian::termpos make_term_position(const clang::location& loc)
+inline Xapian::termpos make_term_position(const unsigned line, const unsigned column)
 {
-    return loc.line() * 1000 + loc.column();
+    return line * 1000 + column;
+}
+
+/// \name Store file ID as \c CXIdxClientFile (shifted by 1, so it never be \c nullptr)
+//@{
+inline CXIdxClientFile to_client_file(const fileid id)
+{
+    return reinterpret_cast<CXIdxClientFile>(std::uintptr_t(id) + 1);
+}
+
+inline fileid from_client_file(const CXIdxClientFile file)
+{
+    return fileid(reinterpret_cast<std::uintptr_t>(file) - 1);
+}
+//@}
+
+/// Accumulate time spent in a scope
+class scope_timer
+{
+public:
+    explicit scope_timer(std::chrono::steady_clock::duration& total)
+      : m_total(total)
+      , m_start(std::chrono::steady_clock::now())
+    {}
+    ~scope_timer()
+    {
+        m_total += std::chrono::steady_clock::now() - m_start;
+    }
+
+private:
+    std::chrono::steady_clock::duration& m_total;
+    const std::chrono::steady_clock::time_point m_start;
+};
+
+template <typename Duration>
+inline std::uint32_t to_milliseconds(const Duration d)
+{
+    return std::uint32_t(std::chrono::duration_cast<std::chrono::milliseconds>(d).count());
 }
 }                                                           // anonymous namespace
 
-worker::worker(indexer* const parent)
+worker::worker(indexer* const parent, shard* const own_shard)
   : m_indexer{parent}
+  , m_shard{own_shard}
+  , m_index{clang_createIndex(1, 1)}
+  , m_action{clang_IndexAction_create(m_index)}
+  , m_skipped_headers{0}
+  , m_callbacks_time{std::chrono::steady_clock::duration::zero()}
   , m_is_cancelled{false}
 {
 }
@@ -78,9 +119,15 @@ bool worker::is_cancelled() const
 void worker::process()
 {
     kDebug(DEBUG_AREA) << "Indexer thread has started";
-    for (const auto& target : m_indexer->m_targets)
-        if (dispatch_target(target))
-            break;
+    auto target = QString{};
+    while (m_indexer->m_targets_queue.pop(target))
+    {
+        dispatch_target(QFileInfo{target});
+        m_indexer->m_targets_queue.task_done();
+    }
+    if (m_shard)
+        m_shard->commit();
+    m_indexer->m_skipped_headers += m_skipped_headers;
     Q_EMIT(finished());
     kDebug(DEBUG_AREA) << "Indexer thread has finished";
 }
@@ -88,19 +135,69 @@ void worker::process()
 template <typename... ClientArgs>
 inline CXIdxClientContainer worker::update_client_container(ClientArgs&&... args)
 {
-    auto& ptr = *m_containers.emplace(
-        end(m_containers)
-      , new container_info{std::forward<ClientArgs>(args)...}
-      );
-    return CXIdxClientContainer(ptr.get());
+    // NOTE Deque never moves elements on insertion at the end
+    m_containers.emplace_back(std::forward<ClientArgs>(args)...);
+    return CXIdxClientContainer(&m_containers.back());
+}
+
+/**
+ * Check if a TU has been indexed already and not modified since that
+ * (including headers it depends on, see \c indexer::find_outdated_units()).
+ * Hash of the file content will be calculated (and stored to \c state)
+ * only if file attributes are not enough to decide.
+ */
+bool worker::is_up_to_date(const QString& filename, file_state& state) const
+{
+    if (m_indexer->m_outdated_units.find(filename) != end(m_indexer->m_outdated_units))
+        return false;
+    const auto* const prev = m_indexer->m_previous_manifest.find(filename);
+    if (!prev)
+        return false;
+    if (state.has_same_attributes(*prev))
+        return true;
+    if (state.m_size != prev->m_size)
+        return false;
+    return state.update_hash(filename) && state.m_hash == prev->m_hash;
 }
 
-void worker::handle_file(const QString& filename)
+void worker::handle_file(const QString& filename, const QFileInfo& fi)
 {
+    m_batch.m_main_file = filename;
+    m_batch.m_state = file_state::from_file(fi);
+    // NOTE Targets of a partial update depend on saved files, but they may
+    // have no changes on their own, so they are always reparsed
+    if (m_indexer->m_incremental && !m_indexer->m_partial && is_up_to_date(filename, m_batch.m_state))
+    {
+        // Just let the writer know that this file is still here
+        m_batch.m_unchanged = true;
+        m_indexer->m_batches.push(std::move(m_batch));
+        m_batch = document_batch{};
+        return;
+    }
+    if (m_batch.m_state.m_hash.empty())
+        m_batch.m_state.update_hash(filename);
+    m_main_file_id = m_indexer->get_file_id(filename);
+    m_batch.m_main_file_id = m_main_file_id;
+
+    // Prefer options from a compilation database (if file is there)
+    auto options = std::vector<const char*>{};
+    auto it = m_indexer->m_compile_commands.find(filename);
+    if (it != end(m_indexer->m_compile_commands))
+    {
+        options.reserve(it->second.size());
+        for (const auto& arg : it->second)
+            options.push_back(arg.c_str());
+    }
+    const auto& args = it != end(m_indexer->m_compile_commands) ? options : m_indexer->m_options;
+
     kDebug(DEBUG_AREA) << "Indexing:" << filename;
     Q_EMIT(indexing_uri(filename));
 
-    clang::DCXIndexAction action = {clang_IndexAction_create(m_indexer->m_index)};
+    // NOTE Declarations pass (or a profile w/o references) doesn't need references,
+    // and function bodies as well, unless function locals are indexed
+    const auto declarations_only = m_indexer->m_declarations_only || !m_indexer->m_policy.m_references;
+    const auto skip_bodies = m_indexer->m_declarations_only
+      || (declarations_only && !(m_indexer->m_indexing_options & CXIndexOpt_IndexFunctionLocalSymbols));
     IndexerCallbacks index_callbacks = {
         &worker::on_abort_cb
       , &worker::on_diagnostic_cb
@@ -109,22 +206,122 @@ void worker::handle_file(const QString& filename)
       , &worker::on_include_ast_file
       , &worker::on_translation_unit
       , &worker::on_declaration
-      , &worker::on_declaration_reference
+      , declarations_only ? nullptr : &worker::on_declaration_reference
     };
-    auto result = clang_indexSourceFile(
-        action
-      , this
-      , &index_callbacks
-      , sizeof(index_callbacks)
-      , m_indexer->m_indexing_options
-      , filename.toUtf8().constData()
-      , m_indexer->m_options.data()
-      , m_indexer->m_options.size()
-      , nullptr
-      , 0
-      , nullptr
-      , clang_defaultEditingTranslationUnitOptions()        /// \todo Use TranslationUnit class
-      );
+    auto tu_options = clang_defaultEditingTranslationUnitOptions();
+    if (skip_bodies)
+        tu_options |= CXTranslationUnit_SkipFunctionBodies;
+    const auto start_time = std::chrono::steady_clock::now();
+    auto result = 0;
+    auto reparsed = false;
+    // NOTE TU parsed by a caller has no options from a compilation database
+    auto parsed = m_indexer->m_parsed_units.find(filename);
+    if (parsed != end(m_indexer->m_parsed_units) && it == end(m_indexer->m_compile_commands))
+    {
+        // File has been saved, so no unsaved buffers needed to make TU fresh
+        reparsed = !clang_reparseTranslationUnit(
+            parsed->second
+          , 0
+          , nullptr
+          , clang_defaultReparseOptions(parsed->second)
+          );
+        if (reparsed)
+            result = clang_indexTranslationUnit(
+                m_action
+              , this
+              , &index_callbacks
+              , sizeof(index_callbacks)
+              , m_indexer->m_indexing_options
+              , parsed->second
+              );
+        else
+            kDebug(DEBUG_AREA) << "Failed to reparse a given TU, going to parse" << filename;
+    }
+    if (!reparsed)
+        result = clang_indexSourceFile(
+            m_action
+          , this
+          , &index_callbacks
+          , sizeof(index_callbacks)
+          , m_indexer->m_indexing_options
+          , filename.toUtf8().constData()
+          , args.data()
+          , int(args.size())
+          , nullptr
+          , 0
+          , nullptr
+          , tu_options                                      /// \todo Use TranslationUnit class
+          );
+    const auto elapsed = to_milliseconds(std::chrono::steady_clock::now() - start_time);
+    m_batch.m_state.m_parse_time = elapsed;
+    // NOTE Reparse is cheap, but scheduling needs a cost of a complete parse
+    if (reparsed)
+        if (const auto* const prev = m_indexer->m_previous_manifest.find(filename))
+            m_batch.m_state.m_parse_time = prev->m_parse_time;
+
+    // Containers and main file locations are meaningful for the current TU only
+    m_containers.clear();
+    m_local_locations.clear();
+    m_unit_headers.clear();
+
+    // NOTE Parsing interrupted by a cancel request gives incomplete documents,
+    // so nothing goes to the writer: a previous version of the TU (if any)
+    // remains in the DB and gets reindexed by a resumed run
+    if (is_cancelled())
+    {
+        kDebug(DEBUG_AREA) << "Indexing of" << filename << "has been cancelled";
+        m_batch = document_batch{};
+        m_stats = unit_stats{};
+        m_callbacks_time = std::chrono::steady_clock::duration::zero();
+        return;
+    }
+
+    // NOTE Documents of a TU failed to index are better than nothing, but
+    // the TU must not look fresh in a manifest, so it gets reindexed next time
+    if (result)
+        m_batch.m_state.invalidate();
+
+    m_stats.m_filename = filename;
+    m_stats.m_parse_time = elapsed;
+    m_stats.m_callbacks_time = to_milliseconds(m_callbacks_time);
+    m_stats.m_documents = unsigned(m_batch.m_documents.size());
+
+    if (m_shard)
+    {
+        try
+        {
+            m_shard->store(m_batch.m_documents);
+            m_batch.m_shard = m_shard;
+            m_batch.m_shard_docid = m_shard->last_docid();
+        }
+        catch (const Xapian::Error& e)
+        {
+            Q_EMIT(
+                message({
+                    clang::location{}
+                  , i18nc(
+                        "@info/plain"
+                      , "Failed to store index of <filename>%1</filename>: %2"
+                      , filename
+                      , e.get_msg().c_str()
+                      )
+                  , clang::diagnostic_message::type::error
+                  })
+              );
+            // NOTE Documents are lost, so the TU has to be reindexed next time
+            m_batch.m_documents.clear();
+            m_batch.m_state.invalidate();
+        }
+    }
+
+    // Hand over collected documents (or just TU state) to the writer
+    m_indexer->m_batches.push(std::move(m_batch));
+    m_batch = document_batch{};
+
+    Q_EMIT(unit_indexed(m_stats));
+    m_stats = unit_stats{};
+    m_callbacks_time = std::chrono::steady_clock::duration::zero();
+
     if (result)
     {
         Q_EMIT(
@@ -141,52 +338,78 @@ void worker::handle_file(const QString& filename)
     }
 }
 
-void worker::handle_directory(const QString& directory)
+void worker::dispatch_target(const QFileInfo& fi)
 {
-    for (
-        QDirIterator dir_it = {
-            directory
-          , QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot | QDir::CaseSensitive
-          , QDirIterator::FollowSymlinks
-          }
-      ; dir_it.hasNext()
-      ;
-      )
+    if (is_cancelled())
     {
-        dir_it.next();
-        if (dispatch_target(dir_it.fileInfo()))
-            break;
-        //
-        QCoreApplication::processEvents();
+        kDebug(DEBUG_AREA) << "Cancel requested: exiting indexer thread...";
+        return;
     }
-}
 
-inline bool worker::dispatch_target(const KUrl& url)
-{
-    return dispatch_target(QFileInfo{url.toLocalFile()});
+    // NOTE Targets are source files found by discovery or listed in a compilation database
+    const auto& filename = fi.canonicalFilePath();
+    if (!fi.isFile())
+        kDebug(DEBUG_AREA) << filename << "is not a file!";
+    else if (m_indexer->claim_file(filename))
+        handle_file(filename, fi);
+    ++m_indexer->m_processed_files;
 }
 
-bool worker::dispatch_target(const QFileInfo& fi)
+/**
+ * Get a file ID attached by \c on_entering_main_file() or \c on_include_file()
+ * to a file of the given location, so no file name lookup required.
+ *
+ * \return \c false if location has no file (e.g. builtin)
+ */
+bool worker::resolve_location(const CXIdxLoc loc, fileid& file_id, unsigned& line, unsigned& column)
 {
-    if (is_cancelled())
+    CXIdxClientFile client_file = nullptr;
+    CXFile file = nullptr;
+    line = column = 0;
+    clang_indexLoc_getFileLocation(loc, &client_file, &file, &line, &column, nullptr);
+    if (client_file)
     {
-        kDebug(DEBUG_AREA) << "Cancel requested: exiting indexer thread...";
+        file_id = from_client_file(client_file);
         return true;
     }
+    if (!file)
+        return false;
+    // NOTE Normally should not happen: all files must be announced via callbacks
+    file_id = m_indexer->get_file_id(clang::toString(file));
+    return true;
+}
 
-    const auto& filename = fi.canonicalFilePath();
-    if (fi.isDir())
-        handle_directory(filename);
-    else if (fi.isFile() && kate::isLookLikeCppSource(fi))
-        handle_file(filename);
-    else
-        kDebug(DEBUG_AREA) << filename << "is not a suitable file or directory!";
-    return false;
+/**
+ * Locations in a main file of the current TU can't be met in other TUs,
+ * so only locations from headers have to be checked w/ the indexer
+ * (shared by all workers).
+ *
+ * \return \c true if the location has not been seen yet (and now it is)
+ */
+bool worker::is_new_location(const fileid file, const unsigned line, const unsigned column)
+{
+    return file == m_main_file_id
+      ? m_local_locations.insert(file, line, column)
+      : m_indexer->claim_location(file, line, column)
+      ;
 }
 
-int worker::on_abort_cb(CXClientData, void*)
+/// \return a new document ID, or \c 0 if the location has been seen already
+Xapian::docid worker::claim_location(const fileid file, const unsigned line, const unsigned column)
 {
-    return 0;
+    return is_new_location(file, line, column) ? allocate_docid() : 0;
+}
+
+/// Document IDs of a shard (if any) must be taken from its range
+Xapian::docid worker::allocate_docid()
+{
+    return m_shard ? m_shard->allocate_docid() : m_indexer->allocate_docid();
+}
+
+int worker::on_abort_cb(CXClientData client_data, void*)
+{
+    auto* const wrk = static_cast<worker*>(client_data);
+    return wrk->is_cancelled();
 }
 
 void worker::on_diagnostic_cb(CXClientData client_data, CXDiagnosticSet diagnostics, void*)
@@ -244,11 +467,11 @@ void worker::on_diagnostic_cb(CXClientData client_data, CXDiagnosticSet diagnost
     }
 }
 
-CXIdxClientFile worker::on_entering_main_file(CXClientData, CXFile file, void*)
+CXIdxClientFile worker::on_entering_main_file(CXClientData client_data, CXFile file, void*)
 {
-    auto filename = clang::toString(file);
-    kDebug() << "Entering main file: filename=" << filename;
-    return static_cast<CXIdxClientFile>(file);
+    auto* const wrk = static_cast<worker*>(client_data);
+    kDebug() << "Entering main file: filename=" << clang::toString(file);
+    return to_client_file(wrk->m_main_file_id);
 }
 
 CXIdxClientFile worker::on_include_file(CXClientData client_data, const CXIdxIncludedFileInfo* info)
@@ -261,8 +484,20 @@ CXIdxClientFile worker::on_include_file(CXClientData client_data, const CXIdxInc
         << " at line " << clang::location(info->hashLoc).line();
 #endif
     auto* const wrk = static_cast<worker*>(client_data);
-    Q_UNUSED(wrk);
-    return static_cast<CXIdxClientFile>(info->file);
+    // NOTE If a header has been seen in this session already, bodies of its
+    // functions will not be parsed again (if configured so). Repeated includes
+    // of a header in the same TU are not parsed anyway, so they don't count.
+    const auto file_id = wrk->m_indexer->get_file_id(clang::toString(info->file));
+    if (wrk->m_unit_headers.insert(file_id).second && !wrk->m_parsed_headers.insert(file_id).second)
+        ++wrk->m_skipped_headers;
+    // NOTE Includer has been announced already (as a main file or a header)
+    CXIdxClientFile includer = nullptr;
+    clang_indexLoc_getFileLocation(info->hashLoc, &includer, nullptr, nullptr, nullptr, nullptr);
+    if (includer)
+        wrk->m_batch.m_includes.push_back(
+            include_edge{from_client_file(includer), file_id, std::int64_t(clang_getFileTime(info->file))}
+          );
+    return to_client_file(file_id);
 }
 
 CXIdxClientASTFile worker::on_include_ast_file(CXClientData client_data, const CXIdxImportedASTFileInfo* info)
@@ -280,35 +515,32 @@ CXIdxClientContainer worker::on_translation_unit(CXClientData client_data, void*
 
 void worker::on_declaration(CXClientData client_data, const CXIdxDeclInfo* const info)
 {
-    clang::location loc;
-    try
-    {
-        loc = clang::location{info->loc};
-    }
-    catch (...)
+    auto* const wrk = static_cast<worker*>(client_data);
+    scope_timer timer{wrk->m_callbacks_time};
+    ++wrk->m_stats.m_declarations;
+    if (!wrk->is_wanted(info))
+        return;
+    fileid file_id;
+    unsigned line;
+    unsigned column;
+    if (!wrk->resolve_location(info->loc, file_id, line, column))
     {
         auto name = string_cast<std::string>(info->entityInfo->name);
-        CXIdxClientFile file;
-        unsigned line;
-        unsigned column;
-        unsigned offset;
-        clang_indexLoc_getFileLocation(info->loc, &file, nullptr, &line, &column, &offset);
         kDebug() << "DECLARATION W/O LOCATION: name=" << name.c_str() << ", line=" << line << ", col=" << column;
         return;
     }
     // Make sure we've not seen it yet
-    auto* const wrk = static_cast<worker*>(client_data);
-    auto file_id = wrk->m_indexer->m_db.headers_map()[loc.file().toLocalFile()];
-    auto decl_loc = declaration_location{file_id, loc.line(), loc.column()};
     /// \todo Track all locations for namespaces and then update
     /// the only document w/ them...
-    if (wrk->m_seen_declarations.find(decl_loc) != end(wrk->m_seen_declarations))
+    const auto document_id = wrk->claim_location(file_id, line, column);
+    if (!document_id)
         return;
 
     /// \note Unnamed parameters and anonymous namespaces/classes/structs/enums/unions
     /// have an empty name!
     /// \todo Remove possible spaces from \c name?
-    auto name = string_cast<std::string>(info->entityInfo->name);
+    auto& builder = wrk->m_builder;
+    auto& name = builder.name(info->entityInfo->name);
 
     // Create a new document for declaration and attach all required value slots and terms
     auto doc = document{};
@@ -343,24 +575,23 @@ void worker::on_declaration(CXClientData client_data, const CXIdxDeclInfo* const
         // NOTE Add terms w/ possible stripped name, but have a full name
         // at value slots
 #if 0
-        doc.add_posting(name, make_term_position(loc));
-#else
-        doc.add_term(boost::to_lower_copy(name));
+        doc.add_posting(name, make_term_position(line, column));
 #endif
-        doc.add_boolean_term(term::XDECL, name);            // Mark the document w/ XDECL prefixed term
+        builder.add_name_terms(doc, term::XDECL, name);     // Mark the document w/ XDECL prefixed term
         // NOTE Add an original name to the value slot!
-        doc.add_value(value_slot::NAME, info->entityInfo->name);
+        builder.add_value(doc, value_slot::NAME, info->entityInfo->name);
     }
     else
     {
-        doc.add_boolean_term(term::XANONYMOUS + "y");
+        builder.add_flag(doc, document_builder::flag::ANONYMOUS);
     }
-    doc.add_value(value_slot::LINE, Xapian::sortable_serialise(loc.line()));
-    doc.add_value(value_slot::COLUMN, Xapian::sortable_serialise(loc.column()));
+    builder.add_usr(doc, info->entityInfo->USR);
+    doc.add_value(value_slot::LINE, Xapian::sortable_serialise(line));
+    doc.add_value(value_slot::COLUMN, Xapian::sortable_serialise(column));
     doc.add_value(value_slot::FILE, Xapian::sortable_serialise(file_id));
     const auto database_id = wrk->m_indexer->m_db.id();
     doc.add_value(value_slot::DBID, serialize(database_id));
-    auto parent_qname = std::string{};
+    const container_info* parent = nullptr;
     if (info->semanticContainer)
     {
         const auto* const container = reinterpret_cast<const container_info* const>(
@@ -369,12 +600,12 @@ void worker::on_declaration(CXClientData client_data, const CXIdxDeclInfo* const
         if (container)
         {
             doc.add_value(value_slot::SEMANTIC_CONTAINER, docref::to_string(container->m_ref));
-            parent_qname = container->m_qname;
-            if (!parent_qname.empty())
+            if (!container->m_qname.empty())
             {
-                doc.add_boolean_term(term::XSCOPE, container->m_name);
-                doc.add_boolean_term(term::XSCOPE, parent_qname);
-                doc.add_value(value_slot::SCOPE, parent_qname);
+                parent = container;
+                builder.add_boolean_term(doc, term::XSCOPE, container->m_name);
+                builder.add_boolean_term(doc, term::XSCOPE, container->m_qname);
+                doc.add_value(value_slot::SCOPE, container->m_qname);
             }
         }
 #if 0
@@ -398,10 +629,11 @@ void worker::on_declaration(CXClientData client_data, const CXIdxDeclInfo* const
     }
 
     // Get more terms/slots to attach
-    auto type_flags = update_decl_document_with_kind(info, doc);
+    auto type_flags = wrk->update_decl_document_with_kind(info, doc);
     type_flags.m_decl = true;
 
     // Attach symbol type. Get aliased type for typedefs, get underlaid type for enums.
+    const auto& policy = wrk->m_indexer->m_policy;
     {
         const auto kind = clang::kind_of(*info->entityInfo);
         CXType ct;
@@ -414,13 +646,14 @@ void worker::on_declaration(CXClientData client_data, const CXIdxDeclInfo* const
         const auto k = clang::kind_of(ct);
         if (k != CXType_Invalid && k != CXType_Unexposed)
         {
-            auto type_str = to_string(clang::DCXString{clang_getTypeSpelling(ct)});
-            if (!type_str.empty())
-                doc.add_value(value_slot::TYPE, type_str);
+            const clang::DCXString type_str{clang_getTypeSpelling(ct)};
+            const auto* const type_cstr = clang_getCString(type_str);
+            if (type_cstr && *type_cstr && policy.m_type_details)
+                builder.add_value(doc, value_slot::TYPE, type_cstr);
             // Check some type properties
             if (clang_isPODType(ct))
             {
-                doc.add_boolean_term(term::XPOD + "y");
+                builder.add_flag(doc, document_builder::flag::POD);
                 type_flags.m_pod = true;
             }
             if (clang_isConstQualifiedType(ct))
@@ -428,166 +661,110 @@ void worker::on_declaration(CXClientData client_data, const CXIdxDeclInfo* const
             if (clang_isVolatileQualifiedType(ct))
                 type_flags.m_volatile = true;
             const auto arity = clang_getNumArgTypes(ct);
-            if (arity != -1)
+            if (arity != -1 && policy.m_type_details)
                 doc.add_value(value_slot::ARITY, Xapian::sortable_serialise(arity));
         }
 
         // Get base classes
-        const auto can_have_inheritance = kind == CXIdxEntity_Struct
-          || kind == CXIdxEntity_CXXClass
+        const auto can_have_inheritance = policy.m_type_details
+          && (kind == CXIdxEntity_Struct || kind == CXIdxEntity_CXXClass)
           ;
         if (can_have_inheritance)
-            update_document_with_base_classes(info, doc);
+            wrk->update_document_with_base_classes(info, doc);
     }
 
     // Try to get access specifier for a declaration
-    {
-        const auto access = clang_getCXXAccessSpecifier(info->cursor);
-        switch (access)
-        {
-            case CX_CXXPublic:
-                doc.add_boolean_term(term::XACCESS + "public");
-                doc.add_value(value_slot::ACCESS, serialize(unsigned(access)));
-                break;
-            case CX_CXXProtected:
-                doc.add_boolean_term(term::XACCESS + "protected");
-                doc.add_value(value_slot::ACCESS, serialize(unsigned(access)));
-                break;
-            case CX_CXXPrivate:
-                doc.add_boolean_term(term::XACCESS + "private");
-                doc.add_value(value_slot::ACCESS, serialize(unsigned(access)));
-                break;
-            case CX_CXXInvalidAccessSpecifier:
-            default:
-                break;
-        }
-    }
+    builder.add_access(doc, clang_getCXXAccessSpecifier(info->cursor));
 
     if ((type_flags.m_redecl = bool(info->isRedeclaration)))
-        doc.add_boolean_term(term::XREDECLARATION + "y");
+        builder.add_flag(doc, document_builder::flag::REDECLARATION);
 
     if ((type_flags.m_implicit = bool(info->isImplicit)))
-        doc.add_boolean_term(term::XIMPLICIT + "y");
+        builder.add_flag(doc, document_builder::flag::IMPLICIT);
 
     // Attach collected type flags finally
     if (type_flags.m_flags_as_int)
         doc.add_value(value_slot::FLAGS, serialize(type_flags.m_flags_as_int));
 
-    // Add the document to the DB finally
-    auto document_id = wrk->m_indexer->m_db.add_document(doc);
+    // Add the document to the batch finally
+    wrk->m_batch.m_documents.emplace_back(document_id, std::move(doc));
+    if (file_id == wrk->m_main_file_id)
+        wrk->m_batch.m_state.m_documents.push_back(document_id);
+    else
+        wrk->m_batch.m_header_documents.emplace_back(file_id, document_id);
     auto ref = docref{database_id, document_id};
-    wrk->m_seen_declarations[decl_loc] = ref;               // Mark it as seen declaration
 
     // Make a new container if necessary
     if (info->declAsContainer)
     {
-        if (parent_qname.empty())
-            parent_qname = name;
+        auto qname = std::string{};
+        if (parent)
+        {
+            qname.reserve(parent->m_qname.size() + 2 + name.size());
+            qname.append(parent->m_qname).append("::").append(name);
+        }
         else
-            parent_qname += "::" + name;
+            qname = name;
         clang_index_setClientContainer(
             info->declAsContainer
-          , wrk->update_client_container(ref, name, parent_qname)
+          , wrk->update_client_container(ref, name, std::move(qname))
           );
     }
 }
 
-/// \todo Deduplicate code w/ \c on_declaration
+/**
+ * References are not stored as documents (they are too many), but
+ * collected to a references table as (symbol ID, location, container).
+ */
 void worker::on_declaration_reference(CXClientData client_data, const CXIdxEntityRefInfo* const info)
 {
-    clang::location loc;
-    try
-    {
-        loc = clang::location{info->loc};
-    }
-    catch (...)
+    auto* const wrk = static_cast<worker*>(client_data);
+    scope_timer timer{wrk->m_callbacks_time};
+    ++wrk->m_stats.m_references;
+    fileid file_id;
+    unsigned line;
+    unsigned column;
+    if (!wrk->resolve_location(info->loc, file_id, line, column))
     {
         auto name = string_cast<std::string>(info->referencedEntity->name);
-        CXIdxClientFile file;
-        unsigned line;
-        unsigned column;
-        unsigned offset;
-        clang_indexLoc_getFileLocation(info->loc, &file, nullptr, &line, &column, &offset);
         kDebug() << "REFERENCE W/O LOCATION: name=" << name.c_str() << ", line=" << line << ", col=" << column;
         return;
     }
+    const auto* const usr = info->referencedEntity->USR;
+    if (!usr || !*usr)
+        return;
     // Make sure we've not seen it yet
-    auto* const wrk = static_cast<worker*>(client_data);
-    auto file_id = wrk->m_indexer->m_db.headers_map()[loc.file().toLocalFile()];
-    auto decl_loc = declaration_location{file_id, loc.line(), loc.column()};
-    /// \todo Track all locations for namespaces and then update
-    /// the only document w/ them...
-    if (wrk->m_seen_declarations.find(decl_loc) != end(wrk->m_seen_declarations))
+    if (!wrk->is_new_location(file_id, line, column))
         return;
 
-    /// \todo Are empty names possible?
-    /// \todo Remove possible spaces from \c name?
-    auto name = string_cast<std::string>(info->referencedEntity->name);
-    assert("FIXME: Empty reference name detected" && !name.empty());
-
-    auto ct = clang_getCursorType(info->cursor);
-    const auto t = toString(clang::DCXString{clang_getTypeSpelling(ct)});
-
-#if 0
-    const auto k = clang::kind_of(ct);
-    kDebug() << "found reference: name=" << name.c_str() << ", kind=" << clang::toString(k) << ", type=" << t;
-#endif
-
-    // Create a new document for declaration and attach all required value slots and terms
-    auto doc = document{};
-
-    // Add terms related to name
-#if 0
-    doc.add_posting(name, make_term_position(loc));
-#else
-    doc.add_term(boost::to_lower_copy(name));
-#endif
-    doc.add_boolean_term(term::XREF, name);                 // Mark the document w/ XREF prefixed term
-    doc.add_value(value_slot::NAME, name);
-
-    // Add location terms
-    doc.add_value(value_slot::LINE, Xapian::sortable_serialise(loc.line()));
-    doc.add_value(value_slot::COLUMN, Xapian::sortable_serialise(loc.column()));
-    doc.add_value(value_slot::FILE, Xapian::sortable_serialise(file_id));
-    const auto database_id = wrk->m_indexer->m_db.id();
-    doc.add_value(value_slot::DBID, serialize(database_id));
-
+    auto container_id = IVALID_DOCUMENT_ID;
     if (info->container)
     {
         const auto* const container = reinterpret_cast<const container_info* const>(
             clang_index_getClientContainer(info->container)
           );
         if (container)
-        {
-            doc.add_value(value_slot::LEXICAL_CONTAINER, docref::to_string(container->m_ref));
-            const auto& parent_qname = container->m_qname;
-#if 0
-            kDebug(DEBUG_AREA) << "Found parent container:" << parent_qname.c_str();
-#endif
-            if (!parent_qname.empty())
-            {
-                doc.add_boolean_term(term::XSCOPE, container->m_name);
-                doc.add_boolean_term(term::XSCOPE, parent_qname);
-                doc.add_value(value_slot::SCOPE, parent_qname);
-            }
-        }
-#if 0
-        else
-        {
-            kDebug(DEBUG_AREA) << "No parent container for" << name.c_str();
-        }
-#endif
+            container_id = container->m_ref.document_id();
     }
+    wrk->m_batch.m_references.emplace_back(usr_hash(usr), xref{file_id, line, column, container_id});
+}
 
-    auto type_flags = update_ref_document_with_kind(info, doc);
-    // Attach collected type flags finally
-    if (type_flags.m_flags_as_int)
-        doc.add_value(value_slot::FLAGS, serialize(type_flags.m_flags_as_int));
-
-    // Add the document to the DB finally
-    auto document_id = wrk->m_indexer->m_db.add_document(doc);
-    auto ref = docref{database_id, document_id};
-    wrk->m_seen_declarations[decl_loc] = ref;               // Mark it as seen reference
+/**
+ * Check a declaration against the indexing policy before a document ID gets
+ * allocated for it. Anonymous containers are always wanted: their documents
+ * are referred by nested declarations.
+ */
+bool worker::is_wanted(const CXIdxDeclInfo* const info) const
+{
+    const auto& policy = m_indexer->m_policy;
+    if (info->isImplicit && !policy.m_implicits)
+        return false;
+    if (!policy.m_parameters && clang::kind_of(info->cursor) == CXCursor_ParmDecl)
+        return false;
+    const auto* const name = info->entityInfo->name;
+    if ((!name || !*name) && !policy.m_anonymous && !info->declAsContainer)
+        return false;
+    return true;
 }
 
 search_result::flags worker::update_decl_document_with_kind(
@@ -600,98 +777,84 @@ search_result::flags worker::update_decl_document_with_kind(
     switch (clang::kind_of(*info->entityInfo))
     {
         case CXIdxEntity_CXXNamespace:
-            doc.add_boolean_term(term::XKIND + "ns");
-            doc.add_value(value_slot::KIND, serialize(kind::NAMESPACE));
+            m_builder.add_kind(doc, kind::NAMESPACE);
             break;
         case CXIdxEntity_CXXNamespaceAlias:
-            doc.add_boolean_term(term::XKIND + "ns-alias");
-            doc.add_value(value_slot::KIND, serialize(kind::NAMESPACE_ALIAS));
+            m_builder.add_kind(doc, kind::NAMESPACE_ALIAS);
             break;
         case CXIdxEntity_Typedef:
-            doc.add_boolean_term(term::XKIND + "typedef");
-            doc.add_value(value_slot::KIND, serialize(kind::TYPEDEF));
+            m_builder.add_kind(doc, kind::TYPEDEF);
             update_document_with_type_size(info, doc);
             break;
         case CXIdxEntity_CXXTypeAlias:
-            doc.add_boolean_term(term::XKIND + "type-alias");
-            doc.add_value(value_slot::KIND, serialize(kind::TYPE_ALIAS));
-            update_document_with_template_kind(info->entityInfo->templateKind, doc);
+            m_builder.add_kind(doc, kind::TYPE_ALIAS);
+            m_builder.add_template_kind(doc, info->entityInfo->templateKind);
             update_document_with_type_size(info, doc);
             break;
         case CXIdxEntity_Struct:
-            doc.add_boolean_term(term::XKIND + "struct");
-            doc.add_value(value_slot::KIND, serialize(kind::STRUCT));
-            update_document_with_template_kind(info->entityInfo->templateKind, doc);
+            m_builder.add_kind(doc, kind::STRUCT);
+            m_builder.add_template_kind(doc, info->entityInfo->templateKind);
             update_document_with_type_size(info, doc);
             break;
         case CXIdxEntity_CXXClass:
-            doc.add_boolean_term(term::XKIND + "class");
-            doc.add_value(value_slot::KIND, serialize(kind::CLASS));
-            update_document_with_template_kind(info->entityInfo->templateKind, doc);
+            m_builder.add_kind(doc, kind::CLASS);
+            m_builder.add_template_kind(doc, info->entityInfo->templateKind);
             update_document_with_type_size(info, doc);
             break;
         case CXIdxEntity_Union:
-            doc.add_boolean_term(term::XKIND + "union");
-            doc.add_value(value_slot::KIND, serialize(kind::UNION));
+            m_builder.add_kind(doc, kind::UNION);
             update_document_with_type_size(info, doc);
             break;
         case CXIdxEntity_Enum:
-            doc.add_boolean_term(term::XKIND + "enum");
-            doc.add_value(value_slot::KIND, serialize(kind::ENUM));
+            m_builder.add_kind(doc, kind::ENUM);
             update_document_with_type_size(info, doc);
             break;
         case CXIdxEntity_EnumConstant:
         {
-            doc.add_boolean_term(term::XKIND + "enum-const");
-            doc.add_value(value_slot::KIND, serialize(kind::ENUM_CONSTANT));
+            m_builder.add_kind(doc, kind::ENUM_CONSTANT);
             const auto value = clang_getEnumConstantDeclValue(info->cursor);
             doc.add_value(value_slot::VALUE, Xapian::sortable_serialise(value));
             break;
         }
         case CXIdxEntity_Function:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_value(value_slot::KIND, serialize(kind::FUNCTION));
-            update_document_with_template_kind(info->entityInfo->templateKind, doc);
+            m_builder.add_kind(doc, kind::FUNCTION);
+            m_builder.add_template_kind(doc, info->entityInfo->templateKind);
             break;
         case CXIdxEntity_CXXStaticMethod:
-            doc.add_boolean_term(term::XSTATIC + "y");
+            m_builder.add_flag(doc, document_builder::flag::STATIC);
             type_flags.m_static = true;
             // ATTENTION Fall into the next (CXIdxEntity_CXXInstanceMethod) case...
         case CXIdxEntity_CXXInstanceMethod:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_boolean_term(term::XKIND + "method");
-            doc.add_value(value_slot::KIND, serialize(kind::METHOD));
-            update_document_with_template_kind(info->entityInfo->templateKind, doc);
+            m_builder.add_kind_term(doc, kind::FUNCTION);
+            m_builder.add_kind(doc, kind::METHOD);
+            m_builder.add_template_kind(doc, info->entityInfo->templateKind);
             if (clang_CXXMethod_isVirtual(info->cursor))
             {
-                doc.add_boolean_term(term::XVIRTUAL + "y");
+                m_builder.add_flag(doc, document_builder::flag::VIRTUAL);
                 type_flags.m_virtual = true;
             }
             break;
         case CXIdxEntity_CXXConstructor:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_boolean_term(term::XKIND + "ctor");
-            doc.add_value(value_slot::KIND, serialize(kind::CONSTRUCTOR));
-            update_document_with_template_kind(info->entityInfo->templateKind, doc);
+            m_builder.add_kind_term(doc, kind::FUNCTION);
+            m_builder.add_kind(doc, kind::CONSTRUCTOR);
+            m_builder.add_template_kind(doc, info->entityInfo->templateKind);
             break;
         case CXIdxEntity_CXXDestructor:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_boolean_term(term::XKIND + "dtor");
-            doc.add_value(value_slot::KIND, serialize(kind::DESTRUCTOR));
+            m_builder.add_kind_term(doc, kind::FUNCTION);
+            m_builder.add_kind(doc, kind::DESTRUCTOR);
             if (clang_CXXMethod_isVirtual(info->cursor))
             {
-                doc.add_boolean_term(term::XVIRTUAL + "y");
+                m_builder.add_flag(doc, document_builder::flag::VIRTUAL);
                 type_flags.m_virtual = true;
             }
             break;
         case CXIdxEntity_CXXConversionFunction:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_boolean_term(term::XKIND + "conversion");
-            doc.add_value(value_slot::KIND, serialize(kind::CONVERSTION));
-            update_document_with_template_kind(info->entityInfo->templateKind, doc);
+            m_builder.add_kind_term(doc, kind::FUNCTION);
+            m_builder.add_kind(doc, kind::CONVERSTION);
+            m_builder.add_template_kind(doc, info->entityInfo->templateKind);
             if (clang_CXXMethod_isVirtual(info->cursor))
             {
-                doc.add_boolean_term(term::XVIRTUAL + "y");
+                m_builder.add_flag(doc, document_builder::flag::VIRTUAL);
                 type_flags.m_virtual = true;
             }
             break;
@@ -700,13 +863,11 @@ search_result::flags worker::update_decl_document_with_kind(
             auto cursor_kind = clang::kind_of(info->cursor);
             if (cursor_kind == CXCursor_ParmDecl)
             {
-                doc.add_boolean_term(term::XKIND + "param");
-                doc.add_value(value_slot::KIND, serialize(kind::PARAMETER));
+                m_builder.add_kind(doc, kind::PARAMETER);
             }
             else
             {
-                doc.add_boolean_term(term::XKIND + "var");
-                doc.add_value(value_slot::KIND, serialize(kind::VARIABLE));
+                m_builder.add_kind(doc, kind::VARIABLE);
                 /// \bug clang 3.3 (at lest! other version I guess also affected)
                 /// some times (noticed for <tt>auto& variable</tt>) may crash
                 /// on getting \c sizeof type of the cursor... so do not evn try
@@ -719,22 +880,21 @@ search_result::flags worker::update_decl_document_with_kind(
             break;
         }
         case CXIdxEntity_CXXStaticVariable:
-            doc.add_boolean_term(term::XSTATIC + "y");
+            m_builder.add_flag(doc, document_builder::flag::STATIC);
             type_flags.m_static = true;
             // ATTENTION Fall into the next (CXIdxEntity_Field) case...
         case CXIdxEntity_Field:
-            doc.add_boolean_term(term::XKIND + "field");
             if (clang_Cursor_isBitField(info->cursor))
             {
-                doc.add_boolean_term(term::XKIND + "bitfield");
-                doc.add_value(value_slot::KIND, serialize(kind::BITFIELD));
+                m_builder.add_kind_term(doc, kind::FIELD);
+                m_builder.add_kind(doc, kind::BITFIELD);
                 const auto width = clang_getFieldDeclBitWidth(info->cursor);
                 doc.add_value(value_slot::VALUE, Xapian::sortable_serialise(width));
                 type_flags.m_bit_field = true;
             }
             else
             {
-                doc.add_value(value_slot::KIND, serialize(kind::FIELD));
+                m_builder.add_kind(doc, kind::FIELD);
                 update_document_with_type_size(info, doc);
             }
             break;
@@ -744,180 +904,13 @@ search_result::flags worker::update_decl_document_with_kind(
     return type_flags;
 }
 
-search_result::flags worker::update_ref_document_with_kind(
-    const CXIdxEntityRefInfo* const info
-  , document& doc
-  )
-{
-    auto type_flags = search_result::flags{};
-
-    switch (clang::kind_of(*info->referencedEntity))
-    {
-        case CXIdxEntity_CXXNamespace:
-            doc.add_boolean_term(term::XKIND + "ns");
-            doc.add_value(value_slot::KIND, serialize(kind::NAMESPACE));
-            break;
-        case CXIdxEntity_CXXNamespaceAlias:
-            doc.add_boolean_term(term::XKIND + "ns-alias");
-            doc.add_value(value_slot::KIND, serialize(kind::NAMESPACE_ALIAS));
-            break;
-        case CXIdxEntity_Typedef:
-            doc.add_boolean_term(term::XKIND + "typedef");
-            doc.add_value(value_slot::KIND, serialize(kind::TYPEDEF));
-            break;
-        case CXIdxEntity_CXXTypeAlias:
-            doc.add_boolean_term(term::XKIND + "type-alias");
-            doc.add_value(value_slot::KIND, serialize(kind::TYPE_ALIAS));
-            update_document_with_template_kind(info->referencedEntity->templateKind, doc);
-            break;
-        case CXIdxEntity_Struct:
-            doc.add_boolean_term(term::XKIND + "struct");
-            doc.add_value(value_slot::KIND, serialize(kind::STRUCT));
-            update_document_with_template_kind(info->referencedEntity->templateKind, doc);
-            break;
-        case CXIdxEntity_CXXClass:
-            doc.add_boolean_term(term::XKIND + "class");
-            doc.add_value(value_slot::KIND, serialize(kind::CLASS));
-            update_document_with_template_kind(info->referencedEntity->templateKind, doc);
-            break;
-        case CXIdxEntity_Union:
-            doc.add_boolean_term(term::XKIND + "union");
-            doc.add_value(value_slot::KIND, serialize(kind::UNION));
-            break;
-        case CXIdxEntity_Enum:
-            doc.add_boolean_term(term::XKIND + "enum");
-            doc.add_value(value_slot::KIND, serialize(kind::ENUM));
-            break;
-        case CXIdxEntity_EnumConstant:
-        {
-            doc.add_boolean_term(term::XKIND + "enum-const");
-            doc.add_value(value_slot::KIND, serialize(kind::ENUM_CONSTANT));
-            const auto value = clang_getEnumConstantDeclValue(info->cursor);
-            doc.add_value(value_slot::VALUE, Xapian::sortable_serialise(value));
-            break;
-        }
-        case CXIdxEntity_Function:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_value(value_slot::KIND, serialize(kind::FUNCTION));
-            update_document_with_template_kind(info->referencedEntity->templateKind, doc);
-            break;
-        case CXIdxEntity_CXXStaticMethod:
-            doc.add_boolean_term(term::XSTATIC + "y");
-            type_flags.m_static = true;
-            // ATTENTION Fall into the next (CXIdxEntity_CXXInstanceMethod) case...
-        case CXIdxEntity_CXXInstanceMethod:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_boolean_term(term::XKIND + "method");
-            doc.add_value(value_slot::KIND, serialize(kind::METHOD));
-            update_document_with_template_kind(info->referencedEntity->templateKind, doc);
-            if (clang_CXXMethod_isVirtual(info->cursor))
-            {
-                doc.add_boolean_term(term::XVIRTUAL + "y");
-                type_flags.m_virtual = true;
-            }
-            break;
-        case CXIdxEntity_CXXConstructor:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_boolean_term(term::XKIND + "ctor");
-            doc.add_value(value_slot::KIND, serialize(kind::CONSTRUCTOR));
-            update_document_with_template_kind(info->referencedEntity->templateKind, doc);
-            break;
-        case CXIdxEntity_CXXDestructor:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_boolean_term(term::XKIND + "dtor");
-            doc.add_value(value_slot::KIND, serialize(kind::DESTRUCTOR));
-            if (clang_CXXMethod_isVirtual(info->cursor))
-            {
-                doc.add_boolean_term(term::XVIRTUAL + "y");
-                type_flags.m_virtual = true;
-            }
-            break;
-        case CXIdxEntity_CXXConversionFunction:
-            doc.add_boolean_term(term::XKIND + "fn");
-            doc.add_boolean_term(term::XKIND + "conversion");
-            doc.add_value(value_slot::KIND, serialize(kind::CONVERSTION));
-            update_document_with_template_kind(info->referencedEntity->templateKind, doc);
-            if (clang_CXXMethod_isVirtual(info->cursor))
-            {
-                doc.add_boolean_term(term::XVIRTUAL + "y");
-                type_flags.m_virtual = true;
-            }
-            break;
-        case CXIdxEntity_Variable:
-        {
-            auto cursor_kind = clang::kind_of(info->cursor);
-            if (cursor_kind == CXCursor_ParmDecl)
-            {
-                doc.add_boolean_term(term::XKIND + "param");
-                doc.add_value(value_slot::KIND, serialize(kind::PARAMETER));
-            }
-            else
-            {
-                doc.add_boolean_term(term::XKIND + "var");
-                doc.add_value(value_slot::KIND, serialize(kind::VARIABLE));
-            }
-            break;
-        }
-        case CXIdxEntity_CXXStaticVariable:
-            doc.add_boolean_term(term::XSTATIC + "y");
-            type_flags.m_static = true;
-            // ATTENTION Fall into the next (CXIdxEntity_Field) case...
-        case CXIdxEntity_Field:
-            doc.add_boolean_term(term::XKIND + "field");
-            if (clang_Cursor_isBitField(info->cursor))
-            {
-                doc.add_boolean_term(term::XKIND + "bitfield");
-                doc.add_value(value_slot::KIND, serialize(kind::BITFIELD));
-                const auto width = clang_getFieldDeclBitWidth(info->cursor);
-                doc.add_value(value_slot::VALUE, Xapian::sortable_serialise(width));
-                type_flags.m_bit_field = true;
-            }
-            else doc.add_value(value_slot::KIND, serialize(kind::FIELD));
-            break;
-        default:
-            break;
-    }
-    return type_flags;
-}
-
-void worker::update_document_with_template_kind(
-    const CXIdxEntityCXXTemplateKind template_kind
-  , document& doc
-  )
-{
-    switch (template_kind)
-    {
-        case CXIdxEntity_Template:
-            doc.add_boolean_term(term::XTEMPLATE + "y");
-            doc.add_value(
-                value_slot::TEMPLATE
-              , serialize(unsigned(template_kind))
-              );
-            break;
-        case CXIdxEntity_TemplatePartialSpecialization:
-            doc.add_boolean_term(term::XTEMPLATE + "ps");
-            doc.add_value(
-                value_slot::TEMPLATE
-              , serialize(unsigned(template_kind))
-              );
-            break;
-        case CXIdxEntity_TemplateSpecialization:
-            doc.add_boolean_term(term::XTEMPLATE + "fs");
-            doc.add_value(
-                value_slot::TEMPLATE
-              , serialize(unsigned(template_kind))
-              );
-            break;
-        default:
-            break;
-    }
-}
-
 void worker::update_document_with_type_size(
     const CXIdxDeclInfo* info
   , document& doc
-  )
+  ) const
 {
+    if (!m_indexer->m_policy.m_type_details)
+        return;
     auto ct = clang_getCursorType(info->cursor);
     const auto k = clang::kind_of(ct);
     if (k != CXType_Invalid && k != CXType_Unexposed)
@@ -946,7 +939,7 @@ void worker::update_document_with_base_classes(const CXIdxDeclInfo* info, docume
             {
                 auto name = string_cast<std::string>(class_info->bases[i]->base->name);
                 assert("Unnamed base class?" && !name.empty());
-                doc.add_boolean_term(term::XBASE_CLASS, name);
+                m_builder.add_boolean_term(doc, term::XBASE_CLASS, name);
 
                 auto inheritance_term = std::string{};
                 const auto is_virtual = clang_isVirtualBase(class_info->bases[i]->cursor);
@@ -29,21 +29,26 @@
 
 // Project specific includes
 #include "container_info.h"
+#include "document_batch.h"
+#include "document_builder.h"
+#include "location_set.h"
+#include "../indexing_stats.h"
 #include "../search_result.h"
 #include "../../clang/diagnostic_message.h"
+#include "../../clang/disposable.h"
 
 // Standard includes
 #include <clang-c/Index.h>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <atomic>
-#include <map>
-#include <memory>
+#include <chrono>
+#include <deque>
+#include <set>
 #include <vector>
 
 // fwd decls
 class QFileInfo;
-class KUrl;
 
 namespace kate { namespace index {
 
@@ -52,10 +57,21 @@ class document;
 class indexer;
 
 namespace details {
+class shard;                                                // fwd decl
 
 /**
  * \brief Worker class to do an indexer's job
  *
+ * Every worker has its own \c CXIndex and takes targets from the queue
+ * shared by all workers. The only \c CXIndexAction is used by a worker
+ * for all TUs, so \c CXIndexOpt_SkipParsedBodiesInSession can do its job.
+ * Documents produced from a TU are sent to the \c kate::index::details::writer
+ * as a single batch, or written to a worker's own \c shard (if any) before
+ * that, so the writer gets TU state only.
+ *
+ * TUs given by the indexer's caller (see \c indexer::add_parsed_unit())
+ * are reparsed and indexed w/ \c clang_indexTranslationUnit() instead.
+ *
  * \internal Only \c kate::index::indexer can create instances of this class.
  *
  */
@@ -64,7 +80,7 @@ class worker : public QObject
     Q_OBJECT
 
 public:
-    explicit worker(indexer*);
+    explicit worker(indexer*, shard* = nullptr);
 
     bool is_cancelled() const;
 
@@ -74,31 +90,18 @@ public Q_SLOTS:
 
 Q_SIGNALS:
     void indexing_uri(QString);
+    void unit_indexed(kate::index::unit_stats);
     void message(clang::diagnostic_message);
     void finished();
 
 private:
-    struct declaration_location
-    {
-        fileid m_file_id;
-        int m_line;
-        int m_column;
-        friend bool operator<(
-            const declaration_location& lhs
-          , const declaration_location& rhs
-          )
-        {
-            return lhs.m_file_id < rhs.m_file_id
-              || (lhs.m_file_id == rhs.m_file_id && lhs.m_line < rhs.m_line)
-              || (lhs.m_file_id == rhs.m_file_id && lhs.m_line == rhs.m_line && lhs.m_column < rhs.m_column)
-              ;
-        }
-    };
-
-    bool dispatch_target(const KUrl&);
-    bool dispatch_target(const QFileInfo&);
-    void handle_file(const QString&);
-    void handle_directory(const QString&);
+    void dispatch_target(const QFileInfo&);
+    void handle_file(const QString&, const QFileInfo&);
+    bool is_up_to_date(const QString&, file_state&) const;
+    bool resolve_location(CXIdxLoc, fileid&, unsigned&, unsigned&);
+    bool is_new_location(fileid, unsigned, unsigned);
+    Xapian::docid claim_location(fileid, unsigned, unsigned);
+    Xapian::docid allocate_docid();
 
     template <typename... ClientArgs>
     CXIdxClientContainer update_client_container(ClientArgs&&...);
@@ -111,15 +114,25 @@ private:
     static CXIdxClientContainer on_translation_unit(CXClientData, void*);
     static void on_declaration(CXClientData, const CXIdxDeclInfo*);
     static void on_declaration_reference(CXClientData, const CXIdxEntityRefInfo*);
-    static search_result::flags update_decl_document_with_kind(const CXIdxDeclInfo*, document&);
-    static search_result::flags update_ref_document_with_kind(const CXIdxEntityRefInfo*, document&);
-    static void update_document_with_template_kind(CXIdxEntityCXXTemplateKind, document&);
-    static void update_document_with_type_size(const CXIdxDeclInfo*, document&);
-    static void update_document_with_base_classes(const CXIdxDeclInfo*, document&);
+    bool is_wanted(const CXIdxDeclInfo*) const;
+    search_result::flags update_decl_document_with_kind(const CXIdxDeclInfo*, document&);
+    void update_document_with_base_classes(const CXIdxDeclInfo*, document&);
+    void update_document_with_type_size(const CXIdxDeclInfo*, document&) const;
 
     indexer* const m_indexer;
-    std::vector<std::unique_ptr<container_info>> m_containers;
-    std::map<declaration_location, docref> m_seen_declarations;
+    shard* const m_shard;                                   ///< Own DB to write documents to (if any)
+    clang::DCXIndex m_index;
+    clang::DCXIndexAction m_action;
+    std::set<fileid> m_parsed_headers;                      ///< Headers seen in this session
+    std::set<fileid> m_unit_headers;                        ///< Headers seen in current TU
+    unsigned m_skipped_headers;                             ///< Headers w/ bodies parsed already
+    std::deque<container_info> m_containers;                ///< Arena of current TU containers
+    location_set m_local_locations;                         ///< Locations seen in current TU main file
+    document_batch m_batch;
+    document_builder m_builder;                             ///< Scratch buffers to make documents
+    unit_stats m_stats;                                     ///< Cost of the current TU
+    std::chrono::steady_clock::duration m_callbacks_time;   ///< Time spent in callbacks for the current TU
+    fileid m_main_file_id;
     std::atomic<bool> m_is_cancelled;
 };
 
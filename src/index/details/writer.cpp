@@ -0,0 +1,481 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::writer (implementation)
+ *
+ * \date Fri Oct 16 12:48:15 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "writer.h"
+#include "shard.h"
+#include "../compaction.h"
+#include "../indexer.h"
+#include "../name_index.h"
+#include "../trigram_table.h"
+
+// Standard includes
+#include <KDE/KDebug>
+#include <KDE/KLocalizedString>
+#include <boost/filesystem/operations.hpp>
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace kate { namespace index { namespace details { namespace {
+
+void delete_documents(rw::database& db, const std::vector<docid>& documents)
+{
+    for (const auto did : documents)
+    {
+        try
+        {
+            db.delete_document(did);
+        }
+        catch (const Xapian::DocNotFoundError&)
+        {
+            // Already gone... fine!
+        }
+    }
+}
+
+/// Get names of a document the same way as \c index::collect_declaration_names() does
+void collect_document_names(const Xapian::Document& doc, std::vector<std::string>& names)
+{
+    auto it = doc.termlist_begin();
+    const auto last = doc.termlist_end();
+    for (it.skip_to(term::XDECL); it != last && (*it).compare(0, term::XDECL.size(), term::XDECL) == 0; ++it)
+    {
+        auto name = (*it).substr(term::XDECL.size());
+        if (!name.empty() && name[0] == ':')
+            name.erase(0, 1);
+        if (!name.empty())
+            names.emplace_back(std::move(name));
+    }
+}
+
+}                                                           // anonymous namespace
+
+writer::writer(indexer* const parent)
+  : m_indexer{parent}
+{
+}
+
+void writer::process()
+{
+    kDebug(DEBUG_AREA) << "Index writer thread has started";
+    auto seen_files = std::set<QString>{};
+    auto batch = document_batch{};
+    m_indexer->m_db.set_incomplete(true);
+    // NOTE Updated TUs of a declarations only DB do not make it complete
+    m_indexer->m_db.set_declarations_only(
+        m_indexer->m_declarations_only
+      || (m_indexer->m_incremental && m_indexer->m_db.is_declarations_only())
+      );
+    // NOTE Updated TUs do not make a DB built w/ the current profile
+    if (!m_indexer->m_incremental)
+        m_indexer->m_db.set_profile(m_indexer->m_profile);
+    // References of unchanged TUs are still valid
+    if (m_indexer->m_incremental)
+    {
+        m_references.load(xref_table{xref_table_path(m_indexer->m_db_path.toUtf8().constData())});
+        // ... except ones located in changed headers (includers will add them back)
+        for (const auto file_id : m_indexer->m_changed_headers)
+            m_references.remove_file(file_id);
+    }
+    for (const auto& s : m_indexer->m_shards)
+        m_pending_batches[s.get()].m_committed_docid = s->committed_docid();
+    while (m_indexer->m_batches.pop(batch))
+    {
+        seen_files.insert(batch.m_main_file);
+        auto need_commit = false;
+        if (batch.m_shard)
+        {
+            // NOTE Sharded DB metadata must not refer documents not committed
+            // to shards yet, so checkpoint when some shard has committed
+            m_pending_batches[batch.m_shard].m_batches.emplace_back(std::move(batch));
+            need_commit = store_committed_batches();
+        }
+        else
+        {
+            store_batch(batch);
+            need_commit = (m_indexer->m_commit_documents && m_indexer->m_commit_documents <= m_uncommitted_documents)
+              || (m_indexer->m_commit_bytes && m_indexer->m_commit_bytes <= m_uncommitted_bytes)
+              ;
+        }
+        batch = document_batch{};
+        if (need_commit)
+            checkpoint();
+    }
+
+    if (!m_indexer->is_cancelled())
+    {
+        // Remove TUs not found anymore (only if all targets were visited)
+        if (m_indexer->m_incremental && !m_indexer->m_partial)
+            remove_missed_files(seen_files);
+        // TUs depending on changed headers have been reindexed
+        if (m_indexer->m_incremental)
+            m_indexer->m_db.includes().refresh(m_indexer->m_changed_headers, m_indexer->m_db.headers_map());
+        m_indexer->m_db.set_incomplete(false);
+    }
+    if (!m_indexer->m_shards.empty())
+        merge_shards();
+    else
+    {
+        checkpoint();
+        if (!m_indexer->is_cancelled() && !m_indexer->m_partial)
+            compact_database();
+    }
+    store_trigrams();
+
+    Q_EMIT(finished());
+    kDebug(DEBUG_AREA) << "Index writer thread has finished";
+}
+
+void writer::store_batch(document_batch& batch)
+{
+    auto& manifest = m_indexer->m_db.files_manifest();
+    try
+    {
+        if (!batch.m_unchanged)
+        {
+            // Forget everything produced by a previous version of the TU
+            if (const auto* const prev = manifest.find(batch.m_main_file))
+                delete_documents(m_indexer->m_db, prev->m_documents);
+            for (auto& p : batch.m_documents)
+            {
+                m_indexer->m_db.replace_document(p.first, p.second);
+                m_uncommitted_bytes += approximate_size(p.second);
+                if (m_indexer->m_partial)
+                    collect_document_names(p.second, m_declaration_names);
+            }
+            m_uncommitted_documents += batch.m_documents.size();
+            m_references.remove_file(batch.m_main_file_id);
+            m_references.add(begin(batch.m_references), end(batch.m_references));
+            m_indexer->m_db.includes().update(batch.m_main_file_id, batch.m_includes);
+            for (const auto& p : batch.m_header_documents)
+                manifest.add_header_document(p.first, p.second);
+        }
+        else
+        {
+            // NOTE Keep documents list, but update (possible changed) mtime
+            const auto* const prev = manifest.find(batch.m_main_file);
+            assert("Sanity check" && prev);
+            batch.m_state.m_documents = prev->m_documents;
+            if (batch.m_state.m_hash.empty())
+                batch.m_state.m_hash = prev->m_hash;
+            batch.m_state.m_parse_time = prev->m_parse_time;
+        }
+        manifest.update(batch.m_main_file, std::move(batch.m_state));
+    }
+    catch (const Xapian::Error& e)
+    {
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc(
+                    "@info/plain"
+                  , "Failed to store index of <filename>%1</filename>: %2"
+                  , batch.m_main_file
+                  , e.get_msg().c_str()
+                  )
+              , clang::diagnostic_message::type::error
+              })
+          );
+    }
+}
+
+/**
+ * Batches w/ documents in shards are kept aside until their documents
+ * get committed by shard owners, so a checkpoint never lists TUs whose
+ * documents may be lost by a crash (see \c indexer::recover_shards()).
+ *
+ * \return \c true if some shard has committed since the previous call
+ */
+bool writer::store_committed_batches()
+{
+    auto committed = false;
+    for (auto& p : m_pending_batches)
+    {
+        const auto last_docid = p.first->committed_docid();
+        committed = committed || last_docid != p.second.m_committed_docid;
+        p.second.m_committed_docid = last_docid;
+        auto& batches = p.second.m_batches;
+        while (!batches.empty() && batches.front().m_shard_docid <= last_docid)
+        {
+            store_batch(batches.front());
+            batches.pop_front();
+        }
+    }
+    return committed;
+}
+
+void writer::remove_missed_files(const std::set<QString>& seen_files)
+{
+    auto& manifest = m_indexer->m_db.files_manifest();
+    auto missed = std::vector<QString>{};
+    for (const auto& p : manifest)
+        if (seen_files.find(p.first) == end(seen_files))
+            missed.emplace_back(p.first);
+
+    for (const auto& filename : missed)
+    {
+        kDebug(DEBUG_AREA) << "Removing documents of" << filename;
+        try
+        {
+            delete_documents(m_indexer->m_db, manifest.find(filename)->m_documents);
+            manifest.remove(filename);
+            const HeaderFilesCache& headers = m_indexer->m_db.headers_map();
+            const auto file_id = headers[filename];
+            if (file_id != HeaderFilesCache::NOT_FOUND)
+            {
+                m_references.remove_file(file_id);
+                m_indexer->m_db.includes().remove(file_id);
+            }
+        }
+        catch (const Xapian::Error& e)
+        {
+            kDebug(DEBUG_AREA) << "Fail to remove documents:" << e.get_msg().c_str();
+        }
+    }
+}
+
+/**
+ * Shards are merged into the indexer's DB path (replacing an empty DB there),
+ * then DB metadata collected by the writer is stored to the merged DB.
+ * If indexing has been cancelled, the merged DB is marked as incomplete,
+ * so it can be resumed.
+ */
+void writer::merge_shards()
+{
+    auto& db = m_indexer->m_db;
+    auto sources = std::vector<std::string>{};
+    for (auto& s : m_indexer->m_shards)
+    {
+        s->close();
+        sources.emplace_back(s->path());
+    }
+    // NOTE Batches of shards failed to commit are dropped, so their TUs
+    // are not in the manifest
+    store_committed_batches();
+    m_pending_batches.clear();
+    const auto path = std::string{m_indexer->m_db_path.toUtf8().constData()};
+    try
+    {
+        db.close();
+        const auto stats = compact(path, sources);
+        rw::database merged{db.id(), path};
+        merged.headers_map() = db.headers_map();
+        merged.files_manifest() = db.files_manifest();
+        merged.includes() = db.includes();
+        merged.set_incomplete(m_indexer->is_cancelled());
+        merged.set_declarations_only(db.is_declarations_only());
+        merged.set_profile(db.profile());
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc(
+                    "@info/plain"
+                  , "%1 index shards merged in %2 s: %3 MiB"
+                  , unsigned(sources.size())
+                  , QString::number(stats.m_time / 1000.0, 'f', 1)
+                  , QString::number(stats.m_size_after / (1024.0 * 1024.0), 'f', 1)
+                  )
+              , clang::diagnostic_message::type::info
+              })
+          );
+    }
+    catch (const std::exception& e)
+    {
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc("@info/plain", "Failed to merge index shards: %1", e.what())
+              , clang::diagnostic_message::type::error
+              })
+          );
+    }
+    catch (const Xapian::Error& e)
+    {
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc("@info/plain", "Failed to merge index shards: %1", e.get_msg().c_str())
+              , clang::diagnostic_message::type::error
+              })
+          );
+    }
+    m_indexer->m_shards.clear();
+    boost::system::error_code error;
+    boost::filesystem::remove_all(m_indexer->shards_path(), error);
+    store_references();
+}
+
+/**
+ * DB made by a sequence of checkpoints (or updated incrementally) is
+ * fragmented, so compact it when all targets are done.
+ */
+void writer::compact_database()
+{
+    try
+    {
+        m_indexer->m_db.close();
+        const auto stats = compact(m_indexer->m_db_path.toUtf8().constData());
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc(
+                    "@info/plain"
+                  , "Index compacted in %1 s: %2 MiB -> %3 MiB"
+                  , QString::number(stats.m_time / 1000.0, 'f', 1)
+                  , QString::number(stats.m_size_before / (1024.0 * 1024.0), 'f', 1)
+                  , QString::number(stats.m_size_after / (1024.0 * 1024.0), 'f', 1)
+                  )
+              , clang::diagnostic_message::type::info
+              })
+          );
+    }
+    catch (const std::exception& e)
+    {
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc("@info/plain", "Failed to compact index: %1", e.what())
+              , clang::diagnostic_message::type::error
+              })
+          );
+    }
+    catch (const Xapian::Error& e)
+    {
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc("@info/plain", "Failed to compact index: %1", e.get_msg().c_str())
+              , clang::diagnostic_message::type::error
+              })
+          );
+    }
+}
+
+void writer::checkpoint()
+{
+    kDebug(DEBUG_AREA) << "Checkpoint:" << m_uncommitted_documents << "documents,"
+      << m_uncommitted_bytes << "bytes (approx.)";
+    {
+        // NOTE Workers may add new files to the headers map meanwhile
+        std::lock_guard<std::mutex> lock{m_indexer->m_headers_mutex};
+        m_indexer->m_db.store_meta();
+    }
+    m_indexer->m_db.commit();
+    store_references();
+    m_uncommitted_documents = 0;
+    m_uncommitted_bytes = 0;
+}
+
+/**
+ * The whole table is rewritten, cuz it must match TUs listed in
+ * the (just committed) DB metadata.
+ */
+void writer::store_references()
+{
+    try
+    {
+        const auto size = m_references.write(xref_table_path(m_indexer->m_db_path.toUtf8().constData()));
+        kDebug(DEBUG_AREA) << "References table stored:" << m_references.size() << "references," << size << "bytes";
+    }
+    catch (const std::exception& e)
+    {
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc("@info/plain", "Failed to store references table: %1", e.what())
+              , clang::diagnostic_message::type::error
+              })
+          );
+    }
+}
+
+/**
+ * Names are collected from the (already committed) DB, so the whole table
+ * is rewritten. A table left by a previous run w/ another indexing profile
+ * gets removed if trigrams are not needed anymore.
+ *
+ * Partial update doesn't scan the whole DB: names of stored documents are
+ * added to the existed table. Names gone w/ removed documents are kept
+ * till the next update, which is fine, cuz found names are looked up
+ * in the DB anyway.
+ */
+void writer::store_trigrams()
+{
+    const auto db_path = std::string{m_indexer->m_db_path.toUtf8().constData()};
+    const auto path = trigram_table_path(db_path);
+    if (!m_indexer->m_policy.m_trigrams)
+    {
+        boost::system::error_code error;
+        boost::filesystem::remove(path, error);
+        return;
+    }
+    try
+    {
+        trigram_table_builder builder;
+        auto updated = false;
+        if (m_indexer->m_partial)
+        {
+            const trigram_table table{path};
+            if (table.is_open())
+            {
+                builder.add(table);
+                builder.add(begin(m_declaration_names), end(m_declaration_names));
+                updated = true;
+            }
+        }
+        if (!updated)
+        {
+            const auto names = collect_declaration_names(Xapian::Database{db_path});
+            builder.add(begin(names), end(names));
+        }
+        const auto size = builder.write(path);
+        kDebug(DEBUG_AREA) << "Trigrams table stored:" << builder.size() << "names," << size << "bytes";
+    }
+    catch (const std::exception& e)
+    {
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc("@info/plain", "Failed to store trigrams table: %1", e.what())
+              , clang::diagnostic_message::type::error
+              })
+          );
+    }
+    catch (const Xapian::Error& e)
+    {
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc("@info/plain", "Failed to store trigrams table: %1", e.get_msg().c_str())
+              , clang::diagnostic_message::type::error
+              })
+          );
+    }
+}
+
+}}}                                                         // namespace details, index, kate
@@ -0,0 +1,118 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::writer (interface)
+ *
+ * \date Fri Oct 16 12:48:15 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "document_batch.h"
+#include "../xref_table.h"
+#include "../../clang/diagnostic_message.h"
+
+// Standard includes
+#include <QtCore/QObject>
+#include <cstddef>
+#include <QtCore/QString>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace kate { namespace index {
+
+// fwd decls
+class indexer;
+
+namespace details {
+
+/**
+ * \brief Worker class to store documents produced by parsing workers
+ *
+ * The only instance of this class runs in a dedicated thread and is the
+ * only one who touch the indexer's \c rw::database while indexing is in
+ * progress. It takes per-TU document batches from a queue filled by
+ * \c kate::index::details::worker instances until the queue gets closed.
+ *
+ * Changes are committed periodically (see \c indexer::set_commit_threshold())
+ * together w/ DB metadata, so a manifest in the DB always lists TUs
+ * whose documents are stored. If indexing gets interrupted, it can be
+ * resumed in incremental mode.
+ *
+ * If workers write documents to their own shards, batches carry no documents
+ * and the writer maintains DB metadata only. A batch gets to the metadata
+ * when its documents are committed to a shard, and metadata is checkpointed
+ * when shards commit, so an interrupted sharded build can be resumed as well.
+ * Shards get merged when done. Otherwise a complete DB gets compacted when done.
+ *
+ * References collected by workers are kept in memory and written as
+ * a \c xref_table beside the DB on every checkpoint and when done.
+ * A \c trigram_table of declaration names is written when done. A partial
+ * update just adds names of stored documents to the existed table.
+ *
+ * \internal Only \c kate::index::indexer can create instances of this class.
+ *
+ */
+class writer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit writer(indexer*);
+
+public Q_SLOTS:
+    void process();
+
+Q_SIGNALS:
+    void message(clang::diagnostic_message);
+    void finished();
+
+private:
+    /// Batches waiting for a shard commit
+    struct pending_batches
+    {
+        std::deque<document_batch> m_batches;
+        Xapian::docid m_committed_docid = {0};              ///< The last committed ID seen
+    };
+
+    void store_batch(document_batch&);
+    bool store_committed_batches();
+    void remove_missed_files(const std::set<QString>&);
+    void merge_shards();
+    void compact_database();
+    void checkpoint();
+    void store_references();
+    void store_trigrams();
+
+    indexer* const m_indexer;
+    xref_table_builder m_references;
+    std::map<const shard*, pending_batches> m_pending_batches;
+    std::vector<std::string> m_declaration_names;           ///< Names of stored documents (partial update only)
+    std::size_t m_uncommitted_documents = {0};
+    std::size_t m_uncommitted_bytes = {0};
+};
+
+}}}                                                         // namespace details, index, kate
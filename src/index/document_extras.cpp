@@ -29,6 +29,9 @@
 #include "document_extras.h"
 
 // Standard includes
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 
 namespace kate { namespace index { namespace term {
 const std::string XACCESS = "XC";
@@ -45,5 +48,39 @@ const std::string XREF = "XRF";
 const std::string XSCOPE = "XSC";
 const std::string XSTATIC = "XSTy";
 const std::string XTEMPLATE = "XTP";
+const std::string XUSR = "XU";
 const std::string XVIRTUAL = "XV";
-}}}                                                         // namespace term, index, kate
+}                                                           // namespace term
+
+/// FNV-1a hash of a USR
+std::uint64_t usr_hash(const char* usr)
+{
+    auto hash = std::uint64_t{14695981039346656037ull};
+    for (; *usr; ++usr)
+    {
+        hash ^= static_cast<unsigned char>(*usr);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Xapian limits a term length, but USRs of templates can be really long.
+ * So long USRs are replaced w/ their (FNV-1a) hash. Lookup results must
+ * be checked against the \c value_slot::USR then, to filter collisions.
+ */
+void make_usr_term(const char* const usr, std::string& result)
+{
+    result.assign(term::XUSR);
+    const auto length = std::strlen(usr);
+    if (length <= MAX_USR_TERM_LENGTH)
+    {
+        result.append(usr, length);
+        return;
+    }
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "#%016llx", static_cast<unsigned long long>(usr_hash(usr)));
+    result.append(buffer);
+}
+
+}}                                                          // namespace index, kate
@@ -31,6 +31,8 @@
 
 // Standard includes
 #include <xapian.h>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace kate { namespace index { namespace term {
@@ -47,6 +49,7 @@ extern const std::string XREF;
 extern const std::string XSCOPE;
 extern const std::string XSTATIC;
 extern const std::string XTEMPLATE;
+extern const std::string XUSR;
 extern const std::string XVIRTUAL;
 }                                                           // namespace term
 
@@ -70,6 +73,15 @@ enum class value_slot : Xapian::valueno
   , TEMPLATE
   , TYPE
   , VALUE
+  , USR                                                     ///< \attention Added later, keep it last
 };
 
+/// Max length of a USR to be stored in a term as is
+constexpr std::size_t MAX_USR_TERM_LENGTH = 200;
+
+/// Get a hash of an entity USR (also used as a symbol ID of references table)
+std::uint64_t usr_hash(const char*);
+/// Compose a term to lookup documents by an entity USR
+void make_usr_term(const char*, std::string&);
+
 }}                                                          // namespace index, kate
@@ -0,0 +1,124 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::freshness_manifest (implementation)
+ *
+ * \date Fri Oct 16 15:02:11 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "freshness_manifest.h"
+
+// Standard includes
+#include <boost/archive/archive_exception.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <sstream>
+
+namespace kate { namespace index {
+
+file_state file_state::from_file(const QFileInfo& fi)
+{
+    auto result = file_state{};
+    result.m_mtime = fi.lastModified().toMSecsSinceEpoch();
+    result.m_size = std::uint64_t(fi.size());
+    return result;
+}
+
+/**
+ * \param[in] filename file to read content from
+ * \return \c false if file can't be read
+ */
+bool file_state::update_hash(const QString& filename)
+{
+    QFile file{filename};
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const auto hash = QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1);
+    m_hash.assign(hash.constData(), std::size_t(hash.size()));
+    return true;
+}
+
+std::string freshness_manifest::storeToString() const
+{
+    std::stringstream ofs{std::ios_base::out | std::ios_base::binary};
+    boost::archive::binary_oarchive oa{ofs};
+    const std::size_t count = m_files.size();
+    oa << count;
+    for (const auto& p : m_files)
+    {
+        const std::string filename = p.first.toUtf8().constData();
+        oa << filename << p.second.m_mtime << p.second.m_size << p.second.m_hash << p.second.m_parse_time
+          << p.second.m_documents;
+    }
+    const std::size_t headers_count = m_headers.size();
+    oa << headers_count;
+    for (const auto& p : m_headers)
+        oa << p.first << p.second;
+    return ofs.str();
+}
+
+/**
+ * Manifest stored by a previous version has no header documents,
+ * which is fine: they are just not removed when a header changes.
+ */
+void freshness_manifest::loadFromString(const std::string& raw_data)
+{
+    std::stringstream ifs{raw_data, std::ios_base::in | std::ios_base::binary};
+    boost::archive::binary_iarchive ia{ifs};
+    std::size_t count;
+    ia >> count;
+    m_files.clear();
+    for (auto i = 0u; i < count; ++i)
+    {
+        std::string filename;
+        auto state = file_state{};
+        ia >> filename >> state.m_mtime >> state.m_size >> state.m_hash >> state.m_parse_time
+          >> state.m_documents;
+        m_files.emplace(QString::fromUtf8(filename.c_str()), std::move(state));
+    }
+    m_headers.clear();
+    try
+    {
+        std::size_t headers_count;
+        ia >> headers_count;
+        for (auto i = 0u; i < headers_count; ++i)
+        {
+            fileid file;
+            auto documents = std::vector<docid>{};
+            ia >> file >> documents;
+            m_headers.emplace(file, std::move(documents));
+        }
+    }
+    catch (const boost::archive::archive_exception&)
+    {
+        m_headers.clear();
+    }
+}
+
+}}                                                          // namespace index, kate
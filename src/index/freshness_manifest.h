@@ -0,0 +1,172 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::freshness_manifest (interface)
+ *
+ * \date Fri Oct 16 15:02:11 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "types.h"
+
+// Standard includes
+#include <QtCore/QString>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class QFileInfo;
+
+namespace kate { namespace index {
+
+/**
+ * \brief State of an indexed source file
+ *
+ * Content hash is used to detect a modified file only if a size is the same
+ * but modification time is not. I.e. it saves some time for files just touched
+ * (or checked out again by VCS).
+ */
+struct file_state
+{
+    std::int64_t m_mtime = {0};                             ///< Modification time (ms since epoch)
+    std::uint64_t m_size = {0};                             ///< File size
+    std::string m_hash;                                     ///< SHA1 of file content (if calculated)
+    std::uint32_t m_parse_time = {0};                       ///< Time spent to index the file (ms)
+    std::vector<docid> m_documents;                         ///< Documents located in this file
+
+    /// Make a state from file attributes (w/o hash)
+    static file_state from_file(const QFileInfo&);
+    /// Calculate content hash
+    bool update_hash(const QString&);
+    /// Check if the file looks the same as \c other w/o reading its content
+    bool has_same_attributes(const file_state& other) const
+    {
+        return m_mtime == other.m_mtime && m_size == other.m_size;
+    }
+    /// Make the state match no file, so it gets reindexed next time
+    void invalidate()
+    {
+        m_mtime = 0;
+        m_size = 0;
+        m_hash.clear();
+    }
+};
+
+/**
+ * \brief Per main (source) file freshness information
+ *
+ * Every source file (TU) indexed gets a record here w/ attributes
+ * of the file seen at indexing time and a list of documents located
+ * \b in this file. Declarations located in headers are not owned by any TU
+ * (the first TU met a location produces a document), so they are listed
+ * per header: when a header gets changed, its documents have to be removed
+ * before dependent TUs are reindexed.
+ *
+ * Manifest is stored to index metadata (like headers map) and used to
+ * find changed, new and removed TUs on incremental index update. Recorded
+ * parse times allow to schedule expensive TUs first on the next run.
+ */
+class freshness_manifest
+{
+public:
+    typedef std::map<QString, file_state> map_type;
+    typedef map_type::const_iterator const_iterator;
+    typedef std::map<fileid, std::vector<docid>> headers_map_type;
+
+    /// Get a state of a given file, \c nullptr if not indexed yet
+    const file_state* find(const QString&) const;
+    /// Add or replace a state of a given file
+    void update(const QString&, file_state&&);
+    /// Forget a given file
+    bool remove(const QString&);
+    /// Get documents located in a given header, \c nullptr if there are none
+    const std::vector<docid>* find_header(fileid) const;
+    /// Add a document located in a given header
+    void add_header_document(fileid, docid);
+    /// Forget documents located in a given header
+    bool remove_header(fileid);
+
+    const_iterator begin() const
+    {
+        return m_files.begin();
+    }
+    const_iterator end() const
+    {
+        return m_files.end();
+    }
+    bool isEmpty() const
+    {
+        return m_files.empty();
+    }
+    std::size_t size() const
+    {
+        return m_files.size();
+    }
+    const headers_map_type& headers() const
+    {
+        return m_headers;
+    }
+
+    std::string storeToString() const;
+    void loadFromString(const std::string&);
+
+private:
+    map_type m_files;
+    headers_map_type m_headers;                             ///< Header -> documents located there
+};
+
+inline const file_state* freshness_manifest::find(const QString& filename) const
+{
+    auto it = m_files.find(filename);
+    return it == m_files.end() ? nullptr : &it->second;
+}
+
+inline void freshness_manifest::update(const QString& filename, file_state&& state)
+{
+    m_files[filename] = std::move(state);
+}
+
+inline bool freshness_manifest::remove(const QString& filename)
+{
+    return m_files.erase(filename) != 0;
+}
+
+inline const std::vector<docid>* freshness_manifest::find_header(const fileid file) const
+{
+    auto it = m_headers.find(file);
+    return it == m_headers.end() ? nullptr : &it->second;
+}
+
+inline void freshness_manifest::add_header_document(const fileid file, const docid did)
+{
+    m_headers[file].push_back(did);
+}
+
+inline bool freshness_manifest::remove_header(const fileid file)
+{
+    return m_headers.erase(file) != 0;
+}
+
+}}                                                          // namespace index, kate
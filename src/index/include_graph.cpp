@@ -0,0 +1,190 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::include_graph (implementation)
+ *
+ * \date Fri Oct 16 23:51:37 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "include_graph.h"
+#include "../header_files_cache.h"
+
+// Standard includes
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/set.hpp>
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+#include <sstream>
+
+namespace kate { namespace index {
+
+/**
+ * \param[in] main_file TU the edges are came from
+ * \param[in] edges all \c #include directives met in the TU
+ */
+void include_graph::update(const fileid main_file, const std::vector<include_edge>& edges)
+{
+    auto& own = m_includes[main_file];
+    own.clear();
+    for (const auto& e : edges)
+    {
+        m_includes[e.m_includer].insert(e.m_included);
+        m_mtimes[e.m_included] = e.m_mtime;
+    }
+    if (own.empty())
+        m_includes.erase(main_file);
+}
+
+bool include_graph::remove(const fileid file)
+{
+    m_mtimes.erase(file);
+    return m_includes.erase(file) != 0;
+}
+
+/**
+ * \note Every included file w/ a known state gets checked on disk,
+ * so it takes a \c stat() per file.
+ */
+std::set<fileid> include_graph::changed_files(const HeaderFilesCache& files) const
+{
+    auto result = std::set<fileid>{};
+    for (const auto& p : m_mtimes)
+    {
+        const auto fi = QFileInfo{files[p.first]};
+        if (!fi.exists() || std::int64_t(fi.lastModified().toTime_t()) != p.second)
+            result.insert(p.first);
+    }
+    return result;
+}
+
+/**
+ * Changed files which still exist get their current modification time,
+ * so they are not reported by \c changed_files() anymore. Files not found
+ * are forgotten along w/ edges to them, as well as files not included
+ * by anything anymore.
+ *
+ * \param[in] files changed files (see \c changed_files()) handled already
+ * \param[in] cache mapping of file IDs to filenames
+ */
+void include_graph::refresh(const std::set<fileid>& files, const HeaderFilesCache& cache)
+{
+    auto missed = std::set<fileid>{};
+    for (const auto file : files)
+    {
+        const auto fi = QFileInfo{cache[file]};
+        if (!fi.exists())
+            missed.insert(file);
+        else
+        {
+            auto it = m_mtimes.find(file);
+            if (it != end(m_mtimes))
+                it->second = std::int64_t(fi.lastModified().toTime_t());
+        }
+    }
+
+    auto included = std::set<fileid>{};
+    for (auto it = begin(m_includes); it != end(m_includes);)
+    {
+        if (missed.find(it->first) == end(missed))
+        {
+            for (const auto file : missed)
+                it->second.erase(file);
+            included.insert(begin(it->second), end(it->second));
+        }
+        else
+            it->second.clear();
+        if (it->second.empty())
+            it = m_includes.erase(it);
+        else
+            ++it;
+    }
+
+    for (auto it = begin(m_mtimes); it != end(m_mtimes);)
+        if (included.find(it->first) == end(included))
+            it = m_mtimes.erase(it);
+        else
+            ++it;
+}
+
+std::set<fileid> include_graph::dependents(const std::set<fileid>& files) const
+{
+    // Reverse edges: included file -> includers
+    auto includers = std::map<fileid, std::vector<fileid>>{};
+    for (const auto& p : m_includes)
+        for (const auto included : p.second)
+            includers[included].push_back(p.first);
+
+    // NOTE Already collected files are not visited again, so cycles are fine
+    auto result = files;
+    auto pending = std::vector<fileid>(begin(files), end(files));
+    while (!pending.empty())
+    {
+        const auto file = pending.back();
+        pending.pop_back();
+        auto it = includers.find(file);
+        if (it == end(includers))
+            continue;
+        for (const auto includer : it->second)
+            if (result.insert(includer).second)
+                pending.push_back(includer);
+    }
+    return result;
+}
+
+std::set<fileid> include_graph::included_files(const std::set<fileid>& files) const
+{
+    // NOTE Already collected files are not visited again, so cycles are fine
+    auto result = std::set<fileid>{};
+    auto pending = std::vector<fileid>(begin(files), end(files));
+    while (!pending.empty())
+    {
+        const auto file = pending.back();
+        pending.pop_back();
+        auto it = m_includes.find(file);
+        if (it == end(m_includes))
+            continue;
+        for (const auto included : it->second)
+            if (result.insert(included).second)
+                pending.push_back(included);
+    }
+    return result;
+}
+
+std::string include_graph::storeToString() const
+{
+    std::stringstream ofs{std::ios_base::out | std::ios_base::binary};
+    boost::archive::binary_oarchive oa{ofs};
+    oa << m_includes << m_mtimes;
+    return ofs.str();
+}
+
+void include_graph::loadFromString(const std::string& raw_data)
+{
+    std::stringstream ifs{raw_data, std::ios_base::in | std::ios_base::binary};
+    boost::archive::binary_iarchive ia{ifs};
+    ia >> m_includes >> m_mtimes;
+}
+
+}}                                                          // namespace index, kate
@@ -0,0 +1,101 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::include_graph (interface)
+ *
+ * \date Fri Oct 16 23:51:37 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "types.h"
+
+// Standard includes
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace kate {
+class HeaderFilesCache;                                     // fwd decl
+namespace index {
+
+/// \c #include directive met while indexing a TU
+struct include_edge
+{
+    fileid m_includer;                                      ///< File w/ the directive
+    fileid m_included;                                      ///< File included
+    std::int64_t m_mtime;                                   ///< Modification time of included file (s since epoch)
+};
+
+/**
+ * \brief Include edges between indexed files
+ *
+ * Every includer file (a TU or a header) has a set of files it includes
+ * directly, and every included file has a modification time seen by
+ * \c libclang when it was parsed last time. When some headers have been
+ * changed, TUs depending on them (transitively) have to be reindexed.
+ *
+ * Includes of a TU main file are replaced every time the TU gets indexed.
+ * Includes of headers are merged instead, cuz a header may include different
+ * files in different TUs (depending on macros). So stale edges of headers
+ * may cause some extra TUs to be reindexed, but never less than required.
+ *
+ * Graph is stored to index metadata (like a files manifest).
+ */
+class include_graph
+{
+public:
+    /// Update edges (and included files state) seen while indexing a given TU
+    void update(fileid, const std::vector<include_edge>&);
+    /// Forget includes of a given (removed) file
+    bool remove(fileid);
+    /// Get files changed since they were parsed last time (or removed)
+    std::set<fileid> changed_files(const HeaderFilesCache&) const;
+    /// Update state of changed files after TUs depending on them were reindexed
+    void refresh(const std::set<fileid>&, const HeaderFilesCache&);
+    /// Get given files and all files including them (transitively)
+    std::set<fileid> dependents(const std::set<fileid>&) const;
+    /// Get all files included by given files (transitively)
+    std::set<fileid> included_files(const std::set<fileid>&) const;
+
+    bool isEmpty() const
+    {
+        return m_includes.empty();
+    }
+    /// Get a number of includer files
+    std::size_t size() const
+    {
+        return m_includes.size();
+    }
+
+    std::string storeToString() const;
+    void loadFromString(const std::string&);
+
+private:
+    std::map<fileid, std::set<fileid>> m_includes;          ///< Includer -> included files
+    std::map<fileid, std::int64_t> m_mtimes;                ///< Included file -> modification time
+};
+
+}}                                                          // namespace index, kate
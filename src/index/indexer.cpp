@@ -27,54 +27,149 @@
 
 // Project specific includes
 #include "indexer.h"
+#include "details/discovery.h"
+#include "details/shard.h"
 #include "details/worker.h"
+#include "details/writer.h"
 
 // Standard includes
+#include <boost/filesystem/operations.hpp>
 #include <KDE/KDebug>
+#include <KDE/KLocalizedString>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
 #include <QtCore/QThread>
+#include <algorithm>
+#include <limits>
+#include <utility>
 
-namespace kate { namespace index {
+namespace kate { namespace index { namespace {
+/// Max number of parsed TUs waiting for the writer
+const std::size_t MAX_PENDING_BATCHES = 64;
+/// Suffix of a directory (next to DB) w/ per worker shards
+const std::string SHARDS_SUFFIX = ".shards";
+
+inline std::uint64_t milliseconds_since(const std::chrono::steady_clock::time_point start)
+{
+    return std::uint64_t(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start
+          ).count()
+      );
+}
+}                                                           // anonymous namespace
 
 indexer::indexer(const dbid id, const std::string& path)
-  : m_index{clang_createIndex(1, 1)}
-  , m_db{id, path}
+  : m_db{id, path}
+  , m_db_path{QString::fromUtf8(path.c_str())}
+  , m_batches{MAX_PENDING_BATCHES}
+  , m_last_docid{m_db.get_lastdocid()}
+  , m_skipped_headers{0}
+  , m_total_files{0}
+  , m_processed_files{0}
 {
+    qRegisterMetaType<unit_stats>("kate::index::unit_stats");
+    qRegisterMetaType<indexing_stats>("kate::index::indexing_stats");
 }
 
 indexer::~indexer()
 {
-    if (m_worker_thread)
+    if (m_running_threads)
     {
         stop();
-        m_worker_thread->quit();
-        m_worker_thread->wait();
+        m_batches.close();
+        for (auto& t : m_worker_threads)
+        {
+            t->quit();
+            t->wait();
+        }
+        m_writer_thread->quit();
+        m_writer_thread->wait();
+        m_discovery_thread->quit();
+        m_discovery_thread->wait();
     }
 }
 
+/**
+ * Preparation of an incremental update scans the whole DB, so it is done
+ * by a discovery thread (see \c prepare()). Parsing workers wait for
+ * targets meanwhile, and the writer gets started when preparation is done.
+ */
 void indexer::start()
 {
-    auto* const t = new QThread{};
-    auto* const w = new details::worker{this};
-    connect(w, SIGNAL(message(clang::diagnostic_message)), this, SLOT(message_slot(clang::diagnostic_message)));
-    connect(w, SIGNAL(indexing_uri(QString)), this, SLOT(indexing_uri_slot(QString)));
-    connect(w, SIGNAL(finished()), this, SLOT(worker_finished_slot()));
-    connect(this, SIGNAL(stopping()), w, SLOT(request_cancel()));
+    m_start_time = std::chrono::steady_clock::now();
+    // NOTE Workers should wait for files being discovered
+    m_targets_queue.hold();
+
+    // Start looking for files to index
+    {
+        auto* const t = new QThread{};
+        auto* const d = new details::discovery{this};
+        connect(d, SIGNAL(prepared()), this, SLOT(discovery_prepared_slot()));
+        connect(d, SIGNAL(finished()), this, SLOT(discovery_finished_slot()));
+        connect(this, SIGNAL(stopping()), d, SLOT(request_cancel()), Qt::DirectConnection);
+        connect(d, SIGNAL(finished()), t, SLOT(quit()));
+        connect(d, SIGNAL(finished()), d, SLOT(deleteLater()));
+
+        connect(t, SIGNAL(started()), d, SLOT(process()));
+        connect(t, SIGNAL(finished()), this, SLOT(thread_finished_slot()));
+        d->moveToThread(t);
+        t->setObjectName("IndexDiscovery");
+        m_discovery_thread.reset(t);
+    }
 
-    connect(w, SIGNAL(finished()), t, SLOT(quit()));
-    connect(w, SIGNAL(finished()), w, SLOT(deleteLater()));
+    // Start the only writer
+    {
+        auto* const t = new QThread{};
+        auto* const w = new details::writer{this};
+        connect(w, SIGNAL(message(clang::diagnostic_message)), this, SLOT(message_slot(clang::diagnostic_message)));
+        connect(w, SIGNAL(finished()), t, SLOT(quit()));
+        connect(w, SIGNAL(finished()), w, SLOT(deleteLater()));
+
+        connect(t, SIGNAL(started()), w, SLOT(process()));
+        connect(t, SIGNAL(finished()), this, SLOT(thread_finished_slot()));
+        w->moveToThread(t);
+        t->setObjectName("IndexWriter");
+        m_writer_thread.reset(t);
+    }
+
+    // Start parsing workers
+    const auto jobs = m_jobs ? m_jobs : unsigned(std::max(QThread::idealThreadCount(), 1));
+    make_shards(jobs);
+    kDebug(DEBUG_AREA) << "Starting" << jobs << "indexing workers," << m_shards.size() << "shards";
+    for (auto i = 0u; i < jobs; ++i)
+    {
+        auto* const t = new QThread{};
+        auto* const w = new details::worker{this, m_shards.empty() ? nullptr : m_shards[i].get()};
+        connect(w, SIGNAL(message(clang::diagnostic_message)), this, SLOT(message_slot(clang::diagnostic_message)));
+        connect(w, SIGNAL(indexing_uri(QString)), this, SLOT(indexing_uri_slot(QString)));
+        connect(w, SIGNAL(unit_indexed(kate::index::unit_stats)), this, SLOT(unit_indexed_slot(kate::index::unit_stats)));
+        connect(w, SIGNAL(finished()), this, SLOT(worker_finished_slot()));
+        // NOTE Worker is busy in its thread and can't process queued
+        // events, so cancel request must be delivered directly.
+        connect(this, SIGNAL(stopping()), w, SLOT(request_cancel()), Qt::DirectConnection);
 
-    connect(t, SIGNAL(started()), w, SLOT(process()));
-    connect(t, SIGNAL(finished()), t, SLOT(deleteLater()));
-    connect(t, SIGNAL(finished()), this, SLOT(thread_finished_slot()));
-    w->moveToThread(t);
-    t->setObjectName("Indexer");
-    t->start();
-    m_worker_thread.reset(t);
+        connect(w, SIGNAL(finished()), t, SLOT(quit()));
+        connect(w, SIGNAL(finished()), w, SLOT(deleteLater()));
+
+        connect(t, SIGNAL(started()), w, SLOT(process()));
+        connect(t, SIGNAL(finished()), this, SLOT(thread_finished_slot()));
+        w->moveToThread(t);
+        t->setObjectName(QString{"Indexer-%1"}.arg(i));
+        m_worker_threads.emplace_back(t);
+    }
+
+    m_running_workers = jobs;
+    m_running_threads = jobs + 2;
+    m_discovery_thread->start();
+    for (auto& t : m_worker_threads)
+        t->start(m_low_priority ? QThread::LowestPriority : QThread::InheritPriority);
 }
 
 void indexer::stop()
 {
     kDebug(DEBUG_AREA) << "Emitting STOP!";
+    m_targets_queue.cancel();
     Q_EMIT(stopping());
 }
 
@@ -85,19 +180,494 @@ void indexer::message_slot(clang::diagnostic_message msg)
 
 void indexer::worker_finished_slot()
 {
-    m_worker_thread->quit();
+    // Let the writer know that no more documents will come
+    if (!--m_running_workers)
+        m_batches.close();
 }
 
 void indexer::thread_finished_slot()
 {
-    m_worker_thread->wait();
-    m_worker_thread.reset();
+    if (--m_running_threads)
+        return;
+
+    for (auto& t : m_worker_threads)
+        t->wait();
+    m_worker_threads.clear();
+    m_writer_thread->wait();
+    m_writer_thread.reset();
+    m_discovery_thread->wait();
+    m_discovery_thread.reset();
+    kDebug(DEBUG_AREA) << "Headers w/ skipped function bodies:" << m_skipped_headers;
+    m_stats.m_elapsed = milliseconds_since(m_start_time);
+    if (!write_stats_file(QDir{m_db_path}.filePath(STATS_FILE), std::move(m_units_stats), m_stats))
+        kDebug(DEBUG_AREA) << "Unable to write indexing statistics to" << m_db_path;
+    Q_EMIT(
+        message({
+            clang::location{}
+          , i18nc(
+                "@info/plain"
+              , "Indexed %1 file(s): %2 declaration(s), %3 reference(s), %4 document(s); %5 files/s, %6 declarations/s"
+              , m_stats.m_files
+              , qulonglong(m_stats.m_declarations)
+              , qulonglong(m_stats.m_references)
+              , qulonglong(m_stats.m_documents)
+              , QString::number(m_stats.files_per_second(), 'f', 1)
+              , QString::number(m_stats.declarations_per_second(), 'f', 0)
+              )
+          , clang::diagnostic_message::type::info
+          })
+      );
+    if (m_indexing_options & CXIndexOpt_SkipParsedBodiesInSession)
+        Q_EMIT(
+            message({
+                clang::location{}
+              , i18nc(
+                    "@info/plain"
+                  , "Function bodies of %1 already parsed header(s) were skipped"
+                  , unsigned(m_skipped_headers)
+                  )
+              , clang::diagnostic_message::type::info
+              })
+          );
     Q_EMIT(finished());
 }
 
 void indexer::indexing_uri_slot(const QString file)
 {
+    report_progress();
     Q_EMIT(indexing_uri(file));
 }
 
+void indexer::unit_indexed_slot(const unit_stats stats)
+{
+    m_stats.add(stats);
+    m_stats.m_elapsed = milliseconds_since(m_start_time);
+    m_units_stats.emplace_back(stats);
+    Q_EMIT(unit_indexed(stats, m_stats));
+}
+
+void indexer::discovery_prepared_slot()
+{
+    m_writer_thread->start();
+}
+
+void indexer::discovery_finished_slot()
+{
+    m_discovery_done = true;
+    report_progress();
+}
+
+/**
+ * Time to finish estimated from an average time spent per file so far,
+ * so it is not available until all files are discovered.
+ */
+void indexer::report_progress()
+{
+    const auto processed = unsigned(m_processed_files);
+    const auto total = m_discovery_done ? std::max(unsigned(m_total_files), processed) : 0u;
+    auto eta = 0u;
+    if (total && processed)
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - m_start_time
+          ).count();
+        eta = unsigned(elapsed * (total - processed) / processed);
+    }
+    Q_EMIT(progress(processed, total, eta));
+}
+
+/**
+ * A TU parsed by a caller gets reparsed (from saved files) and indexed
+ * instead of parsing a source file from scratch. It is much cheaper, cuz
+ * a precompiled preamble of the TU (if any) is reused. However, TU must be
+ * parsed w/ the same options as the indexer has, so files w/ their own
+ * options in a compilation database are parsed as usual.
+ *
+ * \attention The indexer doesn't own given TUs, but a caller must not
+ * touch them until \c finished() is emitted.
+ */
+indexer& indexer::add_parsed_unit(const QString& filename, CXTranslationUnit unit)
+{
+    m_parsed_units[QFileInfo{filename}.canonicalFilePath()] = unit;
+    return *this;
+}
+
+fileid indexer::get_file_id(const QString& filename)
+{
+    std::lock_guard<std::mutex> lock{m_headers_mutex};
+    return m_db.headers_map()[filename];
+}
+
+/**
+ * Make sure the same source file is not parsed twice (e.g. when it is listed in
+ * a compilation database and found in a target directory as well).
+ *
+ * \return \c false if the file has been taken by some worker already
+ */
+bool indexer::claim_file(const QString& filename)
+{
+    std::lock_guard<std::mutex> lock{m_files_mutex};
+    return m_claimed_files.insert(filename).second;
+}
+
+/**
+ * Check if a declaration (or reference) at the given location was seen already,
+ * and if it wasn't, mark it as seen. So only one worker can produce a document
+ * for a location.
+ *
+ * \note Only locations from headers need to be shared between workers.
+ *
+ * \return \c false if the location has been claimed already
+ */
+bool indexer::claim_location(const fileid file, const unsigned line, const unsigned column)
+{
+    std::lock_guard<std::mutex> lock{m_seen_mutex};
+    return m_seen_declarations.insert(file, line, column);
+}
+
+std::string indexer::shards_path() const
+{
+    return m_db_path.toUtf8().constData() + SHARDS_SUFFIX;
+}
+
+/**
+ * Shards are used only to build a fresh index by few workers: incremental
+ * updates have to replace documents in the existing DB. The rest document
+ * IDs space is split into equal ranges, one per shard.
+ */
+void indexer::make_shards(const unsigned count)
+{
+    if (m_incremental)
+        return;
+
+    const auto path = boost::filesystem::path{shards_path()};
+    boost::system::error_code error;
+    boost::filesystem::remove_all(path, error);             // Possible leftovers of a crashed indexer
+    if (count < 2 || m_db.get_doccount())
+        return;
+
+    boost::filesystem::create_directories(path, error);
+    if (error)
+    {
+        kDebug(DEBUG_AREA) << "Can't make shards directory:" << error.message().c_str();
+        return;
+    }
+
+    const auto first = Xapian::docid(m_last_docid);
+    const auto range = (std::numeric_limits<Xapian::docid>::max() - first) / count;
+    try
+    {
+        for (auto i = 0u; i < count; ++i)
+            m_shards.emplace_back(
+                new details::shard{
+                    (path / std::to_string(i)).string()
+                  , first + i * range + 1
+                  , first + (i + 1) * range
+                  , m_commit_documents
+                  , m_commit_bytes
+                  }
+              );
+    }
+    catch (const exception::database_failure& e)
+    {
+        kDebug(DEBUG_AREA) << "Can't make shards, use a single DB:" << e.what();
+        m_shards.clear();
+    }
+}
+
+/**
+ * Called by a discovery thread before any target is scheduled and before
+ * the writer has started, so nothing else touches the DB meanwhile.
+ */
+void indexer::prepare()
+{
+    if (m_incremental)
+    {
+        recover_shards();
+        m_previous_manifest = m_db.files_manifest();
+        find_outdated_units();
+        remove_changed_headers();
+        load_seen_locations();
+    }
+    // NOTE Partial update has its targets only to parse, and TUs w/
+    // changed headers, cuz documents located in these headers are gone
+    if (!m_partial)
+    {
+        schedule_compile_commands();
+        m_total_files = unsigned(m_compile_commands.size());
+    }
+    else
+    {
+        for (const auto& filename : m_outdated_units)
+            m_targets_queue.push(filename);
+        m_total_files = unsigned(m_outdated_units.size());
+    }
+}
+
+/**
+ * Metadata of a fresh index built into shards is checkpointed to the indexer's
+ * DB, but documents are in shards until they get merged. If that build has
+ * been interrupted, documents listed in the manifest are moved to the DB
+ * before it gets updated incrementally (i.e. resumed). Documents committed
+ * to shards after the last checkpoint are not listed, so their TUs get
+ * reindexed. Shards left beside a complete DB are just removed.
+ */
+void indexer::recover_shards()
+{
+    const auto path = boost::filesystem::path{shards_path()};
+    boost::system::error_code error;
+    if (!boost::filesystem::is_directory(path, error))
+        return;
+
+    if (ro::database::is_incomplete(m_db_path.toUtf8().constData()))
+    {
+        const auto& manifest = m_db.files_manifest();
+        auto listed = std::vector<Xapian::docid>{};
+        for (const auto& p : manifest)
+            listed.insert(end(listed), begin(p.second.m_documents), end(p.second.m_documents));
+        for (const auto& p : manifest.headers())
+            listed.insert(end(listed), begin(p.second), end(p.second));
+        std::sort(begin(listed), end(listed));
+
+        auto count = std::size_t{};
+        for (
+            auto it = boost::filesystem::directory_iterator{path, error}
+          , last = boost::filesystem::directory_iterator{}
+          ; !error && it != last
+          ; it.increment(error)
+          )
+        {
+            try
+            {
+                auto shard = Xapian::Database{it->path().string()};
+                for (auto did_it = shard.postlist_begin(""), did_last = shard.postlist_end(""); did_it != did_last; ++did_it)
+                {
+                    if (!std::binary_search(begin(listed), end(listed), *did_it))
+                        continue;
+                    m_db.replace_document(*did_it, shard.get_document(*did_it));
+                    ++count;
+                }
+            }
+            catch (const Xapian::Error& e)
+            {
+                /// \todo Forget TUs w/ lost documents
+                Q_EMIT(
+                    message({
+                        clang::location{}
+                      , i18nc(
+                            "@info/plain"
+                          , "Failed to recover index shard %1: %2"
+                          , QString::fromUtf8(it->path().string().c_str())
+                          , e.get_msg().c_str()
+                          )
+                      , clang::diagnostic_message::type::error
+                      })
+                  );
+            }
+        }
+        m_db.commit();
+        m_last_docid = std::max(Xapian::docid(m_last_docid), m_db.get_lastdocid());
+        kDebug(DEBUG_AREA) << count << "documents recovered from shards of an interrupted indexing";
+    }
+    boost::filesystem::remove_all(path, error);
+}
+
+/**
+ * Documents located in TUs (main files) will be produced again only
+ * if TU gets reparsed. But declarations from headers must not be added
+ * twice, so mark locations of all documents not owned by any TU as seen,
+ * except changed headers (see \c remove_changed_headers()).
+ */
+void indexer::load_seen_locations()
+{
+    if (m_partial && load_seen_locations_of_targets())
+        return;
+
+    auto owned = std::vector<Xapian::docid>{};
+    for (const auto& p : m_previous_manifest)
+        owned.insert(end(owned), begin(p.second.m_documents), end(p.second.m_documents));
+    std::sort(begin(owned), end(owned));
+
+    try
+    {
+        auto line_it = m_db.valuestream_begin(Xapian::valueno(value_slot::LINE));
+        auto column_it = m_db.valuestream_begin(Xapian::valueno(value_slot::COLUMN));
+        for (
+            auto file_it = m_db.valuestream_begin(Xapian::valueno(value_slot::FILE))
+          , last = m_db.valuestream_end(Xapian::valueno(value_slot::FILE))
+          ; file_it != last
+          ; ++file_it
+          )
+        {
+            const auto did = file_it.get_docid();
+            if (std::binary_search(begin(owned), end(owned), did))
+                continue;
+            const auto file_id = fileid(Xapian::sortable_unserialise(*file_it));
+            if (m_changed_headers.find(file_id) != end(m_changed_headers))
+                continue;
+            line_it.skip_to(did);
+            column_it.skip_to(did);
+            if (line_it.get_docid() != did || column_it.get_docid() != did)
+                continue;
+            m_seen_declarations.insert(
+                file_id
+              , unsigned(Xapian::sortable_unserialise(*line_it))
+              , unsigned(Xapian::sortable_unserialise(*column_it))
+              );
+        }
+    }
+    catch (const Xapian::Error& e)
+    {
+        kDebug(DEBUG_AREA) << "Fail to load seen locations:" << e.get_msg().c_str();
+    }
+    kDebug(DEBUG_AREA) << "Loaded" << m_seen_declarations.size() << "seen locations";
+}
+
+/**
+ * Partial update reparses few TUs only, so just headers they include
+ * (according to the include graph) may have locations to be met again.
+ * Their documents are listed in the manifest, so it takes time proportional
+ * to these headers, not to the whole DB.
+ *
+ * \return \c false if included headers of some target are unknown
+ * (e.g. a new TU or a DB made by an older version)
+ */
+bool indexer::load_seen_locations_of_targets()
+{
+    const auto& manifest = m_db.files_manifest();
+    const auto& includes = m_db.includes();
+    const HeaderFilesCache& files = m_db.headers_map();
+    if (manifest.headers().empty() || includes.isEmpty())
+        return false;
+
+    auto units = std::set<fileid>{};
+    for (const auto& filename : m_outdated_units)
+        units.insert(files[filename]);
+    for (const auto& target : m_targets)
+    {
+        const auto filename = target.toLocalFile();
+        // NOTE Saved headers are not parsed on their own (see find_outdated_units())
+        if (!details::targets_scanner::is_source_suffix(QFileInfo{filename}.suffix()))
+            continue;
+        const auto file_id = files[filename];
+        if (file_id == HeaderFilesCache::NOT_FOUND || !m_previous_manifest.find(filename))
+            return false;
+        units.insert(file_id);
+    }
+
+    auto count = std::size_t{};
+    try
+    {
+        for (const auto file_id : includes.included_files(units))
+        {
+            if (m_changed_headers.find(file_id) != end(m_changed_headers))
+                continue;
+            const auto* const documents = manifest.find_header(file_id);
+            if (!documents)
+                continue;
+            for (const auto did : *documents)
+            {
+                const auto doc = m_db.get_document(did);
+                m_seen_declarations.insert(
+                    file_id
+                  , unsigned(Xapian::sortable_unserialise(doc.get_value(Xapian::valueno(value_slot::LINE))))
+                  , unsigned(Xapian::sortable_unserialise(doc.get_value(Xapian::valueno(value_slot::COLUMN))))
+                  );
+                ++count;
+            }
+        }
+    }
+    catch (const Xapian::Error& e)
+    {
+        kDebug(DEBUG_AREA) << "Fail to load seen locations of targets:" << e.get_msg().c_str();
+        m_seen_declarations = details::location_set{};
+        return false;
+    }
+    kDebug(DEBUG_AREA) << "Loaded" << count << "seen locations of" << units.size() << "targets";
+    return true;
+}
+
+/**
+ * Workers check TUs for modifications, but TUs w/o changes may include
+ * (transitively) headers modified since the previous run, so they have
+ * to be reindexed as well.
+ */
+void indexer::find_outdated_units()
+{
+    const auto& includes = m_db.includes();
+    const HeaderFilesCache& files = m_db.headers_map();
+    m_changed_headers = includes.changed_files(files);
+    for (const auto file_id : includes.dependents(m_changed_headers))
+    {
+        const auto filename = files[file_id];
+        if (m_previous_manifest.find(filename))
+            m_outdated_units.insert(filename);
+    }
+    kDebug(DEBUG_AREA) << m_outdated_units.size() << "TUs include changed headers";
+}
+
+/**
+ * Documents located in a changed header are not owned by any TU, so
+ * they are removed here, before TUs depending on the header get reindexed
+ * and produce new versions of them (see \c find_outdated_units()).
+ */
+void indexer::remove_changed_headers()
+{
+    auto& manifest = m_db.files_manifest();
+    auto count = std::size_t{};
+    for (const auto file_id : m_changed_headers)
+    {
+        const auto* const documents = manifest.find_header(file_id);
+        if (!documents)
+            continue;
+        for (const auto did : *documents)
+        {
+            try
+            {
+                m_db.delete_document(did);
+                ++count;
+            }
+            catch (const Xapian::DocNotFoundError&)
+            {
+                // Already gone... fine!
+            }
+            catch (const Xapian::Error& e)
+            {
+                kDebug(DEBUG_AREA) << "Fail to remove document of a changed header:" << e.get_msg().c_str();
+            }
+        }
+        manifest.remove_header(file_id);
+    }
+    kDebug(DEBUG_AREA) << count << "documents of" << m_changed_headers.size() << "changed files removed";
+}
+
+/**
+ * Add files from a compilation database to the work list, the most
+ * expensive first. Files w/o recorded parse time (never indexed before)
+ * go first, cuz nothing is known about them.
+ */
+void indexer::schedule_compile_commands()
+{
+    auto files = std::vector<std::pair<std::uint32_t, QString>>{};
+    files.reserve(m_compile_commands.size());
+    for (const auto& p : m_compile_commands)
+    {
+        const auto* const prev = m_previous_manifest.find(p.first);
+        files.emplace_back(
+            prev && prev->m_parse_time ? prev->m_parse_time : std::numeric_limits<std::uint32_t>::max()
+          , p.first
+          );
+    }
+    std::stable_sort(
+        begin(files)
+      , end(files)
+      , [](const std::pair<std::uint32_t, QString>& lhs, const std::pair<std::uint32_t, QString>& rhs)
+        {
+            return lhs.first > rhs.first;
+        }
+      );
+    for (const auto& p : files)
+        m_targets_queue.push(p.second);
+}
+
 }}                                                          // namespace index, kate
@@ -29,27 +29,70 @@
 
 // Project specific includes
 #include "database.h"
+#include "indexing_profile.h"
+#include "indexing_stats.h"
 #include "search_result.h"
 #include "types.h"
+#include "details/blocking_queue.h"
+#include "details/document_batch.h"
+#include "details/location_set.h"
+#include "details/targets_queue.h"
+#include "../clang/compilation_database.h"
 #include "../clang/disposable.h"
 #include "../clang/diagnostic_message.h"
 
 // Standard includes
 #include <KDE/KUrl>
+#include <QtCore/QStringList>
+#include <atomic>
+#include <chrono>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <vector>
 
 class QThread;
 
 namespace kate { namespace index { namespace details {
+class discovery;                                            // fwd decl
+class shard;                                                // fwd decl
 class worker;                                               // fwd decl
+class writer;                                               // fwd decl
 }                                                           // namespace details
 
 
 /**
  * \brief Class to index C/C++ sources into a searchable databse
  *
- * [More detailed description here]
+ * Targets are parsed by a pool of \c details::worker instances, each in
+ * its own thread w/ its own \c CXIndex. Workers send per-TU batches of
+ * documents to the only \c details::writer thread which owns the database.
+ *
+ * Source files listed in a compilation database (if given) are parsed w/
+ * their own compiler options, others (found in targets) w/ global ones.
+ * The former are scheduled before any other targets, the most expensive
+ * first (according to parse times recorded by a previous run), so the
+ * last running workers have less work to finish. Meanwhile, targets are
+ * scanned for source files by a \c details::discovery thread.
+ *
+ * A fresh index is built by few workers into their own shards (separate
+ * DBs w/ disjoint ranges of document IDs), merged into a single DB when
+ * done. So workers don't wait for each other to store their documents.
+ * DB metadata is checkpointed as usual, listing only documents committed
+ * to shards, so an interrupted build can be resumed.
+ *
+ * Indexing can be done in two passes: a fast one, w/ function bodies skipped
+ * and declarations only (see \c set_declarations_only()), to make the index
+ * searchable ASAP, and a complete one (w/ references) in a background later.
+ *
+ * In incremental mode, TUs including (transitively) headers changed since
+ * the previous run are reindexed as well (see \c include_graph), and
+ * documents located in changed headers are replaced.
+ *
+ * Files already parsed by a caller (e.g. by the code completer) can be indexed
+ * from their TUs (see \c add_parsed_unit()), so no fresh parse required.
  *
  */
 class indexer : public QObject
@@ -62,14 +105,35 @@ public:
         stopped
       , running
     };
+    /// \name Default checkpoint thresholds
+    //@{
+    static constexpr std::size_t DEFAULT_COMMIT_DOCUMENTS = 100000;
+    static constexpr std::size_t DEFAULT_COMMIT_BYTES = 64 * 1024 * 1024;
+    //@}
     /// Construct an indexer from database path
     indexer(dbid, const std::string&);
     /// Cleanup everything
     ~indexer();
 
     indexer& set_compiler_options(std::vector<const char*>&&);
+    indexer& set_compile_commands(std::vector<clang::compile_command>&&);
+    indexer& set_previous_manifest(const freshness_manifest&);
     indexer& set_indexing_options(unsigned);
+    indexer& set_jobs_count(unsigned);
+    indexer& set_incremental(bool);
+    indexer& set_partial(bool);
+    indexer& set_declarations_only(bool);
+    indexer& set_profile(indexing_profile);
+    indexer& set_low_priority(bool);
+    indexer& set_commit_threshold(std::size_t, std::size_t);
+    indexer& set_excluded_directories(const QStringList&);
     indexer& add_target(const KUrl&);
+    indexer& add_parsed_unit(const QString&, CXTranslationUnit);
+
+    /// Get a number of headers w/ already parsed function bodies met while indexing
+    unsigned skipped_headers_count() const;
+    /// Check if indexing has been stopped before all targets are done
+    bool is_cancelled();
 
     static unsigned default_indexing_options();
 
@@ -79,25 +143,88 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void indexing_uri_slot(QString);
+    void discovery_prepared_slot();
+    void discovery_finished_slot();
+    void unit_indexed_slot(kate::index::unit_stats);
     void worker_finished_slot();
     void thread_finished_slot();
     void message_slot(clang::diagnostic_message);
 
 Q_SIGNALS:
     void indexing_uri(QString);
+    /// Files processed, total files (\c 0 if not known yet), estimated time to finish (seconds)
+    void progress(unsigned, unsigned, unsigned);
+    /// Cost of a just indexed TU and running totals
+    void unit_indexed(kate::index::unit_stats, kate::index::indexing_stats);
     void finished();
     void message(clang::diagnostic_message);
     void stopping();
 
 private:
+    friend class details::discovery;
     friend class details::worker;
+    friend class details::writer;
+
+    /// \name Members shared between workers (thread-safe)
+    //@{
+    fileid get_file_id(const QString&);
+    bool claim_file(const QString&);
+    Xapian::docid allocate_docid();
+    bool claim_location(fileid, unsigned, unsigned);
+    //@}
+
+    std::string shards_path() const;
+    void make_shards(unsigned);
+    void prepare();
+    void recover_shards();
+    void load_seen_locations();
+    bool load_seen_locations_of_targets();
+    void find_outdated_units();
+    void remove_changed_headers();
+    void report_progress();
+    void schedule_compile_commands();
 
-    std::unique_ptr<QThread> m_worker_thread;
-    clang::DCXIndex m_index;
+    std::vector<std::unique_ptr<QThread>> m_worker_threads;
+    std::unique_ptr<QThread> m_writer_thread;
+    std::unique_ptr<QThread> m_discovery_thread;
+    std::vector<std::unique_ptr<details::shard>> m_shards;  ///< Per worker DBs (if any)
     std::vector<const char*> m_options;
+    std::map<QString, std::vector<std::string>> m_compile_commands;
     std::vector<KUrl> m_targets;
+    std::map<QString, CXTranslationUnit> m_parsed_units;    ///< TUs lent by a caller (see \c add_parsed_unit())
+    QStringList m_excluded_directories;
     rw::database m_db;
+    QString m_db_path;
+    freshness_manifest m_previous_manifest;                 ///< Files state before this run
+    std::set<QString> m_outdated_units;                     ///< Unchanged TUs w/ changed headers
+    std::set<fileid> m_changed_headers;                     ///< Files changed since the previous run
+    details::targets_queue m_targets_queue;
+    details::blocking_queue<details::document_batch> m_batches;
+    std::mutex m_headers_mutex;
+    std::mutex m_files_mutex;
+    std::set<QString> m_claimed_files;                      ///< Main files taken by workers
+    std::mutex m_seen_mutex;
+    details::location_set m_seen_declarations;              ///< Locations from headers
+    std::atomic<Xapian::docid> m_last_docid;
+    std::atomic<unsigned> m_skipped_headers;
+    std::atomic<unsigned> m_total_files;                    ///< Files to process (known so far)
+    std::atomic<unsigned> m_processed_files;
+    std::chrono::steady_clock::time_point m_start_time;
+    std::vector<unit_stats> m_units_stats;                  ///< Cost of every TU indexed so far
+    indexing_stats m_stats;
+    indexing_policy m_policy;
+    indexing_profile m_profile = {indexing_profile::full};
     unsigned m_indexing_options = {default_indexing_options()};
+    unsigned m_jobs = {0};
+    unsigned m_running_workers = {0};
+    unsigned m_running_threads = {0};
+    std::size_t m_commit_documents = {DEFAULT_COMMIT_DOCUMENTS};
+    std::size_t m_commit_bytes = {DEFAULT_COMMIT_BYTES};
+    bool m_incremental = {false};
+    bool m_partial = {false};
+    bool m_declarations_only = {false};
+    bool m_low_priority = {false};
+    bool m_discovery_done = {false};
 };
 
 inline indexer& indexer::set_compiler_options(std::vector<const char*>&& options)
@@ -106,6 +233,123 @@ inline indexer& indexer::set_compiler_options(std::vector<const char*>&& options
     return *this;
 }
 
+/**
+ * Every file from a compilation database becomes an indexing target,
+ * parsed w/ options from the database instead of global ones
+ * (given by \c set_compiler_options()).
+ */
+inline indexer& indexer::set_compile_commands(std::vector<clang::compile_command>&& commands)
+{
+    for (auto& cmd : commands)
+        m_compile_commands[cmd.m_filename] = std::move(cmd.m_args);
+    return *this;
+}
+
+/**
+ * Manifest of a previous index version is used to schedule TUs to parse.
+ * In incremental mode it is not needed: the indexer has it in the DB.
+ */
+inline indexer& indexer::set_previous_manifest(const freshness_manifest& manifest)
+{
+    m_previous_manifest = manifest;
+    return *this;
+}
+
+/**
+ * \param[in] jobs number of parsing workers, \c 0 means
+ * to use as many workers as CPU cores available
+ */
+inline indexer& indexer::set_jobs_count(const unsigned jobs)
+{
+    m_jobs = jobs;
+    return *this;
+}
+
+/**
+ * In incremental mode only new and changed TUs are (re)parsed, and
+ * documents of TUs which are not found anymore are removed from the DB.
+ * It makes sense only for a DB w/ some content...
+ */
+inline indexer& indexer::set_incremental(const bool flag)
+{
+    m_incremental = flag;
+    return *this;
+}
+
+/**
+ * Partial update (in incremental mode) reparses just given targets,
+ * e.g. files have been saved in the editor and TUs depending on them.
+ * Targets are reparsed even if they have no changes on their own
+ * (a saved header doesn't change its includers). Other TUs are kept in the DB,
+ * compilation database entries are used for compiler options only,
+ * and the DB doesn't get compacted when done, so it is cheap enough
+ * to be done right in a live (searchable) DB.
+ */
+inline indexer& indexer::set_partial(const bool flag)
+{
+    m_partial = flag;
+    return *this;
+}
+
+/**
+ * In declarations only mode function bodies are not parsed and references
+ * are not indexed, which makes indexing few times faster. The DB gets marked
+ * (see \c rw::database::set_declarations_only()), so it can be recognized
+ * and reindexed completely later.
+ */
+inline indexer& indexer::set_declarations_only(const bool flag)
+{
+    m_declarations_only = flag;
+    return *this;
+}
+
+/**
+ * Profile decides what kind of documents and value slots to store
+ * (see \c indexing_policy), so an index can be smaller and faster to build
+ * at the cost of some search capabilities.
+ */
+inline indexer& indexer::set_profile(const indexing_profile profile)
+{
+    m_profile = profile;
+    m_policy = indexing_policy{profile};
+    return *this;
+}
+
+/**
+ * Parsing workers of a low priority indexer give CPU to anything else,
+ * which is good for indexing in a background of an already usable index.
+ */
+inline indexer& indexer::set_low_priority(const bool flag)
+{
+    m_low_priority = flag;
+    return *this;
+}
+
+/**
+ * Documents written to the DB are committed (w/ DB metadata, so DB is
+ * consistent and can be used to resume indexing) every time when
+ * any of the given limits reached.
+ *
+ * \param[in] documents number of documents (\c 0 means no limit)
+ * \param[in] bytes approximate size of documents (\c 0 means no limit)
+ */
+inline indexer& indexer::set_commit_threshold(const std::size_t documents, const std::size_t bytes)
+{
+    m_commit_documents = documents;
+    m_commit_bytes = bytes;
+    return *this;
+}
+
+/**
+ * \param[in] patterns wildcards to match names of directories to skip
+ * while looking for source files in targets
+ */
+inline indexer& indexer::set_excluded_directories(const QStringList& patterns)
+{
+    m_excluded_directories = patterns;
+    return *this;
+}
+
 inline indexer& indexer::add_target(const KUrl& url)
 {
     m_targets.emplace_back(url);
@@ -118,6 +362,27 @@ inline indexer& indexer::set_indexing_options(const unsigned options)
     return *this;
 }
 
+/**
+ * The first inclusion in a TU of a header parsed by some previous TU of
+ * the same worker counts (function bodies are skipped by \c libclang in this
+ * case, if \c CXIndexOpt_SkipParsedBodiesInSession is on). Repeated includes
+ * in the same TU do not count. Valid after indexing has finished.
+ */
+inline unsigned indexer::skipped_headers_count() const
+{
+    return m_skipped_headers;
+}
+
+inline bool indexer::is_cancelled()
+{
+    return m_targets_queue.is_cancelled();
+}
+
+inline Xapian::docid indexer::allocate_docid()
+{
+    return ++m_last_docid;
+}
+
 inline unsigned indexer::default_indexing_options()
 {
     return CXIndexOpt_SkipParsedBodiesInSession | CXIndexOpt_SuppressWarnings;
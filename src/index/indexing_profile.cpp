@@ -0,0 +1,87 @@
+/**
+ * \file
+ *
+ * \brief Indexing profiles (implementation)
+ *
+ * \date Fri Oct 16 23:14:36 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+// Project specific includes
+#include "indexing_profile.h"
+
+// Standard includes
+#include <KDE/KLocalizedString>
+#include <cassert>
+
+namespace kate { namespace index { namespace {
+const char* const PROFILE_NAMES[] = {"navigation", "standard", "full"};
+static_assert(
+    sizeof(PROFILE_NAMES) / sizeof(PROFILE_NAMES[0]) == std::size_t(indexing_profile::last__)
+  , "List of indexing profiles seems changed! Review your code!"
+  );
+}                                                           // anonymous namespace
+
+/**
+ * \c navigation profile is good for go-to-declaration/definition only:
+ * no references, no function bodies (unless locals are indexed), and just
+ * enough value slots to locate a symbol and to show it in search results.
+ * \c standard profile adds references and type details, but still omits
+ * implicit declarations and unnamed entities (e.g. parameters w/o names),
+ * which are the most useless and numerous documents. \c full profile stores
+ * everything (as it was before profiles were introduced).
+ *
+ * Trigrams of declaration names (for substring and regex search) are
+ * written for all profiles but \c navigation.
+ */
+indexing_policy::indexing_policy(const indexing_profile profile)
+  : m_references{profile != indexing_profile::navigation}
+  , m_implicits{profile == indexing_profile::full}
+  , m_anonymous{profile == indexing_profile::full}
+  , m_parameters{profile != indexing_profile::navigation}
+  , m_type_details{profile != indexing_profile::navigation}
+  , m_trigrams{profile != indexing_profile::navigation}
+{
+}
+
+std::string to_string(const indexing_profile profile)
+{
+    assert("Sanity check" && profile < indexing_profile::last__);
+    return PROFILE_NAMES[std::size_t(profile)];
+}
+
+QString toString(const indexing_profile profile)
+{
+    switch (profile)
+    {
+        case indexing_profile::navigation:
+            return i18nc("@item:inlistbox", "Navigation only");
+        case indexing_profile::standard:
+            return i18nc("@item:inlistbox", "Standard");
+        case indexing_profile::full:
+            return i18nc("@item:inlistbox", "Full");
+        default:
+            break;
+    }
+    assert(!"Unexpected indexing profile");
+    return QString{};
+}
+
+}}                                                          // namespace index, kate
@@ -0,0 +1,72 @@
+/**
+ * \file
+ *
+ * \brief Indexing profiles (interface)
+ *
+ * \date Fri Oct 16 23:14:36 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Project specific includes
+
+// Standard includes
+#include <string>
+
+class QString;
+
+namespace kate { namespace index {
+
+/**
+ * \brief Indexing profiles to trade an index size for its fidelity
+ *
+ * \attention Order of items must match \c indexingProfile choices
+ * of an index options (\c DatabaseOptions)
+ */
+enum class indexing_profile
+{
+    navigation                                              ///< Enough to navigate to declarations
+  , standard                                                ///< Declarations and references
+  , full                                                    ///< Everything \c libclang reports
+  , last__
+};
+
+/**
+ * \brief What the indexer stores according to a profile
+ */
+struct indexing_policy
+{
+    explicit indexing_policy(indexing_profile = indexing_profile::full);
+
+    bool m_references;                                      ///< Make documents for references
+    bool m_implicits;                                       ///< Keep implicit declarations
+    bool m_anonymous;                                       ///< Keep anonymous entities (except containers)
+    bool m_parameters;                                      ///< Keep function parameters
+    bool m_type_details;                                    ///< Store type, arity, sizes and base classes
+    bool m_trigrams;                                        ///< Write a trigrams table of declaration names
+};
+
+/// Make a string from \c indexing_profile (used in a command line and manifests)
+std::string to_string(indexing_profile);
+/// Make a human readable string from \c indexing_profile
+QString toString(indexing_profile);
+
+}}                                                          // namespace index, kate
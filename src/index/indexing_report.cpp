@@ -0,0 +1,227 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::details::writer (interface)
+ *
+ * \date Fri Oct 16 20:37:19 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Project specific includes
+#include "indexing_report.h"
+
+// Standard includes
+#include <QtCore/QList>
+
+namespace kate { namespace index { namespace report { namespace {
+
+const char SEPARATOR = '\t';
+const QByteArray PROGRESS = "progress";
+const QByteArray FILE = "file";
+const QByteArray UNIT = "unit";
+const QByteArray MESSAGE = "message";
+const QByteArray FINISHED = "finished";
+
+/// Make sure a field will not break the line format
+QByteArray escape(const QString& str)
+{
+    auto result = str.toUtf8();
+    result.replace(SEPARATOR, ' ');
+    result.replace('\n', ' ');
+    return result;
+}
+
+QString from_utf8(const QByteArray& raw)
+{
+    return QString::fromUtf8(raw.constData(), raw.size());
+}
+
+/// Helper to compose a line field by field
+class line
+{
+public:
+    explicit line(const QByteArray& type) : m_line{type} {}
+
+    line& operator<<(const QByteArray& field)
+    {
+        m_line += SEPARATOR;
+        m_line += field;
+        return *this;
+    }
+    line& operator<<(const QString& field)
+    {
+        return *this << escape(field);
+    }
+    template <typename T>
+    line& operator<<(const T value)
+    {
+        return *this << QByteArray::number(value);
+    }
+
+    operator QByteArray() const
+    {
+        return m_line + '\n';
+    }
+
+private:
+    QByteArray m_line;
+};
+
+}                                                           // anonymous namespace
+
+QByteArray progress(const unsigned processed, const unsigned total, const unsigned eta)
+{
+    return line{PROGRESS} << processed << total << eta;
+}
+
+QByteArray file(const QString& filename)
+{
+    return line{FILE} << filename;
+}
+
+QByteArray unit(const unit_stats& u, const indexing_stats& s)
+{
+    return line{UNIT}
+      << u.m_parse_time
+      << u.m_callbacks_time
+      << u.m_declarations
+      << u.m_references
+      << u.m_documents
+      << s.m_files
+      << qulonglong(s.m_declarations)
+      << qulonglong(s.m_references)
+      << qulonglong(s.m_documents)
+      << qulonglong(s.m_elapsed)
+      << u.m_filename
+      ;
+}
+
+QByteArray message(const clang::diagnostic_message& msg)
+{
+    // NOTE Line and column of an empty location are not initialized
+    const auto has_location = !msg.m_location.empty();
+    return line{MESSAGE}
+      << int(msg.m_type)
+      << (has_location ? msg.m_location.line() : 0)
+      << (has_location ? msg.m_location.column() : 0)
+      << (has_location ? msg.m_location.file().toLocalFile() : QString{})
+      << msg.m_text
+      ;
+}
+
+QByteArray finished(const bool cancelled)
+{
+    return line{FINISHED} << int(cancelled);
+}
+
+/**
+ * \note Unknown event types are reported as invalid records, so
+ * (future) new events can be ignored by a caller.
+ */
+record parse(const QByteArray& raw)
+{
+    auto result = record{};
+    // NOTE Do not trim other whitespaces: the last field may be empty
+    auto data = raw;
+    while (data.endsWith('\n') || data.endsWith('\r'))
+        data.chop(1);
+    const auto fields = data.split(SEPARATOR);
+    if (fields.empty())
+        return result;
+
+    const auto& type = fields[0];
+    auto ok = true;
+    const auto to_uint = [&fields, &ok](const int i)
+    {
+        auto field_ok = false;
+        const auto value = fields[i].toUInt(&field_ok);
+        ok = ok && field_ok;
+        return value;
+    };
+    const auto to_int = [&fields, &ok](const int i)
+    {
+        auto field_ok = false;
+        const auto value = fields[i].toInt(&field_ok);
+        ok = ok && field_ok;
+        return value;
+    };
+    const auto to_ulonglong = [&fields, &ok](const int i)
+    {
+        auto field_ok = false;
+        const auto value = fields[i].toULongLong(&field_ok);
+        ok = ok && field_ok;
+        return value;
+    };
+
+    if (type == PROGRESS && fields.size() == 4)
+    {
+        result.m_processed = to_uint(1);
+        result.m_total = to_uint(2);
+        result.m_eta = to_uint(3);
+        result.m_type = record::type::progress;
+    }
+    else if (type == FILE && fields.size() == 2)
+    {
+        result.m_filename = from_utf8(fields[1]);
+        result.m_type = record::type::file;
+    }
+    else if (type == UNIT && fields.size() == 12)
+    {
+        result.m_unit.m_parse_time = to_uint(1);
+        result.m_unit.m_callbacks_time = to_uint(2);
+        result.m_unit.m_declarations = to_uint(3);
+        result.m_unit.m_references = to_uint(4);
+        result.m_unit.m_documents = to_uint(5);
+        result.m_stats.m_files = to_uint(6);
+        result.m_stats.m_declarations = to_ulonglong(7);
+        result.m_stats.m_references = to_ulonglong(8);
+        result.m_stats.m_documents = to_ulonglong(9);
+        result.m_stats.m_elapsed = to_ulonglong(10);
+        result.m_unit.m_filename = from_utf8(fields[11]);
+        result.m_type = record::type::unit;
+    }
+    else if (type == MESSAGE && fields.size() == 6)
+    {
+        const auto msg_type = to_uint(1);
+        const auto line = to_int(2);
+        const auto column = to_int(3);
+        ok = ok && msg_type <= unsigned(clang::diagnostic_message::type::cutset);
+        const auto filename = from_utf8(fields[4]);
+        result.m_message = clang::diagnostic_message{
+            filename.isEmpty() ? clang::location{} : clang::location{KUrl{filename}, line, column}
+          , from_utf8(fields[5])
+          , clang::diagnostic_message::type(msg_type)
+          };
+        result.m_type = record::type::message;
+    }
+    else if (type == FINISHED && fields.size() == 2)
+    {
+        result.m_cancelled = to_uint(1) != 0;
+        result.m_type = record::type::finished;
+    }
+
+    if (!ok)
+        result.m_type = record::type::invalid;
+    return result;
+}
+
+}}}                                                         // namespace report, index, kate
@@ -0,0 +1,92 @@
+/**
+ * \file
+ *
+ * \brief Functions to produce and parse \c kate-cpp-indexer report (interface)
+ *
+ * \date Fri Oct 16 20:37:19 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+// Project specific includes
+#include "indexing_stats.h"
+#include "../clang/diagnostic_message.h"
+
+// Standard includes
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+namespace kate { namespace index { namespace report {
+
+/**
+ * \brief Machine readable report of the headless indexer (\c kate-cpp-indexer)
+ *
+ * Being started w/ \c --report option, the indexer writes every event as
+ * a single line (w/ tab separated fields) to \c stdout. The first field
+ * is an event type, the rest are the same as parameters of corresponding
+ * \c kate::index::indexer signals:
+ *
+ * \code
+ *  progress    <processed> <total> <eta>
+ *  file        <filename>
+ *  unit        <parse-ms> <callbacks-ms> <decls> <refs> <docs> <files> <total-decls> <total-refs> <total-docs> <elapsed-ms> <filename>
+ *  message     <type> <line> <column> <filename> <text>
+ *  finished    <cancelled>
+ * \endcode
+ */
+struct record
+{
+    enum class type
+    {
+        invalid
+      , progress
+      , file
+      , unit
+      , message
+      , finished
+    };
+
+    type m_type = {type::invalid};
+    unsigned m_processed = {0};
+    unsigned m_total = {0};
+    unsigned m_eta = {0};
+    QString m_filename;
+    unit_stats m_unit;
+    indexing_stats m_stats;
+    clang::diagnostic_message m_message;
+    bool m_cancelled = {false};
+};
+
+/// \name Make a report line (w/ a trailing newline)
+//@{
+QByteArray progress(unsigned, unsigned, unsigned);
+QByteArray file(const QString&);
+QByteArray unit(const unit_stats&, const indexing_stats&);
+QByteArray message(const clang::diagnostic_message&);
+QByteArray finished(bool);
+//@}
+
+/// Parse a report line, get a record w/ \c type::invalid on failure
+record parse(const QByteArray&);
+
+}}}                                                         // namespace report, index, kate
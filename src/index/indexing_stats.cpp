@@ -0,0 +1,82 @@
+/**
+ * \file
+ *
+ * \brief Structs \c kate::index::unit_stats and \c kate::index::indexing_stats (implementation)
+ *
+ * \date Fri Oct 16 21:26:18 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "indexing_stats.h"
+
+// Standard includes
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+#include <algorithm>
+
+namespace kate { namespace index {
+
+/**
+ * Write a tab separated table of TUs (the most expensive first) to be
+ * analyzed w/ any spreadsheet or \c sort/awk.
+ *
+ * \param[in] filename file to write to (overwritten if exists)
+ * \param[in] units statistics of all indexed TUs
+ * \param[in] totals statistics of indexing session
+ * \return \c false if file can't be written
+ */
+bool write_stats_file(const QString& filename, std::vector<unit_stats> units, const indexing_stats& totals)
+{
+    QFile file{filename};
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    std::sort(
+        begin(units)
+      , end(units)
+      , [](const unit_stats& lhs, const unit_stats& rhs)
+        {
+            return lhs.m_parse_time > rhs.m_parse_time;
+        }
+      );
+
+    QTextStream out{&file};
+    out << "# files: " << totals.m_files
+        << ", declarations: " << totals.m_declarations
+        << ", references: " << totals.m_references
+        << ", documents: " << totals.m_documents
+        << ", elapsed (ms): " << totals.m_elapsed
+        << ", files/s: " << totals.files_per_second()
+        << ", declarations/s: " << totals.declarations_per_second()
+        << '\n';
+    out << "# parse_ms\tcallbacks_ms\tdeclarations\treferences\tdocuments\tfile\n";
+    for (const auto& u : units)
+        out << u.m_parse_time << '\t'
+            << u.m_callbacks_time << '\t'
+            << u.m_declarations << '\t'
+            << u.m_references << '\t'
+            << u.m_documents << '\t'
+            << u.m_filename << '\n';
+    return out.status() == QTextStream::Ok;
+}
+
+}}                                                          // namespace index, kate
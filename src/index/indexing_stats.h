@@ -0,0 +1,85 @@
+/**
+ * \file
+ *
+ * \brief Structs \c kate::index::unit_stats and \c kate::index::indexing_stats (interface)
+ *
+ * \date Fri Oct 16 21:26:18 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+
+// Standard includes
+#include <QtCore/QMetaType>
+#include <QtCore/QString>
+#include <cstdint>
+#include <vector>
+
+namespace kate { namespace index {
+
+/// Indexing cost of a single translation unit
+struct unit_stats
+{
+    QString m_filename;
+    std::uint32_t m_parse_time = {0};                       ///< Total time to parse (or reparse) and index (ms)
+    std::uint32_t m_callbacks_time = {0};                   ///< Time spent in declaration/reference callbacks (ms)
+    unsigned m_declarations = {0};                          ///< Declarations reported by \c libclang
+    unsigned m_references = {0};                            ///< References reported by \c libclang
+    unsigned m_documents = {0};                             ///< Documents produced
+};
+
+/// Running totals of an indexing session
+struct indexing_stats
+{
+    unsigned m_files = {0};
+    std::uint64_t m_declarations = {0};
+    std::uint64_t m_references = {0};
+    std::uint64_t m_documents = {0};
+    std::uint64_t m_elapsed = {0};                          ///< Time since indexing start (ms)
+
+    void add(const unit_stats& u)
+    {
+        ++m_files;
+        m_declarations += u.m_declarations;
+        m_references += u.m_references;
+        m_documents += u.m_documents;
+    }
+    double files_per_second() const
+    {
+        return m_elapsed ? m_files * 1000.0 / m_elapsed : 0.0;
+    }
+    double declarations_per_second() const
+    {
+        return m_elapsed ? m_declarations * 1000.0 / m_elapsed : 0.0;
+    }
+};
+
+/// Name of a file (in an index directory) w/ statistics of the last indexing
+const char* const STATS_FILE = "indexing-stats.tsv";
+
+bool write_stats_file(const QString&, std::vector<unit_stats>, const indexing_stats&);
+
+}}                                                          // namespace index, kate
+
+Q_DECLARE_METATYPE(kate::index::unit_stats);
+Q_DECLARE_METATYPE(kate::index::indexing_stats);
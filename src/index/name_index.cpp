@@ -0,0 +1,337 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::name_index (implementation)
+ *
+ * \date Sat Oct 17 01:48:23 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "name_index.h"
+#include "document_extras.h"
+#include "types.h"
+
+// Standard includes
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <utility>
+
+namespace kate { namespace index { namespace {
+
+/// \note Only ASCII letters are lowercased (just like by \c document_builder)
+std::string to_lower(std::string str)
+{
+    for (auto& c : str)
+        if ('A' <= c && c <= 'Z')
+            c += 'a' - 'A';
+    return str;
+}
+
+/// Get a bit of a (lowercased) char in a mask of chars met in a subtree
+std::uint32_t char_bit(const char c)
+{
+    if ('a' <= c && c <= 'z')
+        return 1u << (c - 'a');
+    if ('0' <= c && c <= '9')
+        return 1u << 26;
+    if (c == '_')
+        return 1u << 27;
+    return 1u << 28;
+}
+
+}                                                           // anonymous namespace
+
+/**
+ * Empty names are ignored. If few names differ only in letters case,
+ * all of them are kept.
+ */
+void name_index::build(std::vector<std::string> names)
+{
+    auto keyed = std::vector<std::pair<std::string, std::string>>{};
+    keyed.reserve(names.size());
+    for (auto& name : names)
+        if (!name.empty())
+            keyed.emplace_back(to_lower(name), std::move(name));
+    std::sort(begin(keyed), end(keyed));
+    keyed.erase(std::unique(begin(keyed), end(keyed)), end(keyed));
+
+    m_names.clear();
+    m_keys.clear();
+    m_nodes.clear();
+    m_names.reserve(keyed.size());
+    m_keys.reserve(keyed.size());
+    for (auto& p : keyed)
+    {
+        m_keys.emplace_back(std::move(p.first));
+        m_names.emplace_back(std::move(p.second));
+    }
+
+    m_nodes.push_back(node{0, 0, 0, 0, 0, 0, std::uint32_t(m_names.size()), 0});
+    build_children(0);
+
+    // NOTE Children always follow a parent, so masks are calculated bottom up
+    for (auto i = m_nodes.size(); i; --i)
+    {
+        auto& n = m_nodes[i - 1];
+        if (!m_keys.empty())
+        {
+            const auto& key = m_keys[n.m_key];
+            for (auto c = n.m_label_begin; c < n.m_label_end; ++c)
+                n.m_chars |= char_bit(key[c]);
+        }
+        for (auto c = n.m_first_child; c < n.m_first_child + n.m_children; ++c)
+            n.m_chars |= m_nodes[c].m_chars;
+    }
+}
+
+/**
+ * Names of a node (sorted) are grouped by a char at node's depth,
+ * and a child node made for every group. A label of a child is
+ * the longest common prefix of the group.
+ *
+ * \attention Nodes array may be reallocated here, so a node is
+ * referred by index.
+ */
+void name_index::build_children(const std::uint32_t idx)
+{
+    const auto depth = m_nodes[idx].m_label_end;
+    const auto last = m_nodes[idx].m_last;
+    auto first = m_nodes[idx].m_first;
+    // Skip names ending right at this node
+    while (first < last && m_keys[first].size() == depth)
+        ++first;
+
+    const auto first_child = std::uint32_t(m_nodes.size());
+    while (first < last)
+    {
+        const auto c = m_keys[first][depth];
+        auto group_end = first + 1;
+        while (group_end < last && m_keys[group_end][depth] == c)
+            ++group_end;
+        const auto& front = m_keys[first];
+        const auto& back = m_keys[group_end - 1];
+        auto lcp = depth + 1;
+        while (lcp < front.size() && lcp < back.size() && front[lcp] == back[lcp])
+            ++lcp;
+        m_nodes.push_back(node{first, depth, std::uint32_t(lcp), 0, 0, first, group_end, 0});
+        first = group_end;
+    }
+    const auto children_end = std::uint32_t(m_nodes.size());
+    m_nodes[idx].m_first_child = first_child;
+    m_nodes[idx].m_children = children_end - first_child;
+    for (auto i = first_child; i < children_end; ++i)
+        build_children(i);
+}
+
+/// Children are sorted by the first char of a label, so do a binary search
+auto name_index::find_child(const node& n, const char c) const -> const node*
+{
+    const auto first = begin(m_nodes) + n.m_first_child;
+    const auto last = first + n.m_children;
+    auto it = std::lower_bound(
+        first
+      , last
+      , c
+      , [this](const node& child, const char value)
+        {
+            return m_keys[child.m_key][child.m_label_begin] < value;
+        }
+      );
+    if (it != last && m_keys[it->m_key][it->m_label_begin] == c)
+        return &*it;
+    return nullptr;
+}
+
+void name_index::collect(const node& n, const std::size_t max, std::vector<std::string>& result) const
+{
+    for (auto i = n.m_first; i < n.m_last && result.size() < max; ++i)
+        result.emplace_back(m_names[i]);
+}
+
+std::vector<std::string> name_index::find_prefix(const std::string& prefix, const std::size_t max) const
+{
+    auto result = std::vector<std::string>{};
+    if (empty())
+        return result;
+
+    const auto p = to_lower(prefix);
+    const auto* n = &m_nodes.front();
+    for (auto depth = std::size_t{0}; depth < p.size();)
+    {
+        n = find_child(*n, p[depth]);
+        if (!n)
+            return result;
+        const auto& key = m_keys[n->m_key];
+        for (auto i = n->m_label_begin; i < n->m_label_end && depth < p.size(); ++i, ++depth)
+            if (key[i] != p[depth])
+                return result;
+    }
+    collect(*n, max, result);
+    return result;
+}
+
+/**
+ * Trie is traversed matching pattern chars greedily (that is enough to find
+ * a subsequence). Subtrees w/o some of the rest pattern chars are skipped.
+ */
+std::vector<std::string> name_index::find_subsequence(const std::string& pattern, const std::size_t max) const
+{
+    auto result = std::vector<std::string>{};
+    if (empty())
+        return result;
+
+    const auto p = to_lower(pattern);
+    // Masks of chars required to match the rest of a pattern
+    auto rest = std::vector<std::uint32_t>(p.size() + 1, 0);
+    for (auto i = p.size(); i; --i)
+        rest[i - 1] = rest[i] | char_bit(p[i - 1]);
+    find_subsequence(m_nodes.front(), p, 0, rest, max, result);
+    return result;
+}
+
+void name_index::find_subsequence(
+    const node& n
+  , const std::string& pattern
+  , std::size_t matched
+  , const std::vector<std::uint32_t>& rest
+  , const std::size_t max
+  , std::vector<std::string>& result
+  ) const
+{
+    if ((n.m_chars & rest[matched]) != rest[matched])
+        return;                                             // Some pattern chars are not in a subtree
+
+    const auto& key = m_keys[n.m_key];
+    for (auto i = n.m_label_begin; i < n.m_label_end && matched < pattern.size(); ++i)
+        if (key[i] == pattern[matched])
+            ++matched;
+    if (matched == pattern.size())
+    {
+        collect(n, max, result);
+        return;
+    }
+    for (auto c = n.m_first_child; c < n.m_first_child + n.m_children && result.size() < max; ++c)
+        find_subsequence(m_nodes[c], pattern, matched, rest, max, result);
+}
+
+/**
+ * Levenshtein distance table is calculated row by row while going down
+ * the trie, so a row is shared by all names w/ the same prefix. Subtrees
+ * are skipped as soon as all distances of a row exceed a given one.
+ */
+std::vector<std::string> name_index::find_similar(
+    const std::string& pattern
+  , const unsigned distance
+  , const std::size_t max
+  ) const
+{
+    auto result = std::vector<std::string>{};
+    if (empty())
+        return result;
+
+    const auto p = to_lower(pattern);
+    auto row = std::vector<unsigned>(p.size() + 1);
+    std::iota(begin(row), end(row), 0u);
+    find_similar(m_nodes.front(), p, row, distance, max, result);
+    return result;
+}
+
+void name_index::find_similar(
+    const node& n
+  , const std::string& pattern
+  , const std::vector<unsigned>& parent_row
+  , const unsigned distance
+  , const std::size_t max
+  , std::vector<std::string>& result
+  ) const
+{
+    auto row = parent_row;
+    auto prev = std::vector<unsigned>(row.size());
+    const auto& key = m_keys[n.m_key];
+    for (auto i = n.m_label_begin; i < n.m_label_end; ++i)
+    {
+        prev.swap(row);
+        row[0] = prev[0] + 1;
+        for (auto j = std::size_t{1}; j < row.size(); ++j)
+            row[j] = std::min({prev[j] + 1, row[j - 1] + 1, prev[j - 1] + unsigned(key[i] != pattern[j - 1])});
+        if (*std::min_element(begin(row), end(row)) > distance)
+            return;                                         // Nothing similar in a subtree
+    }
+    // Names ending at this node are at the beginning of its range
+    if (row.back() <= distance)
+        for (auto i = n.m_first; i < n.m_last && m_keys[i].size() == n.m_label_end && result.size() < max; ++i)
+            result.emplace_back(m_names[i]);
+    for (auto c = n.m_first_child; c < n.m_first_child + n.m_children && result.size() < max; ++c)
+        find_similar(m_nodes[c], pattern, row, distance, max, result);
+}
+
+/**
+ * Declarations are marked w/ \c XDECL prefixed terms: one w/ a name as is
+ * (prefixed w/ ':' if starts w/ a capital letter), and one w/ a lowercased
+ * name. So a lowercased term is a real name only if there are more documents
+ * w/ it than w/ all other names lowercased to the same string.
+ */
+std::vector<std::string> collect_declaration_names(const Xapian::Database& db)
+{
+    struct variants
+    {
+        std::vector<std::string> m_names;                   ///< Not lowercased names
+        doccount m_count = {0};                             ///< Documents w/ them
+        doccount m_lowercased_count = {0};                  ///< Documents w/ a lowercased name
+    };
+    auto names = std::map<std::string, variants>{};
+    for (
+        auto it = db.allterms_begin(term::XDECL), last = db.allterms_end(term::XDECL)
+      ; it != last
+      ; ++it
+      )
+    {
+        auto name = (*it).substr(term::XDECL.size());
+        if (!name.empty() && name[0] == ':')
+            name.erase(0, 1);
+        if (name.empty())
+            continue;
+        auto lowercased = to_lower(name);
+        auto& v = names[lowercased];
+        if (name == lowercased)
+            v.m_lowercased_count += it.get_termfreq();
+        else
+        {
+            v.m_names.emplace_back(std::move(name));
+            v.m_count += it.get_termfreq();
+        }
+    }
+
+    auto result = std::vector<std::string>{};
+    result.reserve(names.size());
+    for (auto& p : names)
+    {
+        if (p.second.m_count < p.second.m_lowercased_count)
+            result.emplace_back(p.first);
+        std::move(begin(p.second.m_names), end(p.second.m_names), std::back_inserter(result));
+    }
+    return result;
+}
+
+}}                                                          // namespace index, kate
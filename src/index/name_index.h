@@ -0,0 +1,127 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::name_index (interface)
+ *
+ * \date Sat Oct 17 01:48:23 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Project specific includes
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Xapian {
+class Database;
+}                                                           // namespace Xapian
+
+namespace kate { namespace index {
+
+/**
+ * \brief In-memory index of symbol names for type-ahead search
+ *
+ * Names are kept in a compressed (radix) trie of lowercased names,
+ * so matching is case insensitive. Nodes are stored in a flat array
+ * (children of a node are adjacent), and edge labels refer to the
+ * names themselves. Every node knows a range of (sorted) names
+ * under it, so a whole matched subtree is taken at once.
+ *
+ * The following kinds of lookup are supported:
+ * - by prefix: \c "gotodecl" finds \c gotoDeclarationUnderCursor
+ * - by subsequence: \c "gdc" finds \c gotoDeclarationUnderCursor
+ * - by edit distance: \c "gotoDeclaratoinUnderCursor" finds \c gotoDeclarationUnderCursor
+ *
+ * Results are in (case insensitive) lexicographical order,
+ * and lookup stops as soon as requested number of results found.
+ */
+class name_index
+{
+public:
+    /// Build an index from a given list of names (in any order, w/ duplicates)
+    void build(std::vector<std::string>);
+    /// Find names w/ a given prefix
+    std::vector<std::string> find_prefix(const std::string&, std::size_t) const;
+    /// Find names containing all chars of a given pattern in the same order
+    std::vector<std::string> find_subsequence(const std::string&, std::size_t) const;
+    /// Find names w/ edit distance to a given pattern not greater than given
+    std::vector<std::string> find_similar(const std::string&, unsigned, std::size_t) const;
+
+    /// Get count of indexed names
+    std::size_t size() const;
+    bool empty() const;
+
+private:
+    struct node
+    {
+        std::uint32_t m_key;                                ///< A name to take a label from
+        std::uint32_t m_label_begin;                        ///< Label is a range of chars of the name
+        std::uint32_t m_label_end;                          ///< ... and a depth of the node as well
+        std::uint32_t m_first_child;
+        std::uint32_t m_children;                           ///< Count of children
+        std::uint32_t m_first;                              ///< Range of names in a subtree
+        std::uint32_t m_last;
+        std::uint32_t m_chars;                              ///< Mask of chars met in a subtree
+    };
+
+    void build_children(std::uint32_t);
+    const node* find_child(const node&, char) const;
+    void collect(const node&, std::size_t, std::vector<std::string>&) const;
+    void find_subsequence(
+        const node&
+      , const std::string&
+      , std::size_t
+      , const std::vector<std::uint32_t>&
+      , std::size_t
+      , std::vector<std::string>&
+      ) const;
+    void find_similar(
+        const node&
+      , const std::string&
+      , const std::vector<unsigned>&
+      , unsigned
+      , std::size_t
+      , std::vector<std::string>&
+      ) const;
+
+    std::vector<std::string> m_names;                       ///< Sorted by lowercased name
+    std::vector<std::string> m_keys;                        ///< Lowercased names
+    std::vector<node> m_nodes;                              ///< The first one is a root
+};
+
+inline std::size_t name_index::size() const
+{
+    return m_names.size();
+}
+
+inline bool name_index::empty() const
+{
+    return m_names.empty();
+}
+
+/// Get names of all declarations stored in a DB
+std::vector<std::string> collect_declaration_names(const Xapian::Database&);
+
+}}                                                          // namespace index, kate
@@ -0,0 +1,96 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::query_cache (implementation)
+ *
+ * \date Sat Oct 17 01:05:52 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+// Project specific includes
+#include "query_cache.h"
+
+// Standard includes
+#include <algorithm>
+#include <cassert>
+
+namespace kate { namespace index {
+
+constexpr std::size_t query_cache::DEFAULT_CAPACITY;
+
+query_cache::query_cache(const std::size_t capacity)
+  : m_capacity{capacity}
+{
+    assert("Sanity check" && m_capacity);
+}
+
+const cached_matches* query_cache::find(const std::string& key)
+{
+    auto it = m_index.find(key);
+    if (it == end(m_index))
+    {
+        ++m_misses;
+        return nullptr;
+    }
+    ++m_hits;
+    m_entries.splice(begin(m_entries), m_entries, it->second);
+    return &it->second->second;
+}
+
+void query_cache::insert(const std::string& key, cached_matches&& matches)
+{
+    auto it = m_index.find(key);
+    if (it != end(m_index))
+    {
+        it->second->second = std::move(matches);
+        m_entries.splice(begin(m_entries), m_entries, it->second);
+        return;
+    }
+    if (m_entries.size() == m_capacity)
+    {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+    m_entries.emplace_front(key, std::move(matches));
+    m_index.emplace(key, begin(m_entries));
+}
+
+void query_cache::invalidate(const dbid id)
+{
+    for (auto it = begin(m_entries), last = end(m_entries); it != last;)
+    {
+        const auto& indices = it->second.m_indices;
+        if (std::find(begin(indices), end(indices), id) != end(indices))
+        {
+            m_index.erase(it->first);
+            it = m_entries.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+void query_cache::clear()
+{
+    m_entries.clear();
+    m_index.clear();
+}
+
+}}                                                          // namespace index, kate
@@ -0,0 +1,103 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::query_cache (interface)
+ *
+ * \date Sat Oct 17 01:05:52 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+// Project specific includes
+#include "types.h"
+
+// Standard includes
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace kate { namespace index {
+
+/// Documents matched by a query (IDs in a combined DB)
+struct cached_matches
+{
+    std::vector<Xapian::docid> m_ids;
+    doccount m_estimated;                                   ///< Estimated matches count
+    std::vector<dbid> m_indices;                            ///< Indices searched
+};
+
+/// Cache usage counters
+struct query_cache_stats
+{
+    std::size_t m_hits = {0};
+    std::size_t m_misses = {0};
+    std::size_t m_size = {0};                               ///< Entries cached
+};
+
+/**
+ * \brief LRU cache of query results
+ *
+ * A key is made by a caller and must identify a query string, requested
+ * range of results and all searched indices w/ their revisions.
+ * Entries referring an index can be dropped when the index gets
+ * reopened or removed from search.
+ */
+class query_cache
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 64;
+
+    explicit query_cache(std::size_t = DEFAULT_CAPACITY);
+
+    /// Find results cached for a key (count a hit or miss)
+    const cached_matches* find(const std::string&);
+    /// Cache results for a key (the least recently used entry may be evicted)
+    void insert(const std::string&, cached_matches&&);
+    /// Drop entries w/ results of a given index
+    void invalidate(dbid);
+    /// Drop all entries
+    void clear();
+
+    query_cache_stats stats() const;
+
+private:
+    typedef std::list<std::pair<std::string, cached_matches>> entries_list;
+
+    entries_list m_entries;                                 ///< The most recently used first
+    std::unordered_map<std::string, entries_list::iterator> m_index;
+    const std::size_t m_capacity;
+    std::size_t m_hits = {0};
+    std::size_t m_misses = {0};
+};
+
+inline query_cache_stats query_cache::stats() const
+{
+    auto result = query_cache_stats{};
+    result.m_hits = m_hits;
+    result.m_misses = m_misses;
+    result.m_size = m_entries.size();
+    return result;
+}
+
+}}                                                          // namespace index, kate
@@ -27,12 +27,25 @@
 
 // Project specific includes
 #include "search_result.h"
+#include "document.h"
+#include "utils.h"
+#include "../header_files_cache.h"
+#include "../string_cast.h"
 
 // Standard includes
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/serialization/list.hpp>
+#include <boost/serialization/string.hpp>
+#include <KDE/KLocalizedString>
 #include <cassert>
+#include <list>
 #include <map>
+#include <sstream>
+#include <stdexcept>
 
-namespace kate { namespace index {
+namespace kate { namespace index { namespace {
+const QString ANONYMOUS = "<anonymous>";
+}                                                           // anonymous namespace
 
 search_result::search_result(search_result&& other) noexcept
   : m_line{other.m_line}
@@ -76,4 +89,135 @@ search_result& search_result::operator=(search_result&& other) noexcept
     return *this;
 }
 
+/**
+ * \throw std::runtime_error if there is no DBID attached to a document
+ */
+dbid get_dbid(const document& doc)
+{
+    const auto& tmp_str = doc.get_value(value_slot::DBID);
+    if (tmp_str.empty())
+        /// \todo Damn this looks really ugly!
+        throw std::runtime_error(
+            i18nc("@info:tooltip", "No DBID attached to a document").toUtf8().constData()
+          );
+    return deserialize<dbid>(tmp_str);
+}
+
+/**
+ * \param[in] doc document found in an index
+ * \param[in] db_name name of the index (to be displayed)
+ * \param[in] files files mapping of the index
+ * \throw std::runtime_error if there is no file attached to a document
+ */
+search_result make_search_result(const document& doc, const QString& db_name, const HeaderFilesCache& files)
+{
+    // Get kind
+    auto tmp_str = doc.get_value(value_slot::KIND);
+    assert("Sanity check" && !tmp_str.empty());
+
+    // Form a search result item
+    auto result = search_result{deserialize(tmp_str)};
+    result.m_db_name = db_name;
+
+    // Get source file ID
+    tmp_str = doc.get_value(value_slot::FILE);
+    if (tmp_str.empty())
+        throw std::runtime_error(
+            i18nc("@info:tooltip", "No source file ID attached to a document").toUtf8().constData()
+          );
+
+    auto file_id = static_cast<HeaderFilesCache::id_type>(Xapian::sortable_unserialise(tmp_str));
+    // Resolve header ID into string
+    result.m_file = files[file_id];
+
+    // Get line/column
+    result.m_line = static_cast<int>(
+        Xapian::sortable_unserialise(doc.get_value(value_slot::LINE))
+      );
+    result.m_column = static_cast<int>(
+        Xapian::sortable_unserialise(doc.get_value(value_slot::COLUMN))
+      );
+
+    // Get entity name
+    {
+        const auto& name = doc.get_value(value_slot::NAME);
+        result.m_name = name.empty() ? ANONYMOUS : string_cast<QString>(name);
+    }
+
+    // Get entity type
+    {
+        const auto& type = doc.get_value(value_slot::TYPE);
+        result.m_type = type.empty() ? QString{} : string_cast<QString>(type);
+    }
+
+    // Get parent scope
+    {
+        const auto& scope = doc.get_value(value_slot::SCOPE);
+        if (!scope.empty())
+            result.m_scope = string_cast<QString>(scope);
+    }
+
+    // Get some other props
+    {
+        const auto& str = doc.get_value(value_slot::TEMPLATE);
+        if (!str.empty())
+        {
+            const auto value = deserialize<unsigned>(str);
+            result.m_template_kind = CXIdxEntityCXXTemplateKind(value);
+        }
+    }
+    {
+        const auto& str = doc.get_value(value_slot::FLAGS);
+        if (!str.empty())
+            result.m_flags.m_flags_as_int =
+                deserialize<decltype(result.m_flags.m_flags_as_int)>(str);
+    }
+    {
+        const auto& str = doc.get_value(value_slot::VALUE);
+        if (!str.empty())
+            result.m_value = static_cast<long long>(Xapian::sortable_unserialise(str));
+    }
+    {
+        const auto& str = doc.get_value(value_slot::SIZEOF);
+        if (!str.empty())
+            result.m_sizeof = static_cast<std::size_t>(Xapian::sortable_unserialise(str));
+    }
+    {
+        const auto& str = doc.get_value(value_slot::ALIGNOF);
+        if (!str.empty())
+            result.m_alignof = static_cast<std::size_t>(Xapian::sortable_unserialise(str));
+    }
+    {
+        const auto& str = doc.get_value(value_slot::ARITY);
+        if (!str.empty())
+            result.m_arity = static_cast<int>(Xapian::sortable_unserialise(str));
+    }
+    {
+        const auto& str = doc.get_value(value_slot::ACCESS);
+        if (!str.empty())
+        {
+            const auto value = deserialize<unsigned>(str);
+            result.m_access = CX_CXXAccessSpecifier(value);
+        }
+    }
+    {
+        const auto& str = doc.get_value(value_slot::BASES);
+        if (!str.empty())
+        {
+            std::stringstream ss{str, std::ios_base::in | std::ios_base::binary};
+            boost::archive::binary_iarchive ia{ss};
+            std::list<std::string> l;
+            ia >> l;
+            if (!l.empty())                         // Is there anything to transform?
+            {
+                auto bases = QStringList{};
+                for (const auto& base : l)
+                    bases << string_cast<QString>(base);
+                result.m_bases = bases;
+            }
+        }
+    }
+    return result;
+}
+
 }}                                                          // namespace index, kate
@@ -29,6 +29,7 @@
 
 // Project specific includes
 #include "kind.h"
+#include "types.h"
 
 // Standard includes
 #include <boost/optional.hpp>
@@ -37,7 +38,10 @@
 #include <QtCore/QStringList>
 #include <cstddef>
 
-namespace kate { namespace index {
+namespace kate {
+class HeaderFilesCache;                                     // fwd decl
+namespace index {
+class document;                                             // fwd decl
 
 /**
  * \brief Structure to hold search result
@@ -102,4 +106,9 @@ struct search_result
     search_result& operator=(search_result&&) noexcept;
 };
 
+/// Get ID of an index a given document belongs to
+dbid get_dbid(const document&);
+/// Make a search result from a document of an index
+search_result make_search_result(const document&, const QString&, const HeaderFilesCache&);
+
 }}                                                          // namespace index, kate
@@ -0,0 +1,171 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::searcher (implementation)
+ *
+ * \date Sat Oct 17 00:12:37 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "searcher.h"
+#include "database.h"
+
+// Standard includes
+#include <KDE/KDebug>
+#include <QtCore/QMetaObject>
+#include <algorithm>
+#include <stdexcept>
+
+namespace kate { namespace index {
+
+constexpr doccount searcher::BATCH_SIZE;
+constexpr doccount searcher::NEXT_BATCH_SIZE;
+constexpr doccount searcher::MAX_RESULTS;
+
+searcher::searcher()
+{
+    qRegisterMetaType<search_results_batch>("kate::index::search_results_batch");
+}
+
+searcher::~searcher() = default;
+
+/**
+ * \param[in] query a query string to search for
+ * \param[in] indices indices to search in
+ * \param[in] generation a number to be changed by caller every time
+ * indices (or their content) have changed since a previous request
+ * \return a serial number of the request (to be matched against in
+ * \c found() and \c finished() signals)
+ */
+unsigned searcher::start(const QString& query, const indices_list& indices, const unsigned generation)
+{
+    {
+        std::lock_guard<std::mutex> lock{m_request_mutex};
+        m_query = query;
+        m_requested_indices = indices;
+        m_requested_generation = generation;
+        m_pending = true;
+    }
+    const auto serial = ++m_serial;
+    QMetaObject::invokeMethod(this, "process", Qt::QueuedConnection);
+    return serial;
+}
+
+void searcher::cancel()
+{
+    ++m_serial;
+}
+
+/**
+ * The first batch is small, so it gets displayed as soon as possible.
+ * Other results (if any) are reported by batches of a fixed size, so
+ * a request got obsolete meanwhile stops after the current batch.
+ */
+void searcher::process()
+{
+    auto query = QString{};
+    auto indices = indices_list{};
+    auto generation = 0u;
+    {
+        std::lock_guard<std::mutex> lock{m_request_mutex};
+        if (!m_pending)
+            return;                                         // Already done by a previous call
+        m_pending = false;
+        query = std::move(m_query);
+        indices = std::move(m_requested_indices);
+        generation = m_requested_generation;
+    }
+    const auto serial = unsigned{m_serial};
+
+    auto shown = 0u;
+    auto estimated = 0u;
+    auto error = QString{};
+    try
+    {
+        if (!m_indices_opened || generation != m_opened_generation)
+        {
+            reopen_indices(indices);
+            m_opened_generation = generation;
+        }
+        if (m_indices.empty())
+            throw std::runtime_error("No indices enabled for search...");
+
+        auto offset = doccount{0};
+        for (
+            auto limit = BATCH_SIZE
+          ; limit && !is_obsolete(serial)
+          ; limit = std::min(NEXT_BATCH_SIZE, MAX_RESULTS - offset)
+          )
+        {
+            auto search_results = m_search_db.search_refs(query, offset, limit);
+            auto& batch = search_results.first;
+            estimated = search_results.second;
+            shown += batch.size();
+            offset += limit;
+            const auto done = batch.size() < limit;
+            Q_EMIT(found(serial, std::move(batch)));
+            if (done)
+                break;                                      // Nothing more to get
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error = QString::fromLocal8Bit(e.what());
+    }
+    catch (const Xapian::Error& e)
+    {
+        error = QString::fromLocal8Bit(e.get_msg().c_str());
+    }
+    kDebug(DEBUG_AREA) << "Search request" << serial << "done:" << shown << "results of" << estimated;
+    {
+        std::lock_guard<std::mutex> lock{m_stats_mutex};
+        m_cache_stats = m_search_db.cache_stats();
+    }
+    Q_EMIT(finished(serial, shown, estimated, error));
+}
+
+query_cache_stats searcher::cache_stats() const
+{
+    std::lock_guard<std::mutex> lock{m_stats_mutex};
+    return m_cache_stats;
+}
+
+/**
+ * The same combined index is used all the time (to keep its query cache),
+ * only indices get replaced. New indices are opened before old ones removed,
+ * so a failed attempt leaves nothing half opened.
+ */
+void searcher::reopen_indices(const indices_list& indices)
+{
+    m_indices_opened = false;
+    auto opened = std::vector<std::unique_ptr<ro::database>>{};
+    for (const auto& path : indices)
+        opened.emplace_back(new ro::database{path});
+    for (const auto& db : m_indices)
+        m_search_db.remove_index(db.get());
+    m_indices = std::move(opened);
+    for (const auto& db : m_indices)
+        m_search_db.add_index(db.get());
+    m_indices_opened = true;
+}
+
+}}                                                          // namespace index, kate
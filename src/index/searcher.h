@@ -0,0 +1,123 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::index::searcher (interface)
+ *
+ * \date Sat Oct 17 00:12:37 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "combined_index.h"
+#include "types.h"
+
+// Standard includes
+#include <QtCore/QMetaType>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace kate { namespace index {
+
+/// References to a portion of documents found by \c searcher
+typedef std::vector<docref> search_results_batch;
+
+/**
+ * \brief Search over indices in a background thread
+ *
+ * Move an instance to a thread and call \c start() from any other thread.
+ * Results are reported by \c found() in batches, so the first ones can be
+ * displayed before the whole result set is fetched from indices.
+ * Found documents are not read here: results are references to documents,
+ * and a receiver reads only documents it is going to display.
+ *
+ * Every request gets a serial number, and starting a new request (or
+ * \c cancel()) makes results of a previous one obsolete: a search in
+ * progress stops after the current batch, and signals w/ obsolete serials
+ * should be ignored by receivers.
+ *
+ * The searcher opens its own read-only instances of indices (Xapian DBs
+ * can't be shared between threads), and reopens them only if the given
+ * generation of indices list differs from the previous request.
+ */
+class searcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Paths of indices to search in
+    typedef std::vector<std::string> indices_list;
+
+    static constexpr doccount BATCH_SIZE = 50;              ///< Results to report first
+    static constexpr doccount NEXT_BATCH_SIZE = 250;        ///< Results to report by every next batch
+    static constexpr doccount MAX_RESULTS = 2000;           ///< Results to get for a query
+
+    searcher();
+    ~searcher();
+
+    /// Request a search, get a serial number of the request
+    unsigned start(const QString&, const indices_list&, unsigned);
+    /// Make a request in progress (if any) obsolete
+    void cancel();
+    /// Get query cache usage counters (as of the last finished request)
+    query_cache_stats cache_stats() const;
+
+Q_SIGNALS:
+    /// Request serial and few more results found
+    void found(unsigned, kate::index::search_results_batch);
+    /// Request serial, results found, estimated and an error message (empty on success)
+    void finished(unsigned, unsigned, unsigned, QString);
+
+private Q_SLOTS:
+    void process();
+
+private:
+    void reopen_indices(const indices_list&);
+    bool is_obsolete(unsigned) const;
+
+    std::vector<std::unique_ptr<ro::database>> m_indices;
+    combined_index m_search_db;
+    unsigned m_opened_generation = {0};
+    bool m_indices_opened = {false};
+    std::atomic<unsigned> m_serial = {0};
+    std::mutex m_request_mutex;                             ///< Protects the pending request below
+    QString m_query;
+    indices_list m_requested_indices;
+    unsigned m_requested_generation = {0};
+    bool m_pending = {false};
+    mutable std::mutex m_stats_mutex;                       ///< Protects the counters below
+    query_cache_stats m_cache_stats;
+};
+
+inline bool searcher::is_obsolete(const unsigned serial) const
+{
+    return serial != m_serial;
+}
+
+}}                                                          // namespace index, kate
+
+Q_DECLARE_METATYPE(kate::index::search_results_batch);
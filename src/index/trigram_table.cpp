@@ -0,0 +1,454 @@
+/**
+ * \file
+ *
+ * \brief Classes \c kate::index::trigram_table and \c kate::index::trigram_table_builder (implementation)
+ *
+ * \date Sat Oct 17 03:12:47 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "trigram_table.h"
+#include "database.h"
+#include "details/document_builder.h"
+#include "details/varint.h"
+
+// Standard includes
+#include <boost/filesystem/operations.hpp>
+#include <KDE/KDebug>
+#include <QtCore/QRegExp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace kate { namespace index { namespace {
+
+const char* const TRIGRAM_TABLE_FILENAME = "trigrams";
+const char* const NEW_FILE_SUFFIX = ".new";
+const char MAGIC[4] = {'K', 'T', 'G', 'T'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::size_t TRIGRAM_SIZE = 3;
+
+struct file_header
+{
+    char m_magic[4];
+    std::uint32_t m_version;
+    std::uint64_t m_names;
+    std::uint64_t m_trigrams;
+    std::uint64_t m_names_size;
+};
+
+inline std::uint32_t make_trigram(const char* const str)
+{
+    return std::uint32_t(static_cast<unsigned char>(str[0])) << 16
+      | std::uint32_t(static_cast<unsigned char>(str[1])) << 8
+      | std::uint32_t(static_cast<unsigned char>(str[2]))
+      ;
+}
+
+inline bool is_name_char(const char c)
+{
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || c == '_';
+}
+
+/**
+ * Get literal fragments every match of a regular expression must contain.
+ * Only simple expressions are analyzed: if there are alternatives or groups,
+ * nothing is returned, so every name becomes a candidate.
+ */
+std::vector<std::string> required_literals(const std::string& re)
+{
+    auto result = std::vector<std::string>{};
+    if (re.find_first_of("|()") != std::string::npos)
+        return result;
+
+    auto literal = std::string{};
+    const auto flush = [&result, &literal]()
+    {
+        if (TRIGRAM_SIZE <= literal.size())
+            result.emplace_back(std::move(literal));
+        literal.clear();
+    };
+    for (auto i = std::size_t{}; i < re.size(); ++i)
+    {
+        const auto c = re[i];
+        const auto next = i + 1 < re.size() ? re[i + 1] : '\0';
+        if (is_name_char(c))
+        {
+            // NOTE A char followed by a quantifier may be absent at all
+            if (next == '?' || next == '*' || next == '{')
+                flush();
+            else
+            {
+                literal.push_back(c);
+                if (next == '+')
+                    flush();
+            }
+        }
+        else
+        {
+            flush();
+            if (c == '\\')
+                ++i;                                        // Skip an escaped char (or a class like \w)
+            else if (c == '[')
+            {
+                // NOTE A closing bracket right after an opening one is a char of a set
+                const auto pos = re.find(']', i + 2);
+                i = pos == std::string::npos ? re.size() : pos;
+            }
+            else if (c == '{')
+            {
+                // NOTE Digits of a quantifier are not name chars
+                const auto pos = re.find('}', i + 1);
+                i = pos == std::string::npos ? re.size() : pos;
+            }
+        }
+    }
+    flush();
+
+    for (auto& l : result)
+        details::document_builder::to_lower(std::string{l}, l);
+    return result;
+}
+
+}                                                           // anonymous namespace
+
+std::string trigram_table_path(const std::string& db_path)
+{
+    return (boost::filesystem::path{db_path} / TRIGRAM_TABLE_FILENAME).string();
+}
+
+trigram_table::trigram_table(const std::string& path)
+{
+    if (!path.empty())
+        open(path);
+}
+
+/**
+ * \return \c false if file is absent or has unexpected format
+ */
+bool trigram_table::open(const std::string& path)
+{
+    close();
+    m_file.setFileName(QString::fromLocal8Bit(path.c_str()));
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    const auto size = std::size_t(m_file.size());
+    if (size < sizeof(file_header) || !(m_map = m_file.map(0, m_file.size())))
+    {
+        close();
+        return false;
+    }
+
+    auto header = file_header{};
+    std::memcpy(&header, m_map, sizeof(header));
+    auto rest = size - sizeof(file_header);
+    auto is_valid = std::equal(MAGIC, MAGIC + sizeof(MAGIC), header.m_magic)
+      && header.m_version == VERSION
+      && header.m_trigrams <= rest / sizeof(trigram_entry)
+      ;
+    if (is_valid)
+    {
+        rest -= std::size_t(header.m_trigrams) * sizeof(trigram_entry);
+        is_valid = header.m_names < rest / sizeof(std::uint32_t);
+    }
+    if (is_valid)
+    {
+        rest -= std::size_t(header.m_names + 1) * sizeof(std::uint32_t);
+        is_valid = header.m_names_size <= rest;
+    }
+    if (is_valid)
+    {
+        m_trigrams = reinterpret_cast<const trigram_entry*>(m_map + sizeof(file_header));
+        m_trigrams_count = std::size_t(header.m_trigrams);
+        m_offsets = reinterpret_cast<const std::uint32_t*>(m_trigrams + m_trigrams_count);
+        m_names_count = std::size_t(header.m_names);
+        m_names = reinterpret_cast<const char*>(m_offsets + m_names_count + 1);
+        m_data = reinterpret_cast<const unsigned char*>(m_names + header.m_names_size);
+        m_data_size = rest - std::size_t(header.m_names_size);
+        is_valid = m_offsets[m_names_count] == header.m_names_size;
+    }
+    if (!is_valid)
+    {
+        kDebug(DEBUG_AREA) << "Unexpected format of trigrams table" << path.c_str();
+        close();
+        return false;
+    }
+    return true;
+}
+
+void trigram_table::close()
+{
+    if (m_map)
+        m_file.unmap(m_map);
+    m_file.close();
+    m_map = nullptr;
+    m_trigrams = nullptr;
+    m_offsets = nullptr;
+    m_names = nullptr;
+    m_data = nullptr;
+    m_trigrams_count = 0;
+    m_names_count = 0;
+    m_data_size = 0;
+}
+
+/**
+ * Fragments shorter than a trigram can't be looked up in the table,
+ * so nothing is found.
+ */
+std::vector<std::string> trigram_table::find_substring(const std::string& fragment) const
+{
+    auto result = std::vector<std::string>{};
+    auto lowercased = std::string{};
+    details::document_builder::to_lower(fragment, lowercased);
+    if (lowercased.size() < TRIGRAM_SIZE)
+        return result;
+
+    for (const auto n : candidates({lowercased}))
+    {
+        const auto* const first = m_names + m_offsets[n];
+        const auto* const last = m_names + m_offsets[n + 1];
+        if (std::search(first, last, begin(lowercased), end(lowercased)) != last)
+            result.emplace_back(first, last);
+    }
+    return result;
+}
+
+/**
+ * Literal fragments (required by an expression) give candidates to be
+ * matched against an expression then (case insensitive, anywhere in a name).
+ * If there are no such fragments, every name is a candidate.
+ */
+std::vector<std::string> trigram_table::find_regex(const QString& pattern) const
+{
+    auto result = std::vector<std::string>{};
+    auto re = QRegExp{pattern, Qt::CaseInsensitive, QRegExp::RegExp2};
+    if (!re.isValid() || !m_names_count)
+        return result;
+
+    for (const auto n : candidates(required_literals(pattern.toUtf8().constData())))
+    {
+        auto candidate = name(n);
+        if (re.indexIn(QString::fromUtf8(candidate.c_str())) != -1)
+            result.emplace_back(std::move(candidate));
+    }
+    return result;
+}
+
+/**
+ * Intersect lists of names containing all trigrams of given (lowercased)
+ * fragments, starting from the shortest one.
+ */
+std::vector<std::uint32_t> trigram_table::candidates(const std::vector<std::string>& fragments) const
+{
+    auto trigrams = std::vector<std::uint32_t>{};
+    for (const auto& f : fragments)
+        for (auto i = std::size_t{}; i + TRIGRAM_SIZE <= f.size(); ++i)
+            trigrams.emplace_back(make_trigram(f.data() + i));
+    std::sort(begin(trigrams), end(trigrams));
+    trigrams.erase(std::unique(begin(trigrams), end(trigrams)), end(trigrams));
+
+    auto result = std::vector<std::uint32_t>{};
+    if (trigrams.empty())
+    {
+        result.resize(m_names_count);
+        std::iota(begin(result), end(result), 0u);
+        return result;
+    }
+
+    auto entries = std::vector<const trigram_entry*>{};
+    const auto* const last = m_trigrams + m_trigrams_count;
+    for (const auto trigram : trigrams)
+    {
+        const auto* const it = std::lower_bound(
+            m_trigrams
+          , last
+          , trigram
+          , [](const trigram_entry& entry, const std::uint32_t t)
+            {
+                return entry.m_trigram < t;
+            }
+          );
+        if (it == last || it->m_trigram != trigram)
+            return result;                                  // No name has this trigram
+        entries.emplace_back(it);
+    }
+    std::sort(
+        begin(entries)
+      , end(entries)
+      , [](const trigram_entry* lhs, const trigram_entry* rhs)
+        {
+            return lhs->m_count < rhs->m_count;
+        }
+      );
+
+    decode(entries.front(), result);
+    auto list = std::vector<std::uint32_t>{};
+    auto common = std::vector<std::uint32_t>{};
+    for (auto it = std::next(begin(entries)), end_it = end(entries); it != end_it && !result.empty(); ++it)
+    {
+        list.clear();
+        decode(*it, list);
+        common.clear();
+        std::set_intersection(begin(result), end(result), begin(list), end(list), std::back_inserter(common));
+        result.swap(common);
+    }
+    return result;
+}
+
+/// Names list of a trigram ends where a list of the next trigram begins
+void trigram_table::decode(const trigram_entry* const entry, std::vector<std::uint32_t>& result) const
+{
+    const auto end_offset = entry + 1 != m_trigrams + m_trigrams_count
+      ? (entry + 1)->m_offset
+      : std::uint64_t(m_data_size)
+      ;
+    if (end_offset < entry->m_offset || m_data_size < end_offset)
+    {
+        kDebug(DEBUG_AREA) << "Trigrams table is corrupted: trigram data out of range";
+        return;
+    }
+    const auto* pos = m_data + entry->m_offset;
+    const auto* const last = m_data + end_offset;
+    auto n = std::uint64_t{};
+    result.reserve(result.size() + entry->m_count);
+    for (auto i = 0u; i < entry->m_count; ++i)
+    {
+        auto delta = std::uint64_t{};
+        if (!details::get_varint(pos, last, delta) || m_names_count <= (n += delta))
+        {
+            kDebug(DEBUG_AREA) << "Trigrams table is corrupted: unexpected trigram data";
+            break;
+        }
+        result.emplace_back(std::uint32_t(n));
+    }
+}
+
+std::string trigram_table::name(const std::uint32_t n) const
+{
+    return std::string{m_names + m_offsets[n], m_names + m_offsets[n + 1]};
+}
+
+void trigram_table_builder::add(const std::string& name)
+{
+    m_names.emplace_back();
+    details::document_builder::to_lower(name, m_names.back());
+}
+
+void trigram_table_builder::add(const trigram_table& table)
+{
+    m_names.reserve(m_names.size() + table.names_count());
+    for (auto n = std::uint32_t{}; n < table.names_count(); ++n)
+        m_names.emplace_back(table.name(n));
+}
+
+/**
+ * A table is written aside first, then it replaces an existed one,
+ * so a mapped (by some reader) table remains valid.
+ */
+std::uint64_t trigram_table_builder::write(const std::string& path)
+{
+    std::sort(begin(m_names), end(m_names));
+    m_names.erase(std::unique(begin(m_names), end(m_names)), end(m_names));
+    m_names.erase(
+        std::remove_if(begin(m_names), end(m_names), [](const std::string& n) { return n.empty(); })
+      , end(m_names)
+      );
+
+    // Make names list and (trigram, name number) pairs
+    auto names = std::string{};
+    auto offsets = std::vector<std::uint32_t>{0};
+    auto postings = std::vector<std::pair<std::uint32_t, std::uint32_t>>{};
+    offsets.reserve(m_names.size() + 1);
+    for (auto n = std::uint32_t{}; n < m_names.size(); ++n)
+    {
+        const auto& name = m_names[n];
+        names += name;
+        if (std::numeric_limits<std::uint32_t>::max() < names.size())
+            throw exception::database_failure{"Too many names for trigrams table [" + path + "]"};
+        offsets.emplace_back(std::uint32_t(names.size()));
+        for (auto i = std::size_t{}; i + TRIGRAM_SIZE <= name.size(); ++i)
+            postings.emplace_back(make_trigram(name.data() + i), n);
+    }
+    std::sort(begin(postings), end(postings));
+    postings.erase(std::unique(begin(postings), end(postings)), end(postings));
+
+    // Encode names lists of every trigram
+    auto trigrams = std::vector<trigram_table::trigram_entry>{};
+    auto data = std::string{};
+    for (auto it = begin(postings), last = end(postings); it != last;)
+    {
+        auto entry = trigram_table::trigram_entry{it->first, 0, data.size()};
+        auto prev = std::uint32_t{};
+        for (; it != last && it->first == entry.m_trigram; ++it, ++entry.m_count)
+        {
+            details::put_varint(data, it->second - prev);
+            prev = it->second;
+        }
+        trigrams.push_back(entry);
+    }
+
+    const auto new_path = path + NEW_FILE_SUFFIX;
+    {
+        auto header = file_header{};
+        std::copy(MAGIC, MAGIC + sizeof(MAGIC), header.m_magic);
+        header.m_version = VERSION;
+        header.m_names = m_names.size();
+        header.m_trigrams = trigrams.size();
+        header.m_names_size = names.size();
+
+        std::ofstream out{new_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(
+            reinterpret_cast<const char*>(trigrams.data())
+          , std::streamsize(trigrams.size() * sizeof(trigram_table::trigram_entry))
+          );
+        out.write(
+            reinterpret_cast<const char*>(offsets.data())
+          , std::streamsize(offsets.size() * sizeof(std::uint32_t))
+          );
+        out.write(names.data(), std::streamsize(names.size()));
+        out.write(data.data(), std::streamsize(data.size()));
+        out.close();
+        if (!out)
+            throw exception::database_failure{"Can't write trigrams table [" + new_path + "]"};
+    }
+    try
+    {
+        boost::filesystem::rename(new_path, path);
+    }
+    catch (const boost::filesystem::filesystem_error& e)
+    {
+        throw exception::database_failure{"Can't write trigrams table [" + path + "]: " + e.what()};
+    }
+    return sizeof(file_header)
+      + trigrams.size() * sizeof(trigram_table::trigram_entry)
+      + offsets.size() * sizeof(std::uint32_t)
+      + names.size()
+      + data.size()
+      ;
+}
+
+}}                                                          // namespace index, kate
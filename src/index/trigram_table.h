@@ -0,0 +1,158 @@
+/**
+ * \file
+ *
+ * \brief Classes \c kate::index::trigram_table and \c kate::index::trigram_table_builder (interface)
+ *
+ * \date Sat Oct 17 03:12:47 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+
+// Standard includes
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kate { namespace index {
+
+/// Get a path to a trigrams table of a DB at a given path
+std::string trigram_table_path(const std::string&);
+
+/**
+ * \brief Read-only trigrams table of declaration names mapped into memory
+ *
+ * Xapian can expand a trailing wildcard only, and only by scanning all terms
+ * w/ a given prefix. To find names containing some fragment (or matching
+ * a regular expression), the table maps every trigram (three consecutive
+ * chars) of lowercased declaration names to a list of names containing it.
+ * Candidates (names w/ all trigrams of a fragment) are verified then.
+ * Found names are the same as (lowercased) name terms of documents.
+ * The file lives in a Xapian DB directory.
+ *
+ * File layout (native byte order):
+ * \code
+ *  header      magic "KTGT", version (u32), names count (u64), trigrams count (u64), names size (u64)
+ *  trigrams    sorted: trigram (u32), names count (u32), data offset (u64)
+ *  offsets     per name (plus one past the last): offset in names (u32)
+ *  names       sorted lowercased names w/o separators
+ *  data        per trigram: ascending names numbers (delta-encoded)
+ * \endcode
+ *
+ * \note Missed file (e.g. DB made by an older version or w/ a \c navigation
+ * profile) is not an error: the table is just empty.
+ */
+class trigram_table
+{
+public:
+    /// Map a table from a given file (if any)
+    explicit trigram_table(const std::string& = std::string{});
+    /// Delete copy ctor
+    trigram_table(const trigram_table&) = delete;
+    /// Delete copy-assign operator
+    trigram_table& operator=(const trigram_table&) = delete;
+
+    bool open(const std::string&);
+    void close();
+
+    bool is_open() const;
+    std::size_t names_count() const;
+    /// Get names containing a given fragment (at least 3 chars long)
+    std::vector<std::string> find_substring(const std::string&) const;
+    /// Get names matching a given regular expression
+    std::vector<std::string> find_regex(const QString&) const;
+
+private:
+    friend class trigram_table_builder;
+
+    struct trigram_entry
+    {
+        std::uint32_t m_trigram;
+        std::uint32_t m_count;
+        std::uint64_t m_offset;
+    };
+
+    std::vector<std::uint32_t> candidates(const std::vector<std::string>&) const;
+    void decode(const trigram_entry*, std::vector<std::uint32_t>&) const;
+    std::string name(std::uint32_t) const;
+
+    QFile m_file;
+    uchar* m_map = {nullptr};
+    const trigram_entry* m_trigrams = {nullptr};
+    const std::uint32_t* m_offsets = {nullptr};
+    const char* m_names = {nullptr};
+    const unsigned char* m_data = {nullptr};
+    std::size_t m_trigrams_count = {0};
+    std::size_t m_names_count = {0};
+    std::size_t m_data_size = {0};
+};
+
+inline bool trigram_table::is_open() const
+{
+    return m_map;
+}
+
+inline std::size_t trigram_table::names_count() const
+{
+    return m_names_count;
+}
+
+/**
+ * \brief Collect declaration names to be written as a \c trigram_table
+ *
+ * Names are lowercased (just like name terms of documents) and
+ * deduplicated on write.
+ */
+class trigram_table_builder
+{
+public:
+    void add(const std::string&);
+    template <typename Iter>
+    void add(Iter, Iter);
+    /// Add all names of an existed table (e.g. to update it)
+    void add(const trigram_table&);
+    /// Write a table (replacing an existed one), return its size in bytes
+    std::uint64_t write(const std::string&);
+
+    std::size_t size() const;
+
+private:
+    std::vector<std::string> m_names;
+};
+
+template <typename Iter>
+inline void trigram_table_builder::add(Iter first, Iter last)
+{
+    for (; first != last; ++first)
+        add(*first);
+}
+
+inline std::size_t trigram_table_builder::size() const
+{
+    return m_names.size();
+}
+
+}}                                                          // namespace index, kate
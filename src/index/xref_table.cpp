@@ -0,0 +1,276 @@
+/**
+ * \file
+ *
+ * \brief Classes \c kate::index::xref_table and \c kate::index::xref_table_builder (implementation)
+ *
+ * \date Fri Oct 16 23:42:10 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "xref_table.h"
+#include "database.h"
+#include "details/varint.h"
+
+// Standard includes
+#include <boost/filesystem/operations.hpp>
+#include <KDE/KDebug>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <tuple>
+
+namespace kate { namespace index { namespace {
+
+const char* const XREF_TABLE_FILENAME = "xrefs";
+const char* const NEW_FILE_SUFFIX = ".new";
+const char MAGIC[4] = {'K', 'X', 'R', 'T'};
+constexpr std::uint32_t VERSION = 1;
+
+struct file_header
+{
+    char m_magic[4];
+    std::uint32_t m_version;
+    std::uint64_t m_symbols;
+};
+
+/// Map signed deltas to unsigned, so small negative values have short encoding as well
+inline std::uint64_t zigzag(const std::int64_t value)
+{
+    return (std::uint64_t(value) << 1) ^ std::uint64_t(value >> 63);
+}
+
+inline std::int64_t unzigzag(const std::uint64_t value)
+{
+    return std::int64_t(value >> 1) ^ -std::int64_t(value & 1);
+}
+
+}                                                           // anonymous namespace
+
+std::string xref_table_path(const std::string& db_path)
+{
+    return (boost::filesystem::path{db_path} / XREF_TABLE_FILENAME).string();
+}
+
+xref_table::xref_table(const std::string& path)
+{
+    if (!path.empty())
+        open(path);
+}
+
+/**
+ * \return \c false if file is absent or has unexpected format
+ */
+bool xref_table::open(const std::string& path)
+{
+    close();
+    m_file.setFileName(QString::fromLocal8Bit(path.c_str()));
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    const auto size = std::size_t(m_file.size());
+    if (size < sizeof(file_header) || !(m_map = m_file.map(0, m_file.size())))
+    {
+        close();
+        return false;
+    }
+
+    auto header = file_header{};
+    std::memcpy(&header, m_map, sizeof(header));
+    const auto is_valid = std::equal(MAGIC, MAGIC + sizeof(MAGIC), header.m_magic)
+      && header.m_version == VERSION
+      && header.m_symbols <= (size - sizeof(file_header)) / sizeof(symbol_entry)
+      ;
+    if (!is_valid)
+    {
+        kDebug(DEBUG_AREA) << "Unexpected format of references table" << path.c_str();
+        close();
+        return false;
+    }
+    m_symbols = reinterpret_cast<const symbol_entry*>(m_map + sizeof(file_header));
+    m_symbols_count = std::size_t(header.m_symbols);
+    m_data = reinterpret_cast<const unsigned char*>(m_symbols + m_symbols_count);
+    m_data_size = size - std::size_t(m_data - m_map);
+    return true;
+}
+
+void xref_table::close()
+{
+    if (m_map)
+        m_file.unmap(m_map);
+    m_file.close();
+    m_map = nullptr;
+    m_symbols = nullptr;
+    m_data = nullptr;
+    m_symbols_count = 0;
+    m_data_size = 0;
+}
+
+/**
+ * Just a binary search over the (mapped) symbols list, and then
+ * decoding of the only references list.
+ */
+std::vector<xref> xref_table::find(const symbol_id symbol) const
+{
+    auto result = std::vector<xref>{};
+    const auto* const last = m_symbols + m_symbols_count;
+    const auto* const it = std::lower_bound(
+        m_symbols
+      , last
+      , symbol
+      , [](const symbol_entry& entry, const symbol_id id)
+        {
+            return entry.m_symbol < id;
+        }
+      );
+    if (it != last && it->m_symbol == symbol)
+        decode(*it, result);
+    return result;
+}
+
+void xref_table::decode(const symbol_entry& entry, std::vector<xref>& result) const
+{
+    if (m_data_size < entry.m_offset || m_data_size - entry.m_offset < entry.m_size)
+    {
+        kDebug(DEBUG_AREA) << "References table is corrupted: symbol data out of range";
+        return;
+    }
+    const auto* pos = m_data + entry.m_offset;
+    const auto* const last = pos + entry.m_size;
+    auto ref = xref{0, 0, 0, 0};
+    result.reserve(result.size() + entry.m_count);
+    for (auto i = 0u; i < entry.m_count; ++i)
+    {
+        std::uint64_t file, line, column, container;
+        const auto is_ok = details::get_varint(pos, last, file)
+          && details::get_varint(pos, last, line)
+          && details::get_varint(pos, last, column)
+          && details::get_varint(pos, last, container)
+          ;
+        if (!is_ok)
+        {
+            kDebug(DEBUG_AREA) << "References table is corrupted: unexpected end of symbol data";
+            break;
+        }
+        ref.m_line = std::uint32_t(file ? line : ref.m_line + line);
+        ref.m_file += fileid(file);
+        ref.m_column = std::uint32_t(column);
+        ref.m_container = docid(std::int64_t(ref.m_container) + unzigzag(container));
+        result.push_back(ref);
+    }
+}
+
+void xref_table_builder::load(const xref_table& table)
+{
+    auto refs = std::vector<xref>{};
+    for (auto i = std::size_t{}; i < table.m_symbols_count; ++i)
+    {
+        const auto& entry = table.m_symbols[i];
+        refs.clear();
+        table.decode(entry, refs);
+        for (const auto& ref : refs)
+            m_refs.emplace_back(entry.m_symbol, ref);
+    }
+}
+
+void xref_table_builder::remove_file(const fileid file)
+{
+    m_refs.erase(
+        std::remove_if(
+            begin(m_refs)
+          , end(m_refs)
+          , [file](const value_type& v)
+            {
+                return v.second.m_file == file;
+            }
+          )
+      , end(m_refs)
+      );
+}
+
+/**
+ * A table is written aside first, then it replaces an existed one,
+ * so a mapped (by some reader) table remains valid.
+ */
+std::uint64_t xref_table_builder::write(const std::string& path)
+{
+    std::sort(
+        begin(m_refs)
+      , end(m_refs)
+      , [](const value_type& lhs, const value_type& rhs)
+        {
+            return std::tie(lhs.first, lhs.second.m_file, lhs.second.m_line, lhs.second.m_column)
+              < std::tie(rhs.first, rhs.second.m_file, rhs.second.m_line, rhs.second.m_column)
+              ;
+        }
+      );
+    m_refs.erase(std::unique(begin(m_refs), end(m_refs)), end(m_refs));
+
+    // Encode references of every symbol
+    auto symbols = std::vector<xref_table::symbol_entry>{};
+    auto data = std::string{};
+    for (auto it = begin(m_refs), last = end(m_refs); it != last;)
+    {
+        auto entry = xref_table::symbol_entry{it->first, data.size(), 0, 0};
+        auto prev = xref{0, 0, 0, 0};
+        for (; it != last && it->first == entry.m_symbol; ++it, ++entry.m_count)
+        {
+            const auto& ref = it->second;
+            details::put_varint(data, ref.m_file - prev.m_file);
+            details::put_varint(data, ref.m_file == prev.m_file ? ref.m_line - prev.m_line : ref.m_line);
+            details::put_varint(data, ref.m_column);
+            details::put_varint(data, zigzag(std::int64_t(ref.m_container) - std::int64_t(prev.m_container)));
+            prev = ref;
+        }
+        entry.m_size = std::uint32_t(data.size() - entry.m_offset);
+        symbols.push_back(entry);
+    }
+
+    const auto new_path = path + NEW_FILE_SUFFIX;
+    {
+        auto header = file_header{};
+        std::copy(MAGIC, MAGIC + sizeof(MAGIC), header.m_magic);
+        header.m_version = VERSION;
+        header.m_symbols = symbols.size();
+
+        std::ofstream out{new_path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(
+            reinterpret_cast<const char*>(symbols.data())
+          , std::streamsize(symbols.size() * sizeof(xref_table::symbol_entry))
+          );
+        out.write(data.data(), std::streamsize(data.size()));
+        out.close();
+        if (!out)
+            throw exception::database_failure{"Can't write references table [" + new_path + "]"};
+    }
+    try
+    {
+        boost::filesystem::rename(new_path, path);
+    }
+    catch (const boost::filesystem::filesystem_error& e)
+    {
+        throw exception::database_failure{"Can't write references table [" + path + "]: " + e.what()};
+    }
+    return sizeof(file_header) + symbols.size() * sizeof(xref_table::symbol_entry) + data.size();
+}
+
+}}                                                          // namespace index, kate
@@ -0,0 +1,175 @@
+/**
+ * \file
+ *
+ * \brief Classes \c kate::index::xref_table and \c kate::index::xref_table_builder (interface)
+ *
+ * \date Fri Oct 16 23:42:10 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "types.h"
+
+// Standard includes
+#include <QtCore/QFile>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace kate { namespace index {
+
+/// Reference to an entity: location and lexical container
+struct xref
+{
+    fileid m_file;
+    std::uint32_t m_line;
+    std::uint32_t m_column;
+    docid m_container;                                      ///< Document ID of a container (\c 0 if none)
+};
+
+inline bool operator==(const xref& lhs, const xref& rhs)
+{
+    return lhs.m_file == rhs.m_file && lhs.m_line == rhs.m_line && lhs.m_column == rhs.m_column;
+}
+
+/// Get a path to a cross references table of a DB at a given path
+std::string xref_table_path(const std::string&);
+
+/**
+ * \brief Read-only cross references table mapped into memory
+ *
+ * References are too many to make a Xapian document of every one
+ * (w/ name terms and value slots). Instead, the table maps a symbol ID
+ * (hash of an entity USR, see \c usr_hash()) to a list of references,
+ * sorted by location and delta-encoded (as variable length integers).
+ * The file lives in a Xapian DB directory.
+ *
+ * File layout (native byte order):
+ * \code
+ *  header      magic "KXRT", version (u32), symbols count (u64)
+ *  symbols     sorted by ID: ID (u64), data offset (u64), references count (u32), data size (u32)
+ *  data        per symbol: file delta, line (delta if the same file), column, zigzag container delta
+ * \endcode
+ *
+ * \note Missed file (e.g. DB made by an older version) is not an error:
+ * the table is just empty.
+ */
+class xref_table
+{
+public:
+    typedef std::uint64_t symbol_id;
+
+    /// Map a table from a given file (if any)
+    explicit xref_table(const std::string& = std::string{});
+    /// Delete copy ctor
+    xref_table(const xref_table&) = delete;
+    /// Delete copy-assign operator
+    xref_table& operator=(const xref_table&) = delete;
+
+    bool open(const std::string&);
+    void close();
+
+    bool is_open() const;
+    std::size_t symbols_count() const;
+    /// Get all references to an entity w/ a given symbol ID
+    std::vector<xref> find(symbol_id) const;
+
+private:
+    friend class xref_table_builder;
+
+    struct symbol_entry
+    {
+        symbol_id m_symbol;
+        std::uint64_t m_offset;
+        std::uint32_t m_count;
+        std::uint32_t m_size;
+    };
+
+    void decode(const symbol_entry&, std::vector<xref>&) const;
+
+    QFile m_file;
+    uchar* m_map = {nullptr};
+    const symbol_entry* m_symbols = {nullptr};
+    const unsigned char* m_data = {nullptr};
+    std::size_t m_symbols_count = {0};
+    std::size_t m_data_size = {0};
+};
+
+inline bool xref_table::is_open() const
+{
+    return m_map;
+}
+
+inline std::size_t xref_table::symbols_count() const
+{
+    return m_symbols_count;
+}
+
+/**
+ * \brief Collect references to be written as a \c xref_table
+ *
+ * Every reference is owned by a file where it is located. So, when
+ * a TU gets reindexed, references located in its main file can be removed
+ * (and then added again). Duplicates (a header included by few TUs)
+ * are removed on write.
+ */
+class xref_table_builder
+{
+public:
+    typedef std::pair<xref_table::symbol_id, xref> value_type;
+
+    void add(xref_table::symbol_id, const xref&);
+    template <typename Iter>
+    void add(Iter, Iter);
+    /// Add all references from a table (to be updated)
+    void load(const xref_table&);
+    /// Remove all references located in a given file
+    void remove_file(fileid);
+    /// Write a table (replacing an existed one), return its size in bytes
+    std::uint64_t write(const std::string&);
+
+    std::size_t size() const;
+
+private:
+    std::vector<value_type> m_refs;
+};
+
+inline void xref_table_builder::add(const xref_table::symbol_id symbol, const xref& ref)
+{
+    m_refs.emplace_back(symbol, ref);
+}
+
+template <typename Iter>
+inline void xref_table_builder::add(Iter first, Iter last)
+{
+    m_refs.insert(end(m_refs), first, last);
+}
+
+inline std::size_t xref_table_builder::size() const
+{
+    return m_refs.size();
+}
+
+}}                                                          // namespace index, kate
@@ -28,6 +28,7 @@
 // Project specific includes
 #include "indices_table_model.h"
 #include "database_manager.h"
+#include "index/indexing_profile.h"
 
 // Standard includes
 #include <KDE/KLocalizedString>
@@ -75,6 +76,23 @@ QVariant IndicesTableModel::data(const QModelIndex& index, const int role) const
             {
                 case column::NAME:
                     return m_db_mgr.m_collections[index.row()].m_options->name();
+                case column::PROFILE:
+                {
+                    const auto& state = m_db_mgr.m_collections[index.row()];
+                    const auto configured = index::indexing_profile(state.m_options->indexingProfile());
+                    // NOTE Show the profile an index was built w/ (unknown for DBs made by older versions)
+                    if (!state.m_db || state.m_db->profile() == index::indexing_profile::last__)
+                        return index::toString(configured);
+                    const auto built = state.m_db->profile();
+                    if (built == configured)
+                        return index::toString(built);
+                    return i18nc(
+                        "@item:intable"
+                      , "%1 (reindex to make it %2)"
+                      , index::toString(built)
+                      , index::toString(configured)
+                      );
+                }
                 default:
                     break;
             }
@@ -107,6 +125,8 @@ QVariant IndicesTableModel::headerData(
             {
                 case column::NAME:
                     return i18nc("@title:row", "Name");
+                case column::PROFILE:
+                    return i18nc("@title:row", "Profile");
                 default:
                     break;
             }
@@ -147,8 +167,7 @@ bool IndicesTableModel::setData(const QModelIndex& index, const QVariant& value,
 
 void IndicesTableModel::refreshRow(const int row)
 {
-    auto index = createIndex(row, column::NAME);
-    Q_EMIT(dataChanged(index, index));
+    Q_EMIT(dataChanged(createIndex(row, column::NAME), createIndex(row, column::PROFILE)));
 }
 
 }                                                           // namespace kate
@@ -79,6 +79,7 @@ private:
     enum column
     {
         NAME
+      , PROFILE
       , last__
     };
 
@@ -0,0 +1,244 @@
+/**
+ * \file
+ *
+ * \brief Headless C/C++ sources indexer (\c kate-cpp-indexer)
+ *
+ * \date Fri Oct 16 21:16:02 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+// Project specific includes
+#include "config.h"
+#include "batch_indexer.h"
+#include "clang/compilation_database.h"
+#include "clang/location.h"
+#include "index/indexer.h"
+#include "index/utils.h"
+#include "database_options.h"                               // NOTE generated file from build dir
+
+// Standard includes
+#include <boost/uuid/random_generator.hpp>
+#include <KDE/KAboutData>
+#include <KDE/KCmdLineArgs>
+#include <KDE/KComponentData>
+#include <KDE/KLocalizedString>
+#include <KDE/KSharedConfig>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTimer>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+const char* const DB_MANIFEST_FILE = "manifest";
+
+void error(const QString& msg)
+{
+    std::fprintf(stderr, "kate-cpp-indexer: %s\n", msg.toLocal8Bit().constData());
+}
+}                                                           // anonymous namespace
+
+/**
+ * Index settings are taken from a manifest of an index (the same file used by
+ * the plugin), or/and from the command line. W/o a manifest a new one is written
+ * to the output directory, so the index can be copied to the plugin's indices
+ * directory of another machine and used there.
+ */
+int main(int argc, char* argv[])
+{
+    using namespace kate;
+
+    KAboutData about{
+        "kate-cpp-indexer"
+      , "kate_cpphelper_plugin"
+      , ki18n("C++ Indexer")
+      , PLUGIN_VERSION
+      , ki18n("Build a C/C++ sources index for Kate C++ Helper Plugin")
+      , KAboutData::License_LGPL_V3
+      };
+    KCmdLineArgs::init(argc, argv, &about);
+
+    KCmdLineOptions options;
+    options.add("m");
+    options.add("manifest <file>", ki18n("Take index settings from a manifest (as written by the plugin)"));
+    options.add("o");
+    options.add("output <dir>", ki18n("Directory to write the index to (defaults to a path from the manifest)"));
+    options.add("name <name>", ki18n("Name of a new index (used w/o a manifest)"));
+    options.add("p");
+    options.add("compilation-database <path>", ki18n("Compilation database (compile_commands.json) to get source files and their options from"));
+    options.add("j");
+    options.add("jobs <count>", ki18n("Number of parallel parsing jobs (0 means number of CPU cores)"));
+    options.add("compiler-option <option>", ki18n("Compiler option to parse sources (not listed in a compilation database) with"));
+    options.add("exclude <wildcard>", ki18n("Skip directories w/ matching names while looking for sources"));
+    options.add("index-locals", ki18n("Index function local symbols"));
+    options.add("profile <name>", ki18n("What to store into the index: navigation, standard or full"));
+    options.add("incremental", ki18n("Reparse only new and changed sources of an existing index"));
+    options.add("partial", ki18n("Reparse given targets only, keep other sources of an existing index (w/ --incremental)"));
+    options.add("declarations-only", ki18n("Skip function bodies and references (fast, but incomplete index)"));
+    options.add("low-priority", ki18n("Run parsing jobs w/ the lowest priority"));
+    options.add("report", ki18n("Write machine readable progress report to the standard output"));
+    options.add("+[target]", ki18n("Directory or source file to index"));
+    KCmdLineArgs::addCmdLineOptions(options);
+
+    QCoreApplication app{argc, argv};
+    KComponentData component{&about};
+    qRegisterMetaType<clang::location>("clang::location");
+    qRegisterMetaType<clang::diagnostic_message>("clang::diagnostic_message");
+
+    auto* const args = KCmdLineArgs::parsedArgs();
+
+    // Get index settings from a manifest (if any)
+    auto manifest = std::unique_ptr<DatabaseOptions>{};
+    const auto has_manifest = args->isSet("manifest");
+    auto manifest_file = has_manifest
+      ? QFileInfo{args->getOption("manifest")}.absoluteFilePath()
+      : QString{};
+    if (has_manifest && !QFileInfo{manifest_file}.isReadable())
+    {
+        error(i18nc("@info/plain", "Can't read manifest: %1", manifest_file));
+        return BatchIndexer::Failure;
+    }
+    if (args->isSet("output"))
+    {
+        const auto output = QFileInfo{args->getOption("output")}.absoluteFilePath();
+        if (!has_manifest)
+            manifest_file = QDir{output}.filePath(DB_MANIFEST_FILE);
+        QDir{}.mkpath(output);
+        manifest.reset(new DatabaseOptions{KSharedConfig::openConfig(manifest_file, KConfig::SimpleConfig)});
+        manifest->setPath(output);
+    }
+    else if (has_manifest)
+        manifest.reset(new DatabaseOptions{KSharedConfig::openConfig(manifest_file, KConfig::SimpleConfig)});
+    else
+    {
+        KCmdLineArgs::usageError(i18nc("@info/plain", "Neither manifest nor output directory specified"));
+        return BatchIndexer::Failure;
+    }
+
+    // Override settings from the command line
+    if (manifest->uuid().isEmpty())
+        manifest->setUuid(index::toString(boost::uuids::random_generator{}()));
+    if (args->isSet("name"))
+        manifest->setName(args->getOption("name"));
+    else if (manifest->name().isEmpty())
+        manifest->setName(QFileInfo{manifest->path()}.fileName());
+    if (args->isSet("compilation-database"))
+        manifest->setCompilationDatabase(QFileInfo{args->getOption("compilation-database")}.absoluteFilePath());
+    if (args->isSet("jobs"))
+        manifest->setIndexingJobs(args->getOption("jobs").toInt());
+    if (args->isSet("exclude"))
+        manifest->setExcludedDirectories(args->getOptionList("exclude"));
+    if (args->isSet("index-locals"))
+        manifest->setIndexLocals(true);
+    if (args->isSet("profile"))
+    {
+        const auto name = std::string{args->getOption("profile").toUtf8().constData()};
+        auto profile = 0;
+        while (profile < int(index::indexing_profile::last__)
+          && index::to_string(index::indexing_profile(profile)) != name)
+            ++profile;
+        if (profile == int(index::indexing_profile::last__))
+        {
+            KCmdLineArgs::usageError(i18nc("@info/plain", "Unknown indexing profile: %1", name.c_str()));
+            return BatchIndexer::Failure;
+        }
+        manifest->setIndexingProfile(profile);
+    }
+    if (args->count())
+    {
+        auto targets = QStringList{};
+        for (auto i = 0; i < args->count(); ++i)
+            targets << QFileInfo{args->arg(i)}.absoluteFilePath();
+        manifest->setTargets(targets);
+    }
+    // NOTE Do not touch a manifest given by a user
+    if (!has_manifest)
+        manifest->writeConfig();
+
+    if (manifest->targets().empty() && manifest->compilationDatabase().isEmpty())
+    {
+        KCmdLineArgs::usageError(i18nc("@info/plain", "No index targets specified"));
+        return BatchIndexer::Failure;
+    }
+
+    // Make an indexer
+    auto indexer = std::unique_ptr<index::indexer>{};
+    const auto compiler_options_list = args->getOptionList("compiler-option");
+    auto compiler_options = std::vector<std::string>{};
+    for (const auto& opt : compiler_options_list)
+        compiler_options.emplace_back(opt.toUtf8().constData());
+    try
+    {
+        const auto db_id = index::make_dbid(index::fromString(manifest->uuid()));
+        indexer.reset(new index::indexer{db_id, manifest->path().toUtf8().constData()});
+        auto indexing_options = index::indexer::default_indexing_options();
+        if (manifest->indexLocals())
+            indexing_options |= CXIndexOpt_IndexFunctionLocalSymbols;
+        if (manifest->skipImplicitTemplateInstantiations())
+            indexing_options |= CXIndexOpt_IndexImplicitTemplateInstantiations;
+        auto options_ptrs = std::vector<const char*>{};
+        for (const auto& opt : compiler_options)
+            options_ptrs.push_back(opt.c_str());
+        indexer->set_indexing_options(indexing_options)
+          .set_incremental(args->isSet("incremental"))
+          .set_partial(args->isSet("partial"))
+          .set_declarations_only(args->isSet("declarations-only"))
+          .set_profile(index::indexing_profile(manifest->indexingProfile()))
+          .set_low_priority(args->isSet("low-priority"))
+          .set_jobs_count(unsigned(manifest->indexingJobs()))
+          .set_commit_threshold(
+              std::size_t(manifest->commitDocuments())
+            , std::size_t(manifest->commitMegabytes()) * 1024 * 1024
+            )
+          .set_excluded_directories(manifest->excludedDirectories())
+          .set_compiler_options(std::move(options_ptrs));
+        if (!manifest->compilationDatabase().isEmpty())
+            indexer->set_compile_commands(clang::compilation_database{manifest->compilationDatabase()}.get_all());
+        for (const auto& tgt : manifest->targets())
+            indexer->add_target(tgt);
+    }
+    catch (const clang::compilation_database::exception& e)
+    {
+        error(e.what());
+        return BatchIndexer::Failure;
+    }
+    catch (const Xapian::Error& e)
+    {
+        error(i18nc("@info/plain", "Can't open index %1: %2", manifest->path(), e.get_msg().c_str()));
+        return BatchIndexer::Failure;
+    }
+    const auto report = args->isSet("report");
+    args->clear();
+
+    auto result = 0;
+    {
+        BatchIndexer batch{std::move(indexer), report};
+        if (!batch.catchTerminationSignals())
+            error(i18nc("@info/plain", "Failed to setup signal handlers"));
+        QTimer::singleShot(0, &batch, SLOT(start()));
+        result = app.exec();
+    }                                                       // NOTE Close the index before exit
+    return result;
+}
@@ -31,8 +31,12 @@
 
 // Standard includes
 #include <KDE/KLocalizedString>
+#include <algorithm>
 
-namespace kate {
+namespace kate { namespace {
+/// Rows to make from found documents at once
+constexpr std::size_t FETCH_SIZE = 100;
+}                                                           // anonymous namespace
 
 int SearchResultsTableModel::columnCount(const QModelIndex&) const
 {
@@ -134,4 +138,41 @@ Qt::ItemFlags SearchResultsTableModel::flags(const QModelIndex&) const
     return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
 }
 
+bool SearchResultsTableModel::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && m_results.size() < m_refs.size();
+}
+
+/**
+ * Make few more rows from found documents (if any)
+ */
+void SearchResultsTableModel::fetchMore(const QModelIndex& parent)
+{
+    if (!canFetchMore(parent))
+        return;
+    const auto first = m_results.size();
+    const auto last = std::min(first + FETCH_SIZE, m_refs.size());
+    beginInsertRows(QModelIndex{}, int(first), int(last) - 1);
+    m_results.reserve(last);
+    for (auto i = first; i < last; ++i)
+        m_results.emplace_back(m_db_mgr.getSearchResult(m_refs[i]));
+    endInsertRows();
+}
+
+/**
+ * Rows for the first results are made immediately, the rest are made
+ * when a view asks for them (i.e. scrolled to the end).
+ */
+void SearchResultsTableModel::appendSearchResults(
+    const unsigned serial
+  , const index::search_results_batch& batch
+  )
+{
+    if (!serial || serial != m_serial || batch.empty())
+        return;
+    m_refs.insert(end(m_refs), begin(batch), end(batch));
+    if (m_results.size() < FETCH_SIZE)
+        fetchMore(QModelIndex{});
+}
+
 }                                                           // namespace kate
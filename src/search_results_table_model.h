@@ -31,6 +31,7 @@
 #include "clang/location.h"
 #include "index/kind.h"
 #include "index/search_result.h"
+#include "index/searcher.h"
 
 // Standard includes
 #include <QtCore/QAbstractItemModel>
@@ -38,10 +39,14 @@
 #include <vector>
 
 namespace kate {
+class DatabaseManager;                                      // fwd decl
+
 /**
  * \brief [Type brief class description here]
  *
- * [More detailed description here]
+ * Results of a background search are kept as references to documents,
+ * and rows are made from documents on demand (see \c fetchMore()),
+ * so only displayed results cost something.
  *
  */
 class SearchResultsTableModel : public QAbstractItemModel
@@ -51,6 +56,9 @@ class SearchResultsTableModel : public QAbstractItemModel
 public:
     typedef std::vector<index::search_result> search_results_list_type;
 
+    /// Construct from a weak pointer to \c DatabaseManager
+    explicit SearchResultsTableModel(DatabaseManager&);
+
     //BEGIN QAbstractItemModel interface
     virtual int columnCount(const QModelIndex&) const override;
     virtual int rowCount(const QModelIndex&) const override;
@@ -59,9 +67,15 @@ public:
     virtual QVariant data(const QModelIndex&, int) const override;
     virtual QVariant headerData(int, Qt::Orientation, int) const override;
     virtual Qt::ItemFlags flags(const QModelIndex&) const override;
+    virtual bool canFetchMore(const QModelIndex&) const override;
+    virtual void fetchMore(const QModelIndex&) override;
     //END QAbstractItemModel interface
 
     void updateSearchResults(search_results_list_type&&);
+    /// Forget current results and wait for a given background search request
+    void startSearch(unsigned);
+    /// Append results of a background search request (unless it is obsolete)
+    void appendSearchResults(unsigned, const index::search_results_batch&);
     const index::search_result& getSearchResult(int) const;
     /// Get source file location for given search result number
     clang::location getSearchResultLocation(int) const;
@@ -73,16 +87,32 @@ private:
       , NAME
       , last__
     };
-    search_results_list_type m_results;
+    DatabaseManager& m_db_mgr;
+    search_results_list_type m_results;                     ///< Rows made so far
+    index::search_results_batch m_refs;                     ///< Found by a background search
+    unsigned m_serial = {0};                                ///< Background search request to wait for
 };
 
+inline SearchResultsTableModel::SearchResultsTableModel(DatabaseManager& db_mgr)
+  : m_db_mgr(db_mgr)
+{
+}
+
 inline void SearchResultsTableModel::updateSearchResults(search_results_list_type&& results)
 {
     beginResetModel();
     m_results = std::move(results);
+    m_refs.clear();
+    m_serial = 0;
     endResetModel();
 }
 
+inline void SearchResultsTableModel::startSearch(const unsigned serial)
+{
+    updateSearchResults(search_results_list_type{});
+    m_serial = serial;
+}
+
 /**
  * Get a search result by offset (index) in the internal collection
  *
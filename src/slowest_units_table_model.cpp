@@ -0,0 +1,160 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::SlowestUnitsTableModel (implementation)
+ *
+ * \date Fri Oct 16 21:48:30 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "slowest_units_table_model.h"
+
+// Standard includes
+#include <KDE/KLocalizedString>
+#include <QtCore/QFileInfo>
+#include <algorithm>
+#include <cassert>
+
+namespace kate {
+
+int SlowestUnitsTableModel::columnCount(const QModelIndex&) const
+{
+    return column::last__;
+}
+
+int SlowestUnitsTableModel::rowCount(const QModelIndex&) const
+{
+    return m_units.size();
+}
+
+QModelIndex SlowestUnitsTableModel::index(
+    const int row
+  , const int col
+  , const QModelIndex& parent
+  ) const
+{
+    if (!parent.isValid() && std::size_t(row) < m_units.size() && col < column::last__)
+        return createIndex(row, col, 0);
+    return QModelIndex();
+}
+
+QModelIndex SlowestUnitsTableModel::parent(const QModelIndex&) const
+{
+    return QModelIndex();
+}
+
+QVariant SlowestUnitsTableModel::data(const QModelIndex& index, const int role) const
+{
+    assert("Sanity check" && std::size_t(index.row()) < m_units.size());
+    const auto& unit = m_units[index.row()];
+
+    if (role == Qt::ToolTipRole && index.column() == column::FILE)
+        return unit.m_filename;
+    if (role != Qt::DisplayRole)
+        return QVariant{};
+
+    switch (index.column())
+    {
+        case column::FILE:
+            return QFileInfo{unit.m_filename}.fileName();
+        case column::PARSE_TIME:
+            return unit.m_parse_time;
+        case column::CALLBACKS_TIME:
+            return unit.m_callbacks_time;
+        case column::DECLARATIONS:
+            return unit.m_declarations;
+        case column::REFERENCES:
+            return unit.m_references;
+        case column::DOCUMENTS:
+            return unit.m_documents;
+        default:
+            break;
+    }
+    return QVariant{};
+}
+
+QVariant SlowestUnitsTableModel::headerData(
+    const int section
+  , const Qt::Orientation orientation
+  , const int role
+  ) const
+{
+    if (role == Qt::DisplayRole && orientation == Qt::Horizontal)
+    {
+        switch (section)
+        {
+            case column::FILE:
+                return QString{i18nc("@title:column", "File")};
+            case column::PARSE_TIME:
+                return QString{i18nc("@title:column", "Parse (ms)")};
+            case column::CALLBACKS_TIME:
+                return QString{i18nc("@title:column", "Callbacks (ms)")};
+            case column::DECLARATIONS:
+                return QString{i18nc("@title:column", "Declarations")};
+            case column::REFERENCES:
+                return QString{i18nc("@title:column", "References")};
+            case column::DOCUMENTS:
+                return QString{i18nc("@title:column", "Documents")};
+            default:
+                break;
+        }
+    }
+    return QVariant{};
+}
+
+Qt::ItemFlags SlowestUnitsTableModel::flags(const QModelIndex&) const
+{
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
+
+/**
+ * Add a TU to the table if it is slower than any other shown,
+ * or the table is not full yet.
+ */
+void SlowestUnitsTableModel::add(const index::unit_stats& unit)
+{
+    const auto pos = std::upper_bound(
+        begin(m_units)
+      , end(m_units)
+      , unit
+      , [](const index::unit_stats& lhs, const index::unit_stats& rhs)
+        {
+            return lhs.m_parse_time > rhs.m_parse_time;
+        }
+      );
+    const auto row = int(pos - begin(m_units));
+    if (std::size_t(row) == MAX_UNITS)
+        return;
+
+    beginInsertRows(QModelIndex(), row, row);
+    m_units.insert(pos, unit);
+    endInsertRows();
+
+    if (MAX_UNITS < m_units.size())
+    {
+        beginRemoveRows(QModelIndex(), MAX_UNITS, MAX_UNITS);
+        m_units.pop_back();
+        endRemoveRows();
+    }
+}
+
+}                                                           // namespace kate
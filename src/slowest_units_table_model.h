@@ -0,0 +1,84 @@
+/**
+ * \file
+ *
+ * \brief Class \c kate::SlowestUnitsTableModel (interface)
+ *
+ * \date Fri Oct 16 21:48:30 MSK 2026 -- Initial design
+ */
+/*
+ * Copyright (C) 2011-2013 Alex Turbov, all rights reserved.
+ * This is free software. It is licensed for use, modification and
+ * redistribution under the terms of the GNU General Public License,
+ * version 3 or later <http://gnu.org/licenses/gpl.html>
+ *
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// Project specific includes
+#include "index/indexing_stats.h"
+
+// Standard includes
+#include <QtCore/QAbstractItemModel>
+#include <vector>
+
+namespace kate {
+/**
+ * \brief A model class to represent the most expensive TUs of
+ * a running (or last) indexing session
+ */
+class SlowestUnitsTableModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    /// Max number of TUs to show
+    static constexpr std::size_t MAX_UNITS = 50;
+
+    //BEGIN QAbstractItemModel interface
+    virtual int columnCount(const QModelIndex&) const override;
+    virtual int rowCount(const QModelIndex&) const override;
+    virtual QModelIndex index(int, int, const QModelIndex&) const override;
+    virtual QModelIndex parent(const QModelIndex&) const override;
+    virtual QVariant data(const QModelIndex&, int) const override;
+    virtual QVariant headerData(int, Qt::Orientation, int) const override;
+    virtual Qt::ItemFlags flags(const QModelIndex&) const override;
+    //END QAbstractItemModel interface
+
+    void add(const index::unit_stats&);
+    void clear();
+
+private:
+    enum column
+    {
+        FILE
+      , PARSE_TIME
+      , CALLBACKS_TIME
+      , DECLARATIONS
+      , REFERENCES
+      , DOCUMENTS
+      , last__
+    };
+    std::vector<index::unit_stats> m_units;                 ///< Sorted by parse time (descending)
+};
+
+inline void SlowestUnitsTableModel::clear()
+{
+    beginResetModel();
+    m_units.clear();
+    endResetModel();
+}
+
+}                                                           // namespace kate
@@ -0,0 +1,131 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c kate::index::combined_index
+ *
+ * \date Sat Oct 17 00:41:19 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/combined_index.h"
+#include "../index/database.h"
+#include "../index/document.h"
+#include "../index/trigram_table.h"
+
+// Standard includes
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <QtCore/QString>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+void make_db(const kate::index::dbid id, const boost::filesystem::path& path, const unsigned count)
+{
+    kate::index::rw::database db{id, path.string()};
+    for (auto i = 0u; i < count; ++i)
+    {
+        auto doc = kate::index::document{};
+        doc.add_term("common");
+        doc.add_value(kate::index::value_slot::NAME, std::to_string(id) + "-" + std::to_string(i));
+        db.add_document(doc);
+    }
+}
+}                                                           // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(combined_index_refs_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("combined-index-%%%%-%%%%");
+    make_db(1, root / "1", 3);
+    make_db(2, root / "2", 5);
+    {
+        auto indices = std::vector<std::unique_ptr<kate::index::ro::database>>{};
+        indices.emplace_back(new kate::index::ro::database{(root / "1").string()});
+        indices.emplace_back(new kate::index::ro::database{(root / "2").string()});
+        kate::index::combined_index search_db;
+        for (const auto& db : indices)
+            search_db.add_index(db.get());
+
+        const auto results = search_db.search_refs(QString{"common"});
+        BOOST_CHECK_EQUAL(results.first.size(), 8u);
+        BOOST_CHECK_EQUAL(results.second, 8u);
+        // Every reference must point to a document of a right index
+        auto names = std::set<std::string>{};
+        for (const auto& ref : results.first)
+        {
+            BOOST_REQUIRE(ref.is_valid());
+            const auto& db = *indices[ref.database_id() - 1];
+            BOOST_CHECK_EQUAL(db.id(), ref.database_id());
+            const auto doc = kate::index::document{db.get_document(ref.document_id())};
+            const auto& name = doc.get_value(kate::index::value_slot::NAME);
+            BOOST_CHECK_EQUAL(name.substr(0, name.find('-')), std::to_string(ref.database_id()));
+            names.insert(name);
+        }
+        BOOST_CHECK_EQUAL(names.size(), 8u);
+
+        // Page through results
+        const auto page = search_db.search_refs(QString{"common"}, 6, 10);
+        BOOST_CHECK_EQUAL(page.first.size(), 2u);
+    }
+    boost::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(combined_index_name_patterns_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("combined-index-%%%%-%%%%");
+    const auto path = (root / "1").string();
+    const auto names = std::vector<std::string>{"query_cache", "header_cache", "cache_line", "combined_index"};
+    {
+        kate::index::rw::database db{1, path};
+        for (const auto& name : names)
+        {
+            auto doc = kate::index::document{};
+            doc.add_term("common");
+            doc.add_term(name);
+            doc.add_value(kate::index::value_slot::NAME, name);
+            db.add_document(doc);
+        }
+        kate::index::trigram_table_builder builder;
+        builder.add(begin(names), end(names));
+        builder.write(kate::index::trigram_table_path(path));
+    }
+    {
+        kate::index::ro::database db{path};
+        kate::index::combined_index search_db;
+        search_db.add_index(&db);
+
+        BOOST_CHECK_EQUAL(search_db.search_refs(QString{"*Cache*"}).first.size(), 3u);
+        BOOST_CHECK_EQUAL(search_db.search_refs(QString{"/^c.*e$/"}).first.size(), 1u);
+        BOOST_CHECK_EQUAL(search_db.search_refs(QString{"common AND *_cache*"}).first.size(), 2u);
+        BOOST_CHECK_EQUAL(search_db.search_refs(QString{"*_cache* AND common"}).first.size(), 2u);
+        BOOST_CHECK_EQUAL(search_db.search_refs(QString{"/^c.*e$|^no such$/"}).first.size(), 1u);
+        BOOST_CHECK(search_db.search_refs(QString{"*missing*"}).first.empty());
+        BOOST_CHECK_THROW(search_db.search_refs(QString{"/(bad/"}), std::runtime_error);
+        // Patterns are combined w/ the rest of a query by AND only
+        BOOST_CHECK_THROW(search_db.search_refs(QString{"*_cache* OR common"}), std::runtime_error);
+        BOOST_CHECK_THROW(search_db.search_refs(QString{"NOT *_cache*"}), std::runtime_error);
+        BOOST_CHECK_THROW(search_db.search_refs(QString{"(common AND *_cache*)"}), std::runtime_error);
+    }
+    boost::filesystem::remove_all(root);
+}
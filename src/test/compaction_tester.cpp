@@ -0,0 +1,104 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c kate::index::compact()
+ *
+ * \date Fri Oct 16 23:02:36 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/compaction.h"
+
+// Standard includes
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <xapian.h>
+#include <iostream>
+#include <string>
+
+namespace {
+void make_db(const boost::filesystem::path& path, const Xapian::docid first, const unsigned count)
+{
+    Xapian::WritableDatabase db{path.string(), Xapian::DB_CREATE_OR_OVERWRITE};
+    for (auto i = 0u; i < count; ++i)
+    {
+        Xapian::Document doc;
+        doc.add_term("Tterm" + std::to_string(first + i));
+        db.replace_document(first + i, doc);
+    }
+    db.commit();
+}
+}                                                           // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(compaction_merge_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("compaction-%%%%-%%%%");
+    const auto target = root / "db";
+    make_db(target, 1, 0);
+    {
+        boost::filesystem::ofstream ofs{target / "manifest"};
+        ofs << "[options]" << std::endl;
+    }
+    make_db(root / "0", 1, 10);
+    make_db(root / "1", 1000, 5);
+
+    const auto stats = kate::index::compact(target.string(), {(root / "0").string(), (root / "1").string()});
+    BOOST_CHECK(stats.m_size_before != 0);
+    BOOST_CHECK(stats.m_size_after != 0);
+    BOOST_CHECK(boost::filesystem::exists(target / "manifest"));
+    BOOST_CHECK(!boost::filesystem::exists(root / "db.compacting"));
+    {
+        Xapian::Database db{target.string()};
+        BOOST_CHECK_EQUAL(db.get_doccount(), 15u);
+        BOOST_CHECK_EQUAL(db.get_lastdocid(), 1004u);
+        // Document IDs must be the same as in shards
+        BOOST_CHECK(db.term_exists("Tterm10"));
+        BOOST_CHECK(*db.postlist_begin("Tterm1002") == 1002u);
+    }
+
+    boost::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(compaction_in_place_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("compaction-%%%%-%%%%");
+    const auto target = root / "db";
+    make_db(target, 1, 100);
+    {
+        // Make it fragmented a bit
+        Xapian::WritableDatabase db{target.string(), Xapian::DB_OPEN};
+        for (auto i = 1u; i <= 100; i += 2)
+            db.delete_document(i);
+        db.commit();
+    }
+
+    const auto stats = kate::index::compact(target.string());
+    BOOST_CHECK(stats.m_size_after != 0);
+    {
+        Xapian::Database db{target.string()};
+        BOOST_CHECK_EQUAL(db.get_doccount(), 50u);
+        BOOST_CHECK(*db.postlist_begin("Tterm100") == 100u);
+        BOOST_CHECK(!db.term_exists("Tterm99"));
+    }
+
+    boost::filesystem::remove_all(root);
+}
@@ -0,0 +1,230 @@
+/**
+ * \file
+ *
+ * \brief Count memory allocations made to build documents by the indexer
+ *
+ * Compares a straightforward way to compose terms and values (as the
+ * indexer did before) w/ \c kate::index::details::document_builder.
+ * Allocations made by \c Xapian::Document itself to store terms and values
+ * are counted separately, because they can't be avoided anyway.
+ *
+ * \date Fri Oct 16 20:11:47 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/details/document_builder.h"
+
+// Standard includes
+#include <boost/algorithm/string/case_conv.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+std::atomic<std::size_t> s_allocations{0};
+}                                                           // anonymous namespace
+
+void* operator new(const std::size_t size)
+{
+    ++s_allocations;
+    if (auto* const ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace kate::index;
+using kate::index::details::document_builder;
+
+namespace {
+
+/// Declaration attributes, similar to what \c libclang gives to the indexer
+struct entity
+{
+    const char* m_name;
+    std::string m_scope;
+    std::string m_qname;
+    const char* m_type;
+    kind m_kind;
+    const char* m_kind_term;
+    CX_CXXAccessSpecifier m_access;
+};
+
+const entity ENTITIES[] = {
+    {"HeaderFilesCache", "kate", "kate", "class kate::HeaderFilesCache", kind::CLASS, "class", CX_CXXInvalidAccessSpecifier}
+  , {"update_client_container", "worker", "kate::index::details::worker", "CXIdxClientContainer (ClientArgs &&...)", kind::METHOD, "method", CX_CXXPrivate}
+  , {"m_local_locations", "worker", "kate::index::details::worker", "kate::index::details::location_set", kind::FIELD, "field", CX_CXXPrivate}
+  , {"DEFAULT_COMMIT_DOCUMENTS", "indexer", "kate::index::indexer", "const std::size_t", kind::VARIABLE, "var", CX_CXXPublic}
+  , {"is_source_suffix", "targets_scanner", "kate::index::details::targets_scanner", "bool (const QString &)", kind::METHOD, "method", CX_CXXPublic}
+  , {"x", "fn", "kate::fn", "int", kind::PARAMETER, "param", CX_CXXInvalidAccessSpecifier}
+};
+
+/// Make a document the way \c worker did before \c document_builder
+document make_document_naive(const entity& e, const unsigned line)
+{
+    auto name = std::string{e.m_name};
+    auto doc = document{};
+    doc.add_term(boost::to_lower_copy(name));
+    doc.add_boolean_term(term::XDECL, name);
+    doc.add_value(value_slot::NAME, e.m_name);
+    doc.add_value(value_slot::LINE, Xapian::sortable_serialise(line));
+    auto parent_qname = e.m_qname;
+    doc.add_boolean_term(term::XSCOPE, e.m_scope);
+    doc.add_boolean_term(term::XSCOPE, parent_qname);
+    doc.add_value(value_slot::SCOPE, parent_qname);
+    doc.add_boolean_term(term::XKIND + e.m_kind_term);
+    doc.add_value(value_slot::KIND, serialize(e.m_kind));
+    auto type_str = std::string{e.m_type};
+    doc.add_value(value_slot::TYPE, type_str);
+    switch (e.m_access)
+    {
+        case CX_CXXPublic:
+            doc.add_boolean_term(term::XACCESS + "public");
+            doc.add_value(value_slot::ACCESS, serialize(unsigned(e.m_access)));
+            break;
+        case CX_CXXPrivate:
+            doc.add_boolean_term(term::XACCESS + "private");
+            doc.add_value(value_slot::ACCESS, serialize(unsigned(e.m_access)));
+            break;
+        default:
+            break;
+    }
+    doc.add_boolean_term(term::XREDECLARATION + "y");
+    parent_qname += "::" + name;
+    return doc;
+}
+
+/// Make the same document w/ a \c document_builder
+document make_document(document_builder& builder, const entity& e, const unsigned line)
+{
+    auto& name = builder.name(e.m_name);
+    auto doc = document{};
+    builder.add_name_terms(doc, term::XDECL, name);
+    builder.add_value(doc, value_slot::NAME, e.m_name);
+    doc.add_value(value_slot::LINE, Xapian::sortable_serialise(line));
+    builder.add_boolean_term(doc, term::XSCOPE, e.m_scope);
+    builder.add_boolean_term(doc, term::XSCOPE, e.m_qname);
+    doc.add_value(value_slot::SCOPE, e.m_qname);
+    builder.add_kind(doc, e.m_kind);
+    builder.add_value(doc, value_slot::TYPE, e.m_type);
+    builder.add_access(doc, e.m_access);
+    builder.add_flag(doc, document_builder::flag::REDECLARATION);
+    return doc;
+}
+
+/// Terms and values of a document composed in advance
+struct sample
+{
+    std::vector<std::string> m_terms;
+    std::vector<std::pair<Xapian::valueno, std::string>> m_values;
+
+    explicit sample(const document& doc)
+    {
+        for (auto it = doc.termlist_begin(), last = doc.termlist_end(); it != last; ++it)
+            m_terms.emplace_back(*it);
+        for (auto it = doc.values_begin(), last = doc.values_end(); it != last; ++it)
+            m_values.emplace_back(it.get_valueno(), *it);
+    }
+};
+
+/// Store precomposed terms and values only, i.e. what \c Xapian::Document can't avoid
+document make_document_xapian_only(const sample& s)
+{
+    auto doc = document{};
+    for (const auto& t : s.m_terms)
+        doc.add_boolean_term(t);
+    for (const auto& v : s.m_values)
+        doc.Xapian::Document::add_value(v.first, v.second);
+    return doc;
+}
+
+template <typename Fn>
+void run(const char* const title, const std::size_t entities, Fn make)
+{
+    auto documents = std::vector<document>{};
+    documents.reserve(entities);
+    const auto start_allocations = s_allocations.load();
+    const auto start_time = std::chrono::steady_clock::now();
+    for (auto i = std::size_t{}; i < entities; ++i)
+        documents.emplace_back(make(i));
+    const auto duration = std::chrono::steady_clock::now() - start_time;
+    const auto allocations = s_allocations.load() - start_allocations;
+    std::cout << std::setw(16) << std::left << title
+      << std::setw(12) << std::right << std::fixed << std::setprecision(2)
+      << double(allocations) / entities << " allocs/entity"
+      << std::setw(12) << std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / entities
+      << " ns/entity" << std::endl;
+}
+
+}                                                           // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const auto entities = std::size_t(1 < argc ? std::atol(argv[1]) : 100000);
+    if (!entities)
+    {
+        std::cerr << "Usage: " << argv[0] << " [entities-count]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    constexpr auto ENTITIES_COUNT = sizeof(ENTITIES) / sizeof(ENTITIES[0]);
+
+    // Precompose samples for Xapian-only run (and init builder constants as well)
+    document_builder builder;
+    auto samples = std::vector<sample>{};
+    for (const auto& e : ENTITIES)
+        samples.emplace_back(make_document(builder, e, 1));
+
+    run(
+        "xapian only"
+      , entities
+      , [&samples](const std::size_t i)
+        {
+            return make_document_xapian_only(samples[i % ENTITIES_COUNT]);
+        }
+      );
+    run(
+        "naive"
+      , entities
+      , [](const std::size_t i)
+        {
+            return make_document_naive(ENTITIES[i % ENTITIES_COUNT], unsigned(i));
+        }
+      );
+    run(
+        "builder"
+      , entities
+      , [&builder](const std::size_t i)
+        {
+            return make_document(builder, ENTITIES[i % ENTITIES_COUNT], unsigned(i));
+        }
+      );
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c document_builder
+ *
+ * \date Fri Oct 16 19:58:31 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/details/document_builder.h"
+
+// Standard includes
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <iostream>
+#include <set>
+#include <string>
+
+using namespace kate::index;
+using kate::index::details::document_builder;
+
+namespace {
+std::set<std::string> terms_of(const document& doc)
+{
+    auto result = std::set<std::string>{};
+    for (auto it = doc.termlist_begin(), last = doc.termlist_end(); it != last; ++it)
+        result.insert(*it);
+    return result;
+}
+}                                                           // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(document_builder_terms_test)
+{
+    document_builder builder;
+    for (const auto* const name : {"some", "Some", "SomeLongIdentifierName", "_x", "operator=="})
+    {
+        document expected;
+        expected.add_term(boost::to_lower_copy(std::string{name}));
+        expected.add_boolean_term(term::XDECL, name);
+        expected.add_boolean_term(term::XSCOPE, name);
+
+        document doc;
+        builder.add_name_terms(doc, term::XDECL, name);
+        builder.add_boolean_term(doc, term::XSCOPE, name);
+
+        BOOST_CHECK(terms_of(doc) == terms_of(expected));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(document_builder_constants_test)
+{
+    document_builder builder;
+    document doc;
+    builder.add_kind_term(doc, kind::FUNCTION);
+    builder.add_kind(doc, kind::METHOD);
+    builder.add_flag(doc, document_builder::flag::VIRTUAL);
+    builder.add_access(doc, CX_CXXProtected);
+    builder.add_access(doc, CX_CXXInvalidAccessSpecifier);
+    builder.add_template_kind(doc, CXIdxEntity_TemplatePartialSpecialization);
+
+    const auto expected = std::set<std::string>{
+        term::XKIND + "fn"
+      , term::XKIND + "method"
+      , term::XVIRTUAL + "y"
+      , term::XACCESS + "protected"
+      , term::XTEMPLATE + "ps"
+      };
+    BOOST_CHECK(terms_of(doc) == expected);
+    BOOST_CHECK(deserialize(doc.get_value(value_slot::KIND)) == kind::METHOD);
+    BOOST_CHECK_EQUAL(deserialize<unsigned>(doc.get_value(value_slot::ACCESS)), unsigned(CX_CXXProtected));
+    BOOST_CHECK_EQUAL(
+        deserialize<unsigned>(doc.get_value(value_slot::TEMPLATE))
+      , unsigned(CXIdxEntity_TemplatePartialSpecialization)
+      );
+}
+
+BOOST_AUTO_TEST_CASE(document_builder_to_lower_test)
+{
+    auto result = std::string{};
+    document_builder::to_lower("Some_CamelCase_Name42", result);
+    BOOST_CHECK_EQUAL(result, "some_camelcase_name42");
+    // Non ASCII bytes must be kept as is
+    document_builder::to_lower("\xd0\x9f\xd0\xb8X", result);
+    BOOST_CHECK_EQUAL(result, "\xd0\x9f\xd0\xb8x");
+    document_builder::to_lower("", result);
+    BOOST_CHECK(result.empty());
+}
+
+BOOST_AUTO_TEST_CASE(document_builder_usr_test)
+{
+    document_builder builder;
+    {
+        document doc;
+        builder.add_usr(doc, "c:@N@kate@S@HeaderFilesCache");
+        BOOST_CHECK(terms_of(doc) == std::set<std::string>{term::XUSR + "c:@N@kate@S@HeaderFilesCache"});
+        BOOST_CHECK_EQUAL(doc.get_value(value_slot::USR), "c:@N@kate@S@HeaderFilesCache");
+    }
+    {
+        // Too long USR must be hashed, but stored completely in a value slot
+        const auto usr = "c:@N@std@ST>2#T#T@map" + std::string(MAX_USR_TERM_LENGTH, 'x');
+        document doc;
+        builder.add_usr(doc, usr.c_str());
+        const auto terms = terms_of(doc);
+        BOOST_REQUIRE_EQUAL(terms.size(), 1u);
+        BOOST_CHECK(terms.begin()->size() <= term::XUSR.size() + MAX_USR_TERM_LENGTH);
+        auto term = std::string{};
+        make_usr_term(usr.c_str(), term);
+        BOOST_CHECK_EQUAL(*terms.begin(), term);
+        BOOST_CHECK_EQUAL(doc.get_value(value_slot::USR), usr);
+        // ... and different USRs have different terms
+        auto other = std::string{};
+        make_usr_term((usr + "y").c_str(), other);
+        BOOST_CHECK(term != other);
+    }
+    {
+        document doc;
+        builder.add_usr(doc, "");
+        builder.add_usr(doc, nullptr);
+        BOOST_CHECK(terms_of(doc).empty());
+    }
+}
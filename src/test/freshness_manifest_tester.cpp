@@ -0,0 +1,125 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c freshness_manifest
+ *
+ * \date Fri Oct 16 16:27:40 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/freshness_manifest.h"
+
+// Standard includes
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <iostream>
+#include <sstream>
+
+using kate::index::file_state;
+using kate::index::freshness_manifest;
+
+BOOST_AUTO_TEST_CASE(freshness_manifest_test)
+{
+    freshness_manifest m;
+    BOOST_CHECK_EQUAL(m.isEmpty(), true);
+    BOOST_CHECK(m.find("/some/file.cpp") == nullptr);
+
+    {
+        auto state = file_state{};
+        state.m_mtime = 1234567890123;
+        state.m_size = 4096;
+        state.m_hash = std::string("\x01\x00\xff\x7f", 4);
+        state.m_parse_time = 1500;
+        state.m_documents = {1, 2, 3, 100500};
+        m.update("/some/file.cpp", std::move(state));
+    }
+    m.update("/some/other.cpp", file_state{});
+    BOOST_CHECK_EQUAL(m.size(), 2u);
+
+    const auto* const state = m.find("/some/file.cpp");
+    BOOST_REQUIRE(state != nullptr);
+    BOOST_CHECK_EQUAL(state->m_size, 4096u);
+    {
+        auto invalid = *state;
+        invalid.invalidate();
+        BOOST_CHECK(!invalid.has_same_attributes(*state));
+        BOOST_CHECK(invalid.m_hash.empty());
+        BOOST_CHECK_EQUAL(invalid.m_documents.size(), state->m_documents.size());
+    }
+
+    const auto serialized = m.storeToString();
+    {
+        freshness_manifest other;
+        other.loadFromString(serialized);
+        BOOST_CHECK_EQUAL(other.size(), 2u);
+        const auto* const loaded = other.find("/some/file.cpp");
+        BOOST_REQUIRE(loaded != nullptr);
+        BOOST_CHECK(loaded->has_same_attributes(*state));
+        BOOST_CHECK_EQUAL(loaded->m_hash, state->m_hash);
+        BOOST_CHECK_EQUAL(loaded->m_parse_time, 1500u);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            begin(loaded->m_documents)
+          , end(loaded->m_documents)
+          , begin(state->m_documents)
+          , end(state->m_documents)
+          );
+        BOOST_REQUIRE(other.find("/some/other.cpp") != nullptr);
+        BOOST_CHECK(other.find("/some/other.cpp")->m_documents.empty());
+    }
+
+    BOOST_CHECK_EQUAL(m.remove("/some/other.cpp"), true);
+    BOOST_CHECK_EQUAL(m.remove("/some/other.cpp"), false);
+    BOOST_CHECK_EQUAL(m.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(freshness_manifest_headers_test)
+{
+    freshness_manifest m;
+    BOOST_CHECK(m.find_header(1) == nullptr);
+    m.add_header_document(1, 10);
+    m.add_header_document(2, 20);
+    m.add_header_document(1, 11);
+    BOOST_REQUIRE(m.find_header(1) != nullptr);
+    BOOST_CHECK_EQUAL(m.find_header(1)->size(), 2u);
+
+    {
+        freshness_manifest other;
+        other.loadFromString(m.storeToString());
+        BOOST_CHECK_EQUAL(other.headers().size(), 2u);
+        const auto* const loaded = other.find_header(1);
+        BOOST_REQUIRE(loaded != nullptr);
+        const auto expected = std::vector<kate::index::docid>{10, 11};
+        BOOST_CHECK_EQUAL_COLLECTIONS(begin(*loaded), end(*loaded), begin(expected), end(expected));
+    }
+
+    BOOST_CHECK_EQUAL(m.remove_header(1), true);
+    BOOST_CHECK_EQUAL(m.remove_header(1), false);
+    BOOST_CHECK(m.find_header(2) != nullptr);
+
+    // Manifest stored w/o header documents still can be loaded
+    std::stringstream ofs{std::ios_base::out | std::ios_base::binary};
+    {
+        boost::archive::binary_oarchive oa{ofs};
+        const std::size_t count = 0;
+        oa << count;
+    }
+    m.loadFromString(ofs.str());
+    BOOST_CHECK_EQUAL(m.isEmpty(), true);
+    BOOST_CHECK(m.headers().empty());
+}
@@ -0,0 +1,104 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c kate::index::include_graph
+ *
+ * \date Fri Oct 16 23:58:04 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/include_graph.h"
+#include "../header_files_cache.h"
+
+// Standard includes
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+#include <iostream>
+
+using namespace kate::index;
+
+namespace {
+// main.cpp -> a.h -> b.h -> c.h, other.cpp -> c.h, alone.cpp -> d.h
+enum : fileid { MAIN, OTHER, ALONE, A, B, C, D };
+}                                                           // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(include_graph_dependents_test)
+{
+    include_graph g;
+    BOOST_CHECK(g.isEmpty());
+    g.update(MAIN, {{MAIN, A, 1}, {A, B, 1}, {B, C, 1}, {C, A, 1}});
+    g.update(OTHER, {{OTHER, C, 1}});
+    g.update(ALONE, {{ALONE, D, 1}});
+    BOOST_CHECK_EQUAL(g.size(), 6u);
+
+    const auto c_deps = g.dependents({C});
+    BOOST_CHECK((c_deps == std::set<fileid>{MAIN, OTHER, A, B, C}));
+    const auto d_deps = g.dependents({D});
+    BOOST_CHECK((d_deps == std::set<fileid>{ALONE, D}));
+    BOOST_CHECK((g.dependents({MAIN}) == std::set<fileid>{MAIN}));
+
+    // Includes of a TU are replaced, includes of headers are merged
+    g.update(MAIN, {{MAIN, B, 1}, {B, D, 1}});
+    BOOST_CHECK((g.dependents({A}) == std::set<fileid>{A, B, C, MAIN, OTHER}));
+    BOOST_CHECK((g.dependents({D}) == std::set<fileid>{D, B, A, C, MAIN, OTHER, ALONE}));
+
+    BOOST_CHECK(g.remove(ALONE));
+    BOOST_CHECK(!g.remove(ALONE));
+    BOOST_CHECK(!g.dependents({D}).count(ALONE));
+
+    include_graph other;
+    other.loadFromString(g.storeToString());
+    BOOST_CHECK_EQUAL(other.size(), g.size());
+    BOOST_CHECK((other.dependents({D}) == g.dependents({D})));
+}
+
+BOOST_AUTO_TEST_CASE(include_graph_changed_files_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("include-graph-%%%%-%%%%");
+    boost::filesystem::create_directories(root);
+    const auto header = root / "header.h";
+    {
+        boost::filesystem::ofstream ofs{header};
+        ofs << "#pragma once\n";
+    }
+    kate::HeaderFilesCache files;
+    const auto source_id = files[QString::fromUtf8((root / "source.cpp").string().c_str())];
+    const auto header_id = files[QString::fromUtf8(header.string().c_str())];
+    const auto missed_id = files[QString::fromUtf8((root / "missed.h").string().c_str())];
+    const auto mtime = std::int64_t(QFileInfo{files[header_id]}.lastModified().toTime_t());
+
+    include_graph g;
+    g.update(source_id, {{source_id, header_id, mtime}});
+    BOOST_CHECK(g.changed_files(files).empty());
+
+    g.update(source_id, {{source_id, header_id, mtime - 10}, {source_id, missed_id, mtime}});
+    BOOST_CHECK((g.changed_files(files) == std::set<fileid>{header_id, missed_id}));
+
+    // Handled files are not reported again, missed ones are forgotten
+    g.refresh(g.changed_files(files), files);
+    BOOST_CHECK(g.changed_files(files).empty());
+    BOOST_CHECK((g.dependents({missed_id}) == std::set<fileid>{missed_id}));
+    BOOST_CHECK((g.dependents({header_id}) == std::set<fileid>{header_id, source_id}));
+
+    boost::filesystem::remove_all(root);
+}
@@ -27,16 +27,23 @@
 
 // Project specific includes
 #include "indexer_tester.h"
+#include "../clang/diagnostic_message.h"
+#include "../clang/location.h"
+#include "../index/database.h"
+#include "../index/search_result.h"
 #include <config.h>
 
 // Standard includes
+#include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 // Include the following file if u need to validate some text results
 // #include <boost/test/output_test_stream.hpp>
 #include <KDE/KDebug>
 #include <QtTest/QtTest>
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <string>
 #include <vector>
 
 // Uncomment if u want to use boost test output streams.
@@ -45,6 +52,7 @@
 // using boost::test_tools::output_test_stream;
 
 using namespace kate;
+namespace fs = boost::filesystem;
 
 namespace {
 /// \todo Get current compiler paths dynamically!
@@ -76,6 +84,110 @@ bool make_sure_database_not_exists(const boost::filesystem::path& path)
     return bool(!error);
 }
 bool s_db_rm_flag = make_sure_database_not_exists(SAMPLE_DB_PATH);
+
+constexpr auto PARALLEL_JOBS = 4u;
+constexpr auto BUILD_TIMEOUT = std::chrono::minutes(2);
+
+void copy_tree(const fs::path& from, const fs::path& to)
+{
+    fs::create_directories(to);
+    for (auto it = fs::directory_iterator{from}, last = fs::directory_iterator{}; it != last; ++it)
+    {
+        if (fs::is_directory(it->status()))
+            copy_tree(it->path(), to / it->path().filename());
+        else
+            fs::copy_file(it->path(), to / it->path().filename());
+    }
+}
+
+void write_file(const fs::path& path, const char* const content)
+{
+    fs::ofstream file{path};
+    file << content;
+}
+
+/**
+ * Sample files have no \c #include at all, so add a header shared by
+ * few TUs to make workers compete for its declarations.
+ */
+void make_sources(const fs::path& dir)
+{
+    copy_tree(SAMPLE_DIR, dir);
+    fs::create_directories(dir / "shared");
+    write_file(
+        dir / "shared" / "shared.h"
+      , "#pragma once\n"
+        "struct shared_type { int m_value; };\n"
+        "int shared_function(const shared_type&);\n"
+      );
+    write_file(
+        dir / "shared" / "user_1.cc"
+      , "#include \"shared.h\"\n"
+        "int shared_function(const shared_type& v) { return v.m_value; }\n"
+      );
+    write_file(
+        dir / "shared" / "user_2.cc"
+      , "#include \"shared.h\"\n"
+        "int user_2() { return shared_function(shared_type{2}); }\n"
+      );
+}
+
+/// Run an indexer over a given directory and wait until it finishes
+bool build(
+    const fs::path& dir
+  , const fs::path& db_path
+  , const unsigned jobs
+  , const bool incremental = false
+  )
+{
+    result_waiter waiter;
+    {
+        index::indexer indexer{SAMPLE_ID, db_path.string()};
+        QObject::connect(&indexer, SIGNAL(finished()), &waiter, SLOT(finished()));
+        indexer.set_compiler_options({"-x", "c++", "-std=c++11"})
+          .set_jobs_count(jobs)
+          .set_incremental(incremental)
+          .add_target(KUrl{QString::fromUtf8(dir.string().c_str())})
+          .start()
+          ;
+        const auto start_time = std::chrono::steady_clock::now();
+        while (!waiter.m_done)
+        {
+            QCoreApplication::processEvents();
+            if ((std::chrono::steady_clock::now() - start_time) > BUILD_TIMEOUT)
+            {
+                kDebug() << "Indexer has timed out!";
+                indexer.stop();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Document IDs and file IDs depend on the order TUs have been parsed in,
+ * so documents are compared by what they describe.
+ */
+std::vector<std::string> collect_documents(const fs::path& db_path)
+{
+    auto result = std::vector<std::string>{};
+    index::ro::database db{db_path.string()};
+    for (auto it = db.postlist_begin(std::string{}), last = db.postlist_end(std::string{}); it != last; ++it)
+    {
+        const auto found = index::make_search_result(db.get_document(*it), QString{}, db.headers_map());
+        result.emplace_back(
+            std::string{found.m_file.toUtf8().constData()}
+          + ':' + std::to_string(found.m_line)
+          + ':' + std::to_string(found.m_column)
+          + ' ' + index::to_string(found.m_kind)
+          + ' ' + found.m_name.toUtf8().constData()
+          + ' ' + std::to_string(found.m_flags.m_flags_as_int)
+          );
+    }
+    std::sort(begin(result), end(result));
+    return result;
+}
 }                                                           // anonymous namespace
 
 void result_waiter::finished()
@@ -91,6 +203,20 @@ indexer_tester::indexer_tester()
     connect(&m_indexer, SIGNAL(finished()), &m_res, SLOT(finished()));
 }
 
+void indexer_tester::initTestCase()
+{
+    qRegisterMetaType<clang::location>("clang::location");
+    qRegisterMetaType<clang::diagnostic_message>("clang::diagnostic_message");
+    m_work_dir = fs::temp_directory_path() / fs::unique_path("kate-cpp-indexer-%%%%-%%%%");
+    QVERIFY(fs::create_directories(m_work_dir));
+}
+
+void indexer_tester::cleanupTestCase()
+{
+    boost::system::error_code error;
+    fs::remove_all(m_work_dir, error);
+}
+
 void indexer_tester::index_sample_file()
 {
     kDebug() << "DB path:" << SAMPLE_DB_PATH.c_str();
@@ -117,4 +243,63 @@ void indexer_tester::index_sample_file()
     kDebug() << "Done";
 }
 
+/**
+ * Workers share seen locations and document IDs, and a sharded build
+ * gets merged when done, so it must make exactly the same documents
+ * as a single worker does.
+ */
+void indexer_tester::parallel_build_matches_serial()
+{
+    const auto sources = m_work_dir / "parallel";
+    make_sources(sources);
+    QVERIFY(build(sources, m_work_dir / "serial.db", 1));
+    QVERIFY(build(sources, m_work_dir / "parallel.db", PARALLEL_JOBS));
+
+    const auto serial = collect_documents(m_work_dir / "serial.db");
+    const auto parallel = collect_documents(m_work_dir / "parallel.db");
+    QVERIFY(!serial.empty());
+    QCOMPARE(parallel.size(), serial.size());
+    QVERIFY(parallel == serial);
+}
+
+/**
+ * After a header and a TU has been changed, an incremental update
+ * must leave the same documents as a DB built from scratch.
+ */
+void indexer_tester::incremental_update_matches_full_build()
+{
+    const auto sources = m_work_dir / "incremental";
+    make_sources(sources);
+    QVERIFY(build(sources, m_work_dir / "updated.db", PARALLEL_JOBS));
+
+    write_file(
+        sources / "shared" / "shared.h"
+      , "#pragma once\n"
+        "struct shared_type { int m_value; int m_other; };\n"
+        "int shared_function(const shared_type&);\n"
+        "int another_function(int);\n"
+      );
+    write_file(
+        sources / "variables" / "test_001.cc"
+      , "/// Some var\n"
+        "int a;\n"
+        "/// Added var\n"
+        "long b;\n"
+      );
+    QVERIFY(build(sources, m_work_dir / "updated.db", PARALLEL_JOBS, true));
+    QVERIFY(build(sources, m_work_dir / "rebuilt.db", PARALLEL_JOBS));
+
+    const auto updated = collect_documents(m_work_dir / "updated.db");
+    const auto rebuilt = collect_documents(m_work_dir / "rebuilt.db");
+    QVERIFY(
+        std::find_if(
+            begin(updated)
+          , end(updated)
+          , [](const std::string& doc) { return doc.find(" another_function ") != std::string::npos; }
+          ) != end(updated)
+      );
+    QCOMPARE(updated.size(), rebuilt.size());
+    QVERIFY(updated == rebuilt);
+}
+
 QTEST_MAIN(indexer_tester)
@@ -31,6 +31,7 @@
 #include "../index/indexer.h"
 
 // Standard includes
+#include <boost/filesystem/path.hpp>
 #include <QtCore/QObject>
 #include <atomic>
 
@@ -52,10 +53,10 @@ public:
 
 
 /**
- * \brief [Type brief class description here]
- *
- * [More detailed description here]
+ * \brief Indexer tests over sample files
  *
+ * Indexer, workers and writer are tested together: DBs made from
+ * a copy of sample files are compared by documents they have.
  */
 class indexer_tester : public QObject
 {
@@ -65,11 +66,16 @@ public:
     indexer_tester();
 
 private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
     void index_sample_file();
+    void parallel_build_matches_serial();
+    void incremental_update_matches_full_build();
 
 private:
     index::indexer m_indexer;
     result_waiter m_res;
+    boost::filesystem::path m_work_dir;                     ///< Copy of sample files and DBs made from it
 };
 
 }                                                           // namespace kate
@@ -0,0 +1,215 @@
+/**
+ * \file
+ *
+ * \brief Compare indexing profiles: index size, build time and search latency
+ *
+ * Sample sources (\c src/test/data) and a generated corpus (headers and
+ * sources w/ classes, functions and cross references) are indexed w/
+ * every profile. Then few typical queries are repeated over every index.
+ *
+ * \date Fri Oct 16 23:31:08 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../clang/diagnostic_message.h"
+#include "../clang/location.h"
+#include "../index/combined_index.h"
+#include "../index/database.h"
+#include "../index/indexer.h"
+#include "../index/indexing_profile.h"
+#include <config.h>
+
+// Standard includes
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <QtCore/QCoreApplication>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace kate;
+namespace fs = boost::filesystem;
+
+namespace {
+
+const index::dbid BENCHMARK_DB_ID = 0xbeefcafe;
+const char* const SAMPLE_DIR = CMAKE_SOURCE_DIR "/src/test/data";
+const char* const QUERIES[] = {
+    "value_42"
+  , "method_7"
+  , "kind:class"
+  , "type_1*"
+  , "scope:gen"
+};
+constexpr auto QUERY_REPEATS = 100u;
+
+/// Index size, build time and search latency for a profile
+struct measurement
+{
+    index::doccount m_documents;
+    std::uintmax_t m_size;
+    double m_build_time;                                    ///< Seconds
+    double m_query_time;                                    ///< Microseconds per query
+};
+
+/**
+ * Every unit has a header w/ a class and a function, and a source file
+ * w/ definitions referring the previous unit, so there are plenty of
+ * references in function bodies, parameters and implicit declarations.
+ */
+void generate_corpus(const fs::path& dir, const unsigned units)
+{
+    fs::create_directories(dir);
+    for (auto i = 0u; i < units; ++i)
+    {
+        const auto n = std::to_string(i);
+        {
+            fs::ofstream hdr{dir / ("unit_" + n + ".h")};
+            hdr << "#pragma once\n"
+                << "namespace gen {\n"
+                << "struct type_" << n << "\n{\n"
+                << "    int value_" << n << " = " << n << ";\n"
+                << "    enum { first_" << n << ", second_" << n << " };\n"
+                << "    int method_" << n << "(int, int factor) const;\n"
+                << "    virtual ~type_" << n << "() {}\n"
+                << "};\n"
+                << "int function_" << n << "(const type_" << n << "&);\n"
+                << "}\n";
+        }
+        fs::ofstream src{dir / ("unit_" + n + ".cpp")};
+        src << "#include \"unit_" << n << ".h\"\n";
+        if (i)
+            src << "#include \"unit_" << (i - 1) << ".h\"\n";
+        src << "namespace gen {\n"
+            << "int type_" << n << "::method_" << n << "(int x, int factor) const\n{\n"
+            << "    auto result = value_" << n << " * factor + x;\n"
+            << "    for (auto i = 0; i < x; ++i)\n"
+            << "        result += i;\n";
+        if (i)
+            src << "    type_" << (i - 1) << " prev;\n"
+                << "    result += prev.method_" << (i - 1) << "(result, factor);\n"
+                << "    result += function_" << (i - 1) << "(prev);\n";
+        src << "    return result;\n}\n"
+            << "int function_" << n << "(const type_" << n << "& obj)\n{\n"
+            << "    return obj.method_" << n << "(obj.value_" << n << ", type_" << n << "::second_" << n << ");\n"
+            << "}\n}\n";
+    }
+}
+
+std::uintmax_t directory_size(const fs::path& dir)
+{
+    auto result = std::uintmax_t{};
+    for (auto it = fs::recursive_directory_iterator{dir}, last = fs::recursive_directory_iterator{}; it != last; ++it)
+        if (fs::is_regular_file(it->status()))
+            result += fs::file_size(it->path());
+    return result;
+}
+
+measurement run(
+    QCoreApplication& app
+  , const index::indexing_profile profile
+  , const fs::path& target
+  , const fs::path& db_path
+  )
+{
+    fs::remove_all(db_path);
+    auto result = measurement{};
+    {
+        const auto include_dir = "-I" + target.string();
+        auto options = std::vector<const char*>{"-x", "c++", "-std=c++11", include_dir.c_str()};
+        index::indexer indexer{BENCHMARK_DB_ID, db_path.string()};
+        indexer.set_compiler_options(std::move(options))
+          .set_profile(profile)
+          .add_target(KUrl{QString::fromUtf8(target.string().c_str())});
+        QObject::connect(&indexer, SIGNAL(finished()), &app, SLOT(quit()));
+        const auto start_time = std::chrono::steady_clock::now();
+        indexer.start();
+        app.exec();
+        result.m_build_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+    result.m_size = directory_size(db_path);
+
+    index::ro::database db{db_path.string()};
+    result.m_documents = db.get_doccount();
+    index::combined_index search_db;
+    search_db.add_index(&db);
+    const auto start_time = std::chrono::steady_clock::now();
+    for (auto i = 0u; i < QUERY_REPEATS; ++i)
+        for (const auto* const query : QUERIES)
+            search_db.search(QString{query});
+    const auto duration = std::chrono::steady_clock::now() - start_time;
+    result.m_query_time = std::chrono::duration<double, std::micro>(duration).count()
+      / (QUERY_REPEATS * sizeof(QUERIES) / sizeof(QUERIES[0]));
+    return result;
+}
+
+void report(const char* const corpus, const index::indexing_profile profile, const measurement& m)
+{
+    std::cout << std::setw(10) << std::left << corpus
+      << std::setw(12) << index::to_string(profile)
+      << std::setw(10) << std::right << m.m_documents << " docs"
+      << std::setw(10) << std::fixed << std::setprecision(2) << m.m_size / (1024.0 * 1024.0) << " MiB"
+      << std::setw(10) << m.m_build_time << " s"
+      << std::setw(10) << std::setprecision(1) << m.m_query_time << " us/query" << std::endl;
+}
+
+}                                                           // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app{argc, argv};
+    qRegisterMetaType<clang::location>("clang::location");
+    qRegisterMetaType<clang::diagnostic_message>("clang::diagnostic_message");
+
+    const auto units = unsigned(1 < argc ? std::atoi(argv[1]) : 500);
+    if (!units)
+    {
+        std::cerr << "Usage: " << argv[0] << " [generated-units-count]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto work_dir = fs::temp_directory_path() / fs::unique_path("kate-cpp-profiles-%%%%-%%%%");
+    const auto generated_dir = work_dir / "corpus";
+    const auto db_path = work_dir / "index.db";
+    try
+    {
+        generate_corpus(generated_dir, units);
+        for (auto p = 0; p < int(index::indexing_profile::last__); ++p)
+        {
+            const auto profile = index::indexing_profile(p);
+            report("samples", profile, run(app, profile, SAMPLE_DIR, db_path));
+            report("generated", profile, run(app, profile, generated_dir, db_path));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        fs::remove_all(work_dir);
+        return EXIT_FAILURE;
+    }
+    catch (const Xapian::Error& e)
+    {
+        std::cerr << "Benchmark failed: " << e.get_msg() << std::endl;
+        fs::remove_all(work_dir);
+        return EXIT_FAILURE;
+    }
+    fs::remove_all(work_dir);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c kate::index::report
+ *
+ * \date Fri Oct 16 19:47:21 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/indexing_report.h"
+
+// Standard includes
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <iostream>
+
+namespace report = kate::index::report;
+
+BOOST_AUTO_TEST_CASE(indexing_report_progress_test)
+{
+    const auto line = report::progress(12, 345, 67);
+    BOOST_CHECK(line.endsWith('\n'));
+    const auto r = report::parse(line);
+    BOOST_REQUIRE(r.m_type == report::record::type::progress);
+    BOOST_CHECK_EQUAL(r.m_processed, 12u);
+    BOOST_CHECK_EQUAL(r.m_total, 345u);
+    BOOST_CHECK_EQUAL(r.m_eta, 67u);
+}
+
+BOOST_AUTO_TEST_CASE(indexing_report_file_test)
+{
+    const auto r = report::parse(report::file("/some/dir w/ spaces/file.cpp"));
+    BOOST_REQUIRE(r.m_type == report::record::type::file);
+    BOOST_CHECK(r.m_filename == "/some/dir w/ spaces/file.cpp");
+    // Separators inside of a field must not break a line
+    const auto s = report::parse(report::file("bad\tname\n.cpp"));
+    BOOST_REQUIRE(s.m_type == report::record::type::file);
+    BOOST_CHECK(s.m_filename == "bad name .cpp");
+}
+
+BOOST_AUTO_TEST_CASE(indexing_report_unit_test)
+{
+    kate::index::unit_stats unit;
+    unit.m_filename = "/src/main.cpp";
+    unit.m_parse_time = 1234;
+    unit.m_callbacks_time = 56;
+    unit.m_declarations = 789;
+    unit.m_references = 1011;
+    unit.m_documents = 1213;
+    kate::index::indexing_stats stats;
+    stats.add(unit);
+    stats.m_declarations = 10000000000ull;
+    stats.m_elapsed = 98765;
+
+    const auto r = report::parse(report::unit(unit, stats));
+    BOOST_REQUIRE(r.m_type == report::record::type::unit);
+    BOOST_CHECK(r.m_unit.m_filename == unit.m_filename);
+    BOOST_CHECK_EQUAL(r.m_unit.m_parse_time, unit.m_parse_time);
+    BOOST_CHECK_EQUAL(r.m_unit.m_callbacks_time, unit.m_callbacks_time);
+    BOOST_CHECK_EQUAL(r.m_unit.m_declarations, unit.m_declarations);
+    BOOST_CHECK_EQUAL(r.m_unit.m_references, unit.m_references);
+    BOOST_CHECK_EQUAL(r.m_unit.m_documents, unit.m_documents);
+    BOOST_CHECK_EQUAL(r.m_stats.m_files, stats.m_files);
+    BOOST_CHECK_EQUAL(r.m_stats.m_declarations, stats.m_declarations);
+    BOOST_CHECK_EQUAL(r.m_stats.m_references, stats.m_references);
+    BOOST_CHECK_EQUAL(r.m_stats.m_documents, stats.m_documents);
+    BOOST_CHECK_EQUAL(r.m_stats.m_elapsed, stats.m_elapsed);
+}
+
+BOOST_AUTO_TEST_CASE(indexing_report_message_test)
+{
+    {
+        const auto msg = kate::clang::diagnostic_message{
+            kate::clang::location{KUrl{"/src/main.cpp"}, 12, 34}
+          , QString{"something wrong"}
+          , kate::clang::diagnostic_message::type::warning
+          };
+        const auto r = report::parse(report::message(msg));
+        BOOST_REQUIRE(r.m_type == report::record::type::message);
+        BOOST_CHECK(r.m_message.m_type == msg.m_type);
+        BOOST_CHECK(r.m_message.m_text == msg.m_text);
+        BOOST_CHECK_EQUAL(r.m_message.m_location.line(), 12);
+        BOOST_CHECK_EQUAL(r.m_message.m_location.column(), 34);
+        BOOST_CHECK(r.m_message.m_location.file().toLocalFile() == "/src/main.cpp");
+    }
+    {
+        const auto msg = kate::clang::diagnostic_message{
+            QString{"no location"}
+          , kate::clang::diagnostic_message::type::error
+          };
+        const auto r = report::parse(report::message(msg));
+        BOOST_REQUIRE(r.m_type == report::record::type::message);
+        BOOST_CHECK(r.m_message.m_type == msg.m_type);
+        BOOST_CHECK(r.m_message.m_text == msg.m_text);
+        BOOST_CHECK(r.m_message.m_location.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(indexing_report_finished_test)
+{
+    auto r = report::parse(report::finished(true));
+    BOOST_REQUIRE(r.m_type == report::record::type::finished);
+    BOOST_CHECK(r.m_cancelled);
+    r = report::parse(report::finished(false));
+    BOOST_REQUIRE(r.m_type == report::record::type::finished);
+    BOOST_CHECK(!r.m_cancelled);
+}
+
+BOOST_AUTO_TEST_CASE(indexing_report_invalid_test)
+{
+    BOOST_CHECK(report::parse("").m_type == report::record::type::invalid);
+    BOOST_CHECK(report::parse("garbage\n").m_type == report::record::type::invalid);
+    BOOST_CHECK(report::parse("progress\t1\t2\n").m_type == report::record::type::invalid);
+    BOOST_CHECK(report::parse("progress\t1\tx\t3\n").m_type == report::record::type::invalid);
+    BOOST_CHECK(report::parse("finished\tmaybe\n").m_type == report::record::type::invalid);
+}
@@ -0,0 +1,74 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c location_set
+ *
+ * \date Fri Oct 16 18:52:03 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/details/location_set.h"
+
+// Standard includes
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <iostream>
+#include <set>
+#include <tuple>
+
+using kate::index::details::location_set;
+
+BOOST_AUTO_TEST_CASE(location_set_basic_test)
+{
+    location_set s;
+    BOOST_CHECK_EQUAL(s.size(), 0u);
+    BOOST_CHECK_EQUAL(s.contains(0, 1, 1), false);
+
+    BOOST_CHECK_EQUAL(s.insert(0, 1, 1), true);
+    BOOST_CHECK_EQUAL(s.insert(0, 1, 1), false);
+    BOOST_CHECK_EQUAL(s.insert(0, 1, 2), true);
+    BOOST_CHECK_EQUAL(s.insert(1, 1, 1), true);
+    BOOST_CHECK_EQUAL(s.size(), 3u);
+    BOOST_CHECK_EQUAL(s.contains(0, 1, 2), true);
+    BOOST_CHECK_EQUAL(s.contains(0, 2, 1), false);
+
+    s.clear();
+    BOOST_CHECK_EQUAL(s.size(), 0u);
+    BOOST_CHECK_EQUAL(s.contains(0, 1, 1), false);
+    BOOST_CHECK_EQUAL(s.insert(0, 1, 1), true);
+}
+
+BOOST_AUTO_TEST_CASE(location_set_grow_test)
+{
+    location_set s{4};
+    std::set<std::tuple<unsigned, unsigned, unsigned>> expected;
+    for (auto file = 0u; file < 10; ++file)
+        for (auto line = 1u; line < 500; line += 3)
+            for (auto column = 1u; column < 40; column += 7)
+            {
+                BOOST_CHECK_EQUAL(s.insert(file, line, column), true);
+                expected.emplace(file, line, column);
+            }
+    BOOST_CHECK_EQUAL(s.size(), expected.size());
+    for (const auto& loc : expected)
+    {
+        BOOST_CHECK_EQUAL(s.contains(std::get<0>(loc), std::get<1>(loc), std::get<2>(loc)), true);
+        BOOST_CHECK_EQUAL(s.insert(std::get<0>(loc), std::get<1>(loc), std::get<2>(loc)), false);
+    }
+    BOOST_CHECK_EQUAL(s.contains(10, 1, 1), false);
+}
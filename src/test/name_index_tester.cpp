@@ -0,0 +1,143 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c kate::index::name_index
+ *
+ * \date Sat Oct 17 02:06:31 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/name_index.h"
+
+// Standard includes
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+kate::index::name_index make_index()
+{
+    auto result = kate::index::name_index{};
+    result.build({
+        "gotoDeclarationUnderCursor"
+      , "gotoDefinitionUnderCursor"
+      , "getDocument"
+      , "GetDocument"
+      , "go"
+      , "findReferencesUnderCursor"
+      , "size"
+      , "resize"
+      , "go"                                                // Duplicates must be ignored
+      , ""
+      });
+    return result;
+}
+
+bool contains(const std::vector<std::string>& names, const std::string& name)
+{
+    return std::find(begin(names), end(names), name) != end(names);
+}
+}                                                           // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(name_index_prefix_test)
+{
+    const auto idx = make_index();
+    BOOST_CHECK_EQUAL(idx.size(), 8u);
+
+    auto result = idx.find_prefix("goto", 10);
+    BOOST_CHECK_EQUAL(result.size(), 2u);
+    BOOST_CHECK(contains(result, "gotoDeclarationUnderCursor"));
+    BOOST_CHECK(contains(result, "gotoDefinitionUnderCursor"));
+
+    // Case insensitive, and a name equal to a prefix goes first
+    result = idx.find_prefix("GO", 10);
+    BOOST_REQUIRE_EQUAL(result.size(), 3u);
+    BOOST_CHECK_EQUAL(result.front(), "go");
+
+    result = idx.find_prefix("getdoc", 10);
+    BOOST_CHECK_EQUAL(result.size(), 2u);
+    BOOST_CHECK(contains(result, "GetDocument"));
+    BOOST_CHECK(contains(result, "getDocument"));
+
+    BOOST_CHECK_EQUAL(idx.find_prefix("gotoDecl", 10).size(), 1u);
+    BOOST_CHECK(idx.find_prefix("gotoX", 10).empty());
+    BOOST_CHECK(idx.find_prefix("sizes", 10).empty());
+    // Results count is limited
+    BOOST_CHECK_EQUAL(idx.find_prefix("g", 2).size(), 2u);
+    BOOST_CHECK_EQUAL(idx.find_prefix("", 100).size(), 8u);
+}
+
+BOOST_AUTO_TEST_CASE(name_index_subsequence_test)
+{
+    const auto idx = make_index();
+    // NOTE getDocument has 'g', 'd' and 'c' as well
+    auto result = idx.find_subsequence("gdc", 10);
+    BOOST_CHECK_EQUAL(result.size(), 4u);
+    BOOST_CHECK(contains(result, "gotoDeclarationUnderCursor"));
+    BOOST_CHECK(contains(result, "gotoDefinitionUnderCursor"));
+
+    result = idx.find_subsequence("gduc", 10);
+    BOOST_CHECK_EQUAL(result.size(), 2u);
+    BOOST_CHECK(!contains(result, "getDocument"));
+
+    result = idx.find_subsequence("fruc", 10);
+    BOOST_REQUIRE_EQUAL(result.size(), 1u);
+    BOOST_CHECK_EQUAL(result.front(), "findReferencesUnderCursor");
+
+    result = idx.find_subsequence("sz", 10);
+    BOOST_CHECK_EQUAL(result.size(), 2u);
+    BOOST_CHECK(contains(result, "size"));
+    BOOST_CHECK(contains(result, "resize"));
+
+    BOOST_CHECK(idx.find_subsequence("zz", 10).empty());
+    BOOST_CHECK(idx.find_subsequence("cursorx", 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(name_index_similar_test)
+{
+    const auto idx = make_index();
+    auto result = idx.find_similar("gotoDeclaratoinUnderCursor", 2, 10);
+    BOOST_REQUIRE_EQUAL(result.size(), 1u);
+    BOOST_CHECK_EQUAL(result.front(), "gotoDeclarationUnderCursor");
+
+    result = idx.find_similar("sise", 1, 10);
+    BOOST_REQUIRE_EQUAL(result.size(), 1u);
+    BOOST_CHECK_EQUAL(result.front(), "size");
+
+    result = idx.find_similar("size", 2, 10);
+    BOOST_CHECK_EQUAL(result.size(), 2u);
+    BOOST_CHECK(contains(result, "size"));
+    BOOST_CHECK(contains(result, "resize"));
+
+    BOOST_CHECK(idx.find_similar("gotoDeclaratoinUnderCursor", 1, 10).empty());
+}
+
+BOOST_AUTO_TEST_CASE(name_index_empty_test)
+{
+    kate::index::name_index idx;
+    BOOST_CHECK(idx.empty());
+    BOOST_CHECK(idx.find_prefix("a", 10).empty());
+    BOOST_CHECK(idx.find_subsequence("a", 10).empty());
+    BOOST_CHECK(idx.find_similar("a", 1, 10).empty());
+    idx.build({""});
+    BOOST_CHECK(idx.empty());
+    BOOST_CHECK(idx.find_subsequence("a", 10).empty());
+}
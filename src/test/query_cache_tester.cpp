@@ -0,0 +1,87 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c kate::index::query_cache
+ *
+ * \date Sat Oct 17 01:27:44 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/query_cache.h"
+
+// Standard includes
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <iostream>
+
+namespace {
+kate::index::cached_matches make_matches(const Xapian::docid id, const kate::index::dbid db)
+{
+    auto result = kate::index::cached_matches{};
+    result.m_ids = {id};
+    result.m_estimated = 1;
+    result.m_indices = {db};
+    return result;
+}
+}                                                           // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(query_cache_lru_test)
+{
+    kate::index::query_cache cache{2};
+    BOOST_CHECK(!cache.find("a"));
+    cache.insert("a", make_matches(1, 1));
+    cache.insert("b", make_matches(2, 1));
+    // Touch "a", so "b" is the least recently used one
+    BOOST_REQUIRE(cache.find("a"));
+    BOOST_CHECK_EQUAL(cache.find("a")->m_ids.front(), 1u);
+    cache.insert("c", make_matches(3, 1));
+    BOOST_CHECK(!cache.find("b"));
+    BOOST_CHECK(cache.find("a"));
+    BOOST_CHECK(cache.find("c"));
+
+    const auto stats = cache.stats();
+    BOOST_CHECK_EQUAL(stats.m_hits, 4u);
+    BOOST_CHECK_EQUAL(stats.m_misses, 2u);
+    BOOST_CHECK_EQUAL(stats.m_size, 2u);
+
+    // Replace an existed entry
+    cache.insert("c", make_matches(4, 1));
+    BOOST_REQUIRE(cache.find("c"));
+    BOOST_CHECK_EQUAL(cache.find("c")->m_ids.front(), 4u);
+    BOOST_CHECK_EQUAL(cache.stats().m_size, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(query_cache_invalidate_test)
+{
+    kate::index::query_cache cache;
+    cache.insert("a", make_matches(1, 1));
+    cache.insert("b", make_matches(2, 2));
+    auto both = make_matches(3, 1);
+    both.m_indices.push_back(2);
+    cache.insert("ab", std::move(both));
+
+    cache.invalidate(2);
+    BOOST_CHECK(cache.find("a"));
+    BOOST_CHECK(!cache.find("b"));
+    BOOST_CHECK(!cache.find("ab"));
+    BOOST_CHECK_EQUAL(cache.stats().m_size, 1u);
+
+    cache.clear();
+    BOOST_CHECK(!cache.find("a"));
+    BOOST_CHECK_EQUAL(cache.stats().m_size, 0u);
+}
@@ -0,0 +1,90 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c targets_scanner
+ *
+ * \date Fri Oct 16 21:03:44 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/details/targets_scanner.h"
+
+// Standard includes
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <QtCore/QDir>
+#include <algorithm>
+#include <iostream>
+
+using kate::index::details::targets_scanner;
+
+namespace {
+void touch(const boost::filesystem::path& file)
+{
+    boost::filesystem::create_directories(file.parent_path());
+    boost::filesystem::ofstream ofs{file};
+    ofs << "int foo();" << std::endl;
+}
+QString to_qstring(const boost::filesystem::path& p)
+{
+    return QDir{QString::fromUtf8(p.string().c_str())}.canonicalPath();
+}
+}                                                           // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(targets_scanner_suffix_test)
+{
+    BOOST_CHECK_EQUAL(targets_scanner::is_source_suffix("cpp"), true);
+    BOOST_CHECK_EQUAL(targets_scanner::is_source_suffix("hpp"), true);
+    BOOST_CHECK_EQUAL(targets_scanner::is_source_suffix("C"), true);
+    BOOST_CHECK_EQUAL(targets_scanner::is_source_suffix("h"), true);
+    BOOST_CHECK_EQUAL(targets_scanner::is_source_suffix("o"), false);
+    BOOST_CHECK_EQUAL(targets_scanner::is_source_suffix("txt"), false);
+    BOOST_CHECK_EQUAL(targets_scanner::is_source_suffix(""), false);
+}
+
+BOOST_AUTO_TEST_CASE(targets_scanner_scan_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("targets-scanner-%%%%-%%%%");
+    touch(root / "src" / "a.cpp");
+    touch(root / "src" / "a.h");
+    touch(root / "src" / "nested" / "b.cc");
+    touch(root / "src" / "readme.txt");
+    touch(root / ".git" / "objects" / "c.cpp");             // VCS metadata
+    touch(root / "build" / "CMakeCache.txt");               // CMake build directory
+    touch(root / "build" / "moc_a.cpp");
+    touch(root / "third_party" / "d.cpp");                  // Excluded by user pattern
+    boost::filesystem::create_directory_symlink(root / "src", root / "src-link");
+
+    targets_scanner scanner{QStringList{} << "third_*"};
+    const auto files = scanner.scan({to_qstring(root), to_qstring(root / "src")}, 2);
+
+    const auto src = to_qstring(root / "src");
+    const auto expected = std::vector<QString>{
+        src + "/a.cpp"
+      , src + "/a.h"
+      , src + "/nested/b.cc"
+      };
+    BOOST_CHECK_EQUAL(files.size(), expected.size());
+    BOOST_CHECK(files == expected);
+    BOOST_CHECK(std::is_sorted(begin(files), end(files)));
+
+    boost::filesystem::remove_all(root);
+}
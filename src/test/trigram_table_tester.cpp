@@ -0,0 +1,175 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c kate::index::trigram_table
+ *
+ * \date Sat Oct 17 03:12:47 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/trigram_table.h"
+
+// Standard includes
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace kate::index;
+
+namespace {
+const std::vector<std::string> NAMES = {
+    "QueryCache"
+  , "query_cache"
+  , "get_cached_value"
+  , "HeaderFilesCache"
+  , "cacheline"
+  , "ache"
+  , "combined_index"
+  , "trigram_table"
+  , "xy"
+  , ""
+  , "querycache"                                            // Lowercased duplicate of the first one
+};
+
+std::vector<std::string> sorted(std::vector<std::string> names)
+{
+    std::sort(begin(names), end(names));
+    return names;
+}
+}                                                           // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(trigram_table_substring_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("trigram-table-%%%%-%%%%");
+    boost::filesystem::create_directories(root);
+    const auto path = trigram_table_path(root.string());
+
+    {
+        trigram_table_builder builder;
+        builder.add(begin(NAMES), end(NAMES));
+        BOOST_CHECK(0u < builder.write(path));
+        BOOST_CHECK(!boost::filesystem::exists(path + ".new"));
+    }
+
+    trigram_table table{path};
+    BOOST_REQUIRE(table.is_open());
+    BOOST_CHECK_EQUAL(table.names_count(), 9u);
+
+    {
+        const auto expected = std::vector<std::string>{
+            "cacheline", "get_cached_value", "headerfilescache", "query_cache", "querycache"
+          };
+        BOOST_CHECK(sorted(table.find_substring("Cache")) == expected);
+    }
+    // All trigrams are here, but not in a row
+    BOOST_CHECK(table.find_substring("achequ").empty());
+    BOOST_CHECK(sorted(table.find_substring("ache")).size() == 6u);
+    BOOST_CHECK(table.find_substring("rycac") == std::vector<std::string>{"querycache"});
+    BOOST_CHECK(table.find_substring("zzz").empty());
+    // Too short to be looked up
+    BOOST_CHECK(table.find_substring("xy").empty());
+
+    boost::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(trigram_table_regex_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("trigram-table-%%%%-%%%%");
+    boost::filesystem::create_directories(root);
+    const auto path = trigram_table_path(root.string());
+
+    {
+        trigram_table_builder builder;
+        builder.add(begin(NAMES), end(NAMES));
+        builder.write(path);
+    }
+    trigram_table table{path};
+    BOOST_REQUIRE(table.is_open());
+
+    BOOST_CHECK(sorted(table.find_regex("^query_?cache$")) == (std::vector<std::string>{"query_cache", "querycache"}));
+    BOOST_CHECK(table.find_regex("Cache$").size() == 3u);
+    BOOST_CHECK(table.find_regex("^(combined|trigram)_").size() == 2u);
+    // No literals at all: every name is checked
+    BOOST_CHECK(table.find_regex("^..$") == std::vector<std::string>{"xy"});
+    BOOST_CHECK(table.find_regex("ta[bx]le").size() == 1u);
+    // Quantifier bounds are not literals
+    BOOST_CHECK(table.find_regex("^cache{1,100}line$") == std::vector<std::string>{"cacheline"});
+    BOOST_CHECK(table.find_regex("^x{1}y{100}$").empty());
+    BOOST_CHECK(table.find_regex("(unbalanced").empty());
+
+    boost::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(trigram_table_update_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("trigram-table-%%%%-%%%%");
+    boost::filesystem::create_directories(root);
+    const auto path = trigram_table_path(root.string());
+
+    {
+        trigram_table_builder builder;
+        builder.add(begin(NAMES), end(NAMES));
+        builder.write(path);
+    }
+    {
+        const trigram_table table{path};
+        BOOST_REQUIRE(table.is_open());
+        trigram_table_builder builder;
+        builder.add(table);
+        builder.add("CacheBuilder");
+        builder.add("query_cache");                         // Already there
+        builder.write(path);
+    }
+    trigram_table table{path};
+    BOOST_REQUIRE(table.is_open());
+    BOOST_CHECK_EQUAL(table.names_count(), 10u);
+    BOOST_CHECK(table.find_substring("cachebui") == std::vector<std::string>{"cachebuilder"});
+    BOOST_CHECK(table.find_substring("Cache").size() == 6u);
+
+    boost::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(trigram_table_bad_file_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("trigram-table-%%%%-%%%%");
+    boost::filesystem::create_directories(root);
+    const auto path = trigram_table_path(root.string());
+
+    // Absent file is just an empty table
+    trigram_table table{path};
+    BOOST_CHECK(!table.is_open());
+    BOOST_CHECK(table.find_substring("cache").empty());
+
+    {
+        boost::filesystem::ofstream ofs{path};
+        ofs << "not a trigrams table at all";
+    }
+    BOOST_CHECK(!table.open(path));
+    BOOST_CHECK(table.find_regex("cache").empty());
+
+    boost::filesystem::remove_all(root);
+}
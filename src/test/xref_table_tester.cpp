@@ -0,0 +1,124 @@
+/**
+ * \file
+ *
+ * \brief Class tester for \c kate::index::xref_table
+ *
+ * \date Fri Oct 16 23:42:10 MSK 2026 -- Initial design
+ */
+/*
+ * KateCppHelperPlugin is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KateCppHelperPlugin is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project specific includes
+#include "../index/document_extras.h"
+#include "../index/xref_table.h"
+
+// Standard includes
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/auto_unit_test.hpp>
+// Include the following file if u need to validate some text results
+// #include <boost/test/output_test_stream.hpp>
+#include <iostream>
+#include <string>
+
+using namespace kate::index;
+
+namespace {
+const auto FOO = usr_hash("c:@F@foo#");
+const auto BAR = usr_hash("c:@S@bar");
+const auto BAZ = usr_hash("c:@S@baz");
+}                                                           // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(xref_table_roundtrip_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("xref-table-%%%%-%%%%");
+    boost::filesystem::create_directories(root);
+    const auto path = xref_table_path(root.string());
+
+    {
+        xref_table_builder builder;
+        builder.add(FOO, xref{2, 100, 5, 70000});
+        builder.add(FOO, xref{1, 10, 3, 70001});
+        builder.add(FOO, xref{1, 12, 1, 65000});
+        builder.add(FOO, xref{1, 12, 40, 0});
+        builder.add(BAR, xref{1, 1, 1, 0});
+        builder.add(FOO, xref{1, 10, 3, 70001});            // Duplicate (e.g. from another TU)
+        BOOST_CHECK(0u < builder.write(path));
+        BOOST_CHECK(!boost::filesystem::exists(path + ".new"));
+    }
+
+    xref_table table{path};
+    BOOST_REQUIRE(table.is_open());
+    BOOST_CHECK_EQUAL(table.symbols_count(), 2u);
+    BOOST_CHECK(table.find(BAZ).empty());
+
+    const auto refs = table.find(FOO);
+    BOOST_REQUIRE_EQUAL(refs.size(), 4u);
+    // Sorted by location
+    BOOST_CHECK_EQUAL(refs[0].m_file, 1u);
+    BOOST_CHECK_EQUAL(refs[0].m_line, 10u);
+    BOOST_CHECK_EQUAL(refs[0].m_column, 3u);
+    BOOST_CHECK_EQUAL(refs[0].m_container, 70001u);
+    BOOST_CHECK_EQUAL(refs[1].m_line, 12u);
+    BOOST_CHECK_EQUAL(refs[1].m_column, 1u);
+    BOOST_CHECK_EQUAL(refs[1].m_container, 65000u);
+    BOOST_CHECK_EQUAL(refs[2].m_column, 40u);
+    BOOST_CHECK_EQUAL(refs[2].m_container, 0u);
+    BOOST_CHECK_EQUAL(refs[3].m_file, 2u);
+    BOOST_CHECK_EQUAL(refs[3].m_line, 100u);
+    BOOST_CHECK_EQUAL(refs[3].m_container, 70000u);
+
+    // Update: forget references from file #1
+    {
+        xref_table_builder builder;
+        builder.load(table);
+        BOOST_CHECK_EQUAL(builder.size(), 5u);
+        builder.remove_file(1);
+        builder.add(BAZ, xref{3, 7, 7, 0});
+        builder.write(path);
+    }
+    // NOTE Already mapped table remains valid
+    BOOST_CHECK_EQUAL(table.find(FOO).size(), 4u);
+
+    BOOST_CHECK(table.open(path));
+    BOOST_CHECK_EQUAL(table.find(FOO).size(), 1u);
+    BOOST_CHECK(table.find(BAR).empty());
+    BOOST_CHECK_EQUAL(table.find(BAZ).size(), 1u);
+
+    boost::filesystem::remove_all(root);
+}
+
+BOOST_AUTO_TEST_CASE(xref_table_bad_file_test)
+{
+    const auto root = boost::filesystem::temp_directory_path()
+      / boost::filesystem::unique_path("xref-table-%%%%-%%%%");
+    boost::filesystem::create_directories(root);
+    const auto path = xref_table_path(root.string());
+
+    // Absent file is just an empty table
+    xref_table table{path};
+    BOOST_CHECK(!table.is_open());
+    BOOST_CHECK(table.find(FOO).empty());
+
+    {
+        boost::filesystem::ofstream ofs{path};
+        ofs << "not a references table at all";
+    }
+    BOOST_CHECK(!table.open(path));
+    BOOST_CHECK(table.find(FOO).empty());
+
+    boost::filesystem::remove_all(root);
+}
@@ -551,6 +551,24 @@ void TranslationUnit::reparse(const clang::unsaved_files_list& unsaved_files)
         throw Exception::ReparseFailure("It seems preparsed file is invalid");
 }
 
+/**
+ * If a cursor at a given position is a declaration, its own USR returned,
+ * otherwise USR of a referenced declaration (if any).
+ *
+ * \return empty string if there is no entity at a given position
+ */
+QString TranslationUnit::getReferencedUSR(const int line, const int column) const
+{
+    auto* const file = clang_getFile(m_unit, m_filename.constData());
+    if (!file)
+        return QString{};
+    const auto loc = clang_getLocation(m_unit, file, unsigned(line), unsigned(column));
+    const auto cursor = clang_getCursorReferenced(clang_getCursor(m_unit, loc));
+    if (clang_Cursor_isNull(cursor))
+        return QString{};
+    return clang::toString(clang::DCXString{clang_getCursorUSR(cursor)});
+}
+
 /**
  * \attention \c clang_formatDiagnostic have a nasty BUG since clang 3.3!
  * It fails (<em>pure virtual function call</em>) on messages w/o location attached
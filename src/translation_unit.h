@@ -99,6 +99,8 @@ public:
       );
     void storeTo(const KUrl&);
     void reparse(const clang::unsaved_files_list&);
+    /// Get USR of an entity referenced at a given position (1-based) of the main file
+    QString getReferencedUSR(int, int) const;
 
     /// Obtain diagnostic messages after last operation
     /// \note Leave internal container empty